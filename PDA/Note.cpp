@@ -10,9 +10,9 @@ Note::Note(const std::string &title, const std::string &content)
 // Prints note details to standard output
 void Note::display() const
 {
-    std::cout << "--- NOTE: " << noteTitle << " ---" << std::endl;
-    std::cout << noteContent << std::endl;
-    std::cout << "--------------------" << std::endl;
+    std::cout << "--- NOTE: " << noteTitle << " ---\n";
+    std::cout << noteContent << '\n';
+    std::cout << "--------------------\n";
 }
 
 // Getter for title
@@ -35,10 +35,10 @@ void PDA::editTask(const std::string &description, int priority, int index)
 // Lists all current tasks to the console.
 void PDA::listTasks() const
 {
-    std::cout << "\n--- TASKS ---" << std::endl;
+    std::cout << "\n--- TASKS ---\n";
     if (tasks.empty())
     {
-        std::cout << "No tasks to display." << std::endl;
+        std::cout << "No tasks to display.\n";
     }
     else
     {
@@ -48,15 +48,15 @@ void PDA::listTasks() const
             tasks[i].display();
         }
     }
-    std::cout << "-------------" << std::endl;
+    std::cout << "-------------\n";
 }
 
 void PDA::listTasksByIndices(const std::vector<int> &indices) const
 {
-    std::cout << "\n--- Matching Tasks ---" << std::endl;
+    std::cout << "\n--- Matching Tasks ---\n";
     if (indices.empty())
     {
-        std::cout << "No matching tasks found." << std::endl;
+        std::cout << "No matching tasks found.\n";
     }
     else
     {
@@ -73,7 +73,7 @@ void PDA::listTasksByIndices(const std::vector<int> &indices) const
             }
         }
     }
-    std::cout << "--------------------" << std::endl;
+    std::cout << "--------------------\n";
 }
 
 // Marks a task as complete based on its 1-based index.
@@ -96,8 +96,16 @@ void PDA::removeTask(size_t index)
 {
     if (index > 0 && index <= tasks.size())
     {
-        // vector::erase takes an iterator; begin() + offset gives the correct iterator
-        tasks.erase(tasks.begin() + (index - 1));
+        // vector::erase would shift the later tasks down by assignment, which Task
+        // does not support (its taskID is const). Copy the kept tasks instead.
+        std::vector<Task> kept;
+        kept.reserve(tasks.size() - 1);
+        for (size_t i = 0; i < tasks.size(); ++i)
+        {
+            if (i != index - 1)
+                kept.push_back(tasks[i]);
+        }
+        tasks.swap(kept);
         std::cout << "Task removed.\n";
     }
     else
@@ -118,20 +126,20 @@ void PDA::addNote(const std::string &title, const std::string &content)
 // Lists the titles of all current notes to the console.
 void PDA::listNotes() const
 {
-    std::cout << "\n--- NOTES ---" << std::endl;
+    std::cout << "\n--- NOTES ---\n";
     if (notes.empty())
     {
-        std::cout << "No notes to display." << std::endl;
+        std::cout << "No notes to display.\n";
     }
     else
     {
         // Display with 1-based indexing for the user
         for (size_t i = 0; i < notes.size(); ++i)
         {
-            std::cout << i + 1 << ". " << notes[i].getTitle() << std::endl;
+            std::cout << i + 1 << ". " << notes[i].getTitle() << '\n';
         }
     }
-    std::cout << "-------------" << std::endl;
+    std::cout << "-------------\n";
 }
 
 // Displays the full content of a note based on its 1-based index.
@@ -23,7 +23,7 @@ bool Storage::saveTasks(const std::vector<Task> &tasks) const
     // Write each task's serialized representation to a new line
     for (const auto &task : tasks)
     {
-        outFile << task.serialize() << std::endl;
+        outFile << task.serialize() << '\n'; // No per-line flush; closing writes it out
     }
 
     return true; // outFile closed automatically by RAII
@@ -77,7 +77,7 @@ bool Storage::saveNotes(const std::vector<Note> &notes) const
     }
     for (const auto &note : notes)
     {
-        outFile << note.serialize() << std::endl;
+        outFile << note.serialize() << '\n';
     }
     return true;
 }
@@ -46,7 +46,7 @@ void Task::display() const
     std::cout << "ID: " << taskID << " " // Added ID display
               << "[" << (completed ? "X" : " ") << "] "
               << "P" << taskPriority << ": "
-              << description << std::endl; // std::endl flushes the output buffer too
+              << description << '\n'; // No std::endl: the console flushes once per command
 }
 
 // Getter for description
@@ -3,6 +3,7 @@
 #include <limits>   // For clearing input buffer (numeric_limits)
 #include <vector>   // Although not directly used here, often needed in main
 #include "PDA.h"    // Include our main PDA logic class
+#include "ConsoleFrame.h" // Per-command console output buffering
 
 // Forward declarations for helper functions
 void displayMenu();
@@ -19,6 +20,12 @@ std::string getStringInput(const std::string &prompt);
 // Main application entry point
 int main()
 {
+    // ** EDUCATIONAL NOTE: Buffered Output **
+    // Every flush of std::cout is a write() system call. ConsoleFrame collects
+    // everything printed for one menu command and writes it at once, when the
+    // next prompt is flushed (see getIntInput / getStringInput).
+    ConsoleFrame console;
+
     // ** EDUCATIONAL NOTE: Object Creation **
     // We create an instance of our PDA class on the stack.
     // Its constructor (PDA::PDA) is called automatically, which loads the data.
@@ -146,8 +153,8 @@ int getIntInput(const std::string &prompt)
     int value;
     while (true)
     {
-        std::cout << prompt;
-        std::cin >> value; // Attempt to read integer
+        std::cout << prompt << std::flush; // Show the frame before waiting for input
+        std::cin >> value;                 // Attempt to read integer
 
         if (std::cin.fail()) // Check for input failure
         {
@@ -168,7 +175,7 @@ int getIntInput(const std::string &prompt)
 std::string getStringInput(const std::string &prompt)
 {
     std::string value;
-    std::cout << prompt;
-    std::getline(std::cin, value); // Read entire line, including spaces
+    std::cout << prompt << std::flush; // Show the frame before waiting for input
+    std::getline(std::cin, value);     // Read entire line, including spaces
     return value;
 }
\ No newline at end of file
@@ -0,0 +1,69 @@
+#include "byte_ring.h"
+#include <string.h> // For memcpy
+
+bool byte_ring_init(ByteRing *ring, uint8_t *storage, size_t capacity)
+{
+    if (!ring || !storage)
+        return false;
+    if (capacity == 0 || (capacity & (capacity - 1)) != 0)
+        return false; // Masking the indices only works for powers of two
+
+    atomic_init(&ring->head, 0);
+    atomic_init(&ring->tail, 0);
+    ring->storage = storage;
+    ring->capacity = capacity;
+    ring->mask = capacity - 1;
+    return true;
+}
+
+// --- Producer Side ---
+
+size_t byte_ring_write(ByteRing *ring, const uint8_t *data, size_t length)
+{
+    // Our own index needs no ordering; the consumer's index is acquired so the
+    // space it freed is really free before we overwrite it.
+    size_t head = atomic_load_explicit(&ring->head, memory_order_relaxed);
+    size_t tail = atomic_load_explicit(&ring->tail, memory_order_acquire);
+    size_t space = ring->capacity - (head - tail);
+    if (length > space)
+        length = space;
+
+    // At most two copies: up to the end of the storage, then from its start.
+    size_t offset = head & ring->mask;
+    size_t first = ring->capacity - offset;
+    if (first > length)
+        first = length;
+    memcpy(ring->storage + offset, data, first);
+    memcpy(ring->storage, data + first, length - first);
+
+    // Release: the bytes above are visible before the consumer sees the new head.
+    atomic_store_explicit(&ring->head, head + length, memory_order_release);
+    return length;
+}
+
+// --- Consumer Side ---
+
+size_t byte_ring_peek(ByteRing *ring, const uint8_t **data)
+{
+    size_t tail = atomic_load_explicit(&ring->tail, memory_order_relaxed);
+    size_t head = atomic_load_explicit(&ring->head, memory_order_acquire);
+    size_t offset = tail & ring->mask;
+    size_t available = head - tail;
+    size_t contiguous = ring->capacity - offset;
+
+    *data = ring->storage + offset;
+    return available < contiguous ? available : contiguous;
+}
+
+void byte_ring_consume(ByteRing *ring, size_t length)
+{
+    size_t tail = atomic_load_explicit(&ring->tail, memory_order_relaxed);
+    atomic_store_explicit(&ring->tail, tail + length, memory_order_release);
+}
+
+size_t byte_ring_size(ByteRing *ring)
+{
+    size_t tail = atomic_load_explicit(&ring->tail, memory_order_acquire);
+    size_t head = atomic_load_explicit(&ring->head, memory_order_acquire);
+    return head - tail;
+}
@@ -0,0 +1,72 @@
+#ifndef BYTE_RING_H_
+#define BYTE_RING_H_
+
+#include <stdatomic.h> // For the lock-free head/tail indices
+#include <stdbool.h>   // For bool type
+#include <stddef.h>    // For size_t
+#include <stdint.h>    // For uint8_t
+
+// --- Constants ---
+#define BYTE_RING_CACHE_LINE 64 // Keeps producer and consumer indices on separate cache lines
+
+// --- ByteRing Structure ---
+// A single-producer/single-consumer (SPSC) ring buffer of bytes.
+// One thread (e.g. the UART/socket receive path) writes, another (the packet
+// decoder) reads, and neither ever takes a lock: each side only stores its own
+// index and reads the other's. The indices count bytes forever and are masked
+// into the storage, so the capacity must be a power of two.
+// The storage is owned by the caller (a static array on a microcontroller).
+typedef struct
+{
+    _Alignas(BYTE_RING_CACHE_LINE) atomic_size_t head; // Total bytes written (producer only)
+    _Alignas(BYTE_RING_CACHE_LINE) atomic_size_t tail; // Total bytes read (consumer only)
+    _Alignas(BYTE_RING_CACHE_LINE) uint8_t *storage;
+    size_t capacity; // Power of two
+    size_t mask;     // capacity - 1
+} ByteRing;
+
+// --- Function Declarations ---
+
+/**
+ * @brief Initializes an empty ring over caller-owned storage.
+ * @param ring Pointer to the ring to initialize.
+ * @param storage Buffer of `capacity` bytes that the ring will use.
+ * @param capacity Size of the buffer; must be a power of two.
+ * @return True if successful, false if a pointer is NULL or capacity is not a power of two.
+ */
+bool byte_ring_init(ByteRing *ring, uint8_t *storage, size_t capacity);
+
+/**
+ * @brief Copies as many bytes as fit into the ring. Producer side only.
+ * @param ring Pointer to the ring.
+ * @param data Bytes to append.
+ * @param length Number of bytes to append.
+ * @return The number of bytes actually written (less than length if the ring is full).
+ */
+size_t byte_ring_write(ByteRing *ring, const uint8_t *data, size_t length);
+
+/**
+ * @brief Returns the oldest unread bytes as one contiguous block. Consumer side only.
+ *        The block ends at the wrap point, so call again after consuming it to get
+ *        the rest. The bytes stay valid until byte_ring_consume is called.
+ * @param ring Pointer to the ring.
+ * @param data Receives a pointer to the first unread byte.
+ * @return The number of contiguous bytes available at *data (0 if the ring is empty).
+ */
+size_t byte_ring_peek(ByteRing *ring, const uint8_t **data);
+
+/**
+ * @brief Releases bytes returned by byte_ring_peek back to the producer. Consumer side only.
+ * @param ring Pointer to the ring.
+ * @param length Number of bytes to release (at most what byte_ring_peek returned).
+ */
+void byte_ring_consume(ByteRing *ring, size_t length);
+
+/**
+ * @brief Number of bytes currently stored. Exact only when called from one of the two sides.
+ * @param ring Pointer to the ring.
+ * @return Bytes written but not yet consumed.
+ */
+size_t byte_ring_size(ByteRing *ring);
+
+#endif // BYTE_RING_H_
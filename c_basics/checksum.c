@@ -0,0 +1,276 @@
+#include "checksum.h"
+#include <stdatomic.h> // For the dispatch pointers
+#include <string.h>    // For memcpy
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define CHECKSUM_HAVE_X86 1
+#include <immintrin.h> // SSE2/AVX2 intrinsics
+#endif
+
+// --- Portable Kernels ---
+// Read 8 bytes at a time through memcpy (no alignment or aliasing assumptions;
+// compilers turn it into a single load).
+
+static uint8_t xor8_scalar(const uint8_t *data, size_t length)
+{
+    uint64_t acc = 0;
+    size_t i = 0;
+    for (; i + 8 <= length; i += 8)
+    {
+        uint64_t word;
+        memcpy(&word, data + i, sizeof(word));
+        acc ^= word;
+    }
+    // Fold the 8 byte lanes into one
+    acc ^= acc >> 32;
+    acc ^= acc >> 16;
+    acc ^= acc >> 8;
+    uint8_t checksum = (uint8_t)acc;
+    for (; i < length; ++i)
+        checksum ^= data[i];
+    return checksum;
+}
+
+static uint8_t sum8_scalar(const uint8_t *data, size_t length)
+{
+    // SWAR: add the even and odd bytes of each word into 16-bit lanes. A lane gains
+    // at most 2 * 255 per word, so flush the lanes every 128 words, before they overflow.
+    const uint64_t low_bytes = 0x00FF00FF00FF00FFull;
+    uint32_t total = 0;
+    size_t i = 0;
+    while (i + 8 <= length)
+    {
+        uint64_t lanes = 0;
+        for (size_t words = 0; words < 128 && i + 8 <= length; ++words, i += 8)
+        {
+            uint64_t word;
+            memcpy(&word, data + i, sizeof(word));
+            lanes += (word & low_bytes) + ((word >> 8) & low_bytes);
+        }
+        total += (uint32_t)((lanes + (lanes >> 16) + (lanes >> 32) + (lanes >> 48)) & 0xFFFF);
+    }
+    for (; i < length; ++i)
+        total += data[i];
+    return (uint8_t)total;
+}
+
+#ifdef CHECKSUM_HAVE_X86
+// --- SSE2 Kernels ---
+// Below one loop iteration the vector setup and final fold cost more than they
+// save (command packets are at most 20 bytes), so short buffers go to the scalar
+// kernel.
+
+// XOR of the 16 byte lanes of a register, without a round trip through memory.
+__attribute__((target("sse2"))) static inline uint8_t fold_xor_sse2(__m128i lanes)
+{
+    lanes = _mm_xor_si128(lanes, _mm_srli_si128(lanes, 8));
+    lanes = _mm_xor_si128(lanes, _mm_srli_si128(lanes, 4));
+    uint32_t folded = (uint32_t)_mm_cvtsi128_si32(lanes);
+    folded ^= folded >> 16;
+    return (uint8_t)(folded ^ (folded >> 8));
+}
+
+// Sum of the two 64-bit lanes of a register, modulo 256.
+__attribute__((target("sse2"))) static inline uint8_t fold_sum_sse2(__m128i lanes)
+{
+    lanes = _mm_add_epi64(lanes, _mm_srli_si128(lanes, 8));
+    return (uint8_t)_mm_cvtsi128_si32(lanes);
+}
+
+__attribute__((target("sse2"))) static uint8_t xor8_sse2(const uint8_t *data, size_t length)
+{
+    if (length < 32)
+        return xor8_scalar(data, length);
+    __m128i acc0 = _mm_setzero_si128();
+    __m128i acc1 = _mm_setzero_si128();
+    size_t i = 0;
+    for (; i + 32 <= length; i += 32) // Two independent accumulators hide the load latency
+    {
+        acc0 = _mm_xor_si128(acc0, _mm_loadu_si128((const __m128i *)(data + i)));
+        acc1 = _mm_xor_si128(acc1, _mm_loadu_si128((const __m128i *)(data + i + 16)));
+    }
+    for (; i + 16 <= length; i += 16)
+        acc0 = _mm_xor_si128(acc0, _mm_loadu_si128((const __m128i *)(data + i)));
+    return (uint8_t)(fold_xor_sse2(_mm_xor_si128(acc0, acc1)) ^ xor8_scalar(data + i, length - i));
+}
+
+__attribute__((target("sse2"))) static uint8_t sum8_sse2(const uint8_t *data, size_t length)
+{
+    if (length < 32)
+        return sum8_scalar(data, length);
+    // PSADBW against zero adds 8 bytes into a 64-bit lane in one instruction;
+    // 64-bit lanes never overflow, so no flushing is needed.
+    const __m128i zero = _mm_setzero_si128();
+    __m128i acc0 = _mm_setzero_si128();
+    __m128i acc1 = _mm_setzero_si128();
+    size_t i = 0;
+    for (; i + 32 <= length; i += 32)
+    {
+        acc0 = _mm_add_epi64(acc0, _mm_sad_epu8(_mm_loadu_si128((const __m128i *)(data + i)), zero));
+        acc1 = _mm_add_epi64(acc1, _mm_sad_epu8(_mm_loadu_si128((const __m128i *)(data + i + 16)), zero));
+    }
+    for (; i + 16 <= length; i += 16)
+        acc0 = _mm_add_epi64(acc0, _mm_sad_epu8(_mm_loadu_si128((const __m128i *)(data + i)), zero));
+
+    return (uint8_t)(fold_sum_sse2(_mm_add_epi64(acc0, acc1)) + sum8_scalar(data + i, length - i));
+}
+
+// --- AVX2 Kernels ---
+
+__attribute__((target("avx2"))) static uint8_t xor8_avx2(const uint8_t *data, size_t length)
+{
+    if (length < 64)
+        return xor8_sse2(data, length);
+    __m256i acc0 = _mm256_setzero_si256();
+    __m256i acc1 = _mm256_setzero_si256();
+    size_t i = 0;
+    for (; i + 64 <= length; i += 64)
+    {
+        acc0 = _mm256_xor_si256(acc0, _mm256_loadu_si256((const __m256i *)(data + i)));
+        acc1 = _mm256_xor_si256(acc1, _mm256_loadu_si256((const __m256i *)(data + i + 32)));
+    }
+    for (; i + 32 <= length; i += 32)
+        acc0 = _mm256_xor_si256(acc0, _mm256_loadu_si256((const __m256i *)(data + i)));
+
+    acc0 = _mm256_xor_si256(acc0, acc1);
+    __m128i halves = _mm_xor_si128(_mm256_castsi256_si128(acc0), _mm256_extracti128_si256(acc0, 1));
+    return (uint8_t)(fold_xor_sse2(halves) ^ xor8_scalar(data + i, length - i));
+}
+
+__attribute__((target("avx2"))) static uint8_t sum8_avx2(const uint8_t *data, size_t length)
+{
+    if (length < 64)
+        return sum8_sse2(data, length);
+    const __m256i zero = _mm256_setzero_si256();
+    __m256i acc0 = _mm256_setzero_si256();
+    __m256i acc1 = _mm256_setzero_si256();
+    size_t i = 0;
+    for (; i + 64 <= length; i += 64)
+    {
+        acc0 = _mm256_add_epi64(acc0, _mm256_sad_epu8(_mm256_loadu_si256((const __m256i *)(data + i)), zero));
+        acc1 = _mm256_add_epi64(acc1, _mm256_sad_epu8(_mm256_loadu_si256((const __m256i *)(data + i + 32)), zero));
+    }
+    for (; i + 32 <= length; i += 32)
+        acc0 = _mm256_add_epi64(acc0, _mm256_sad_epu8(_mm256_loadu_si256((const __m256i *)(data + i)), zero));
+
+    acc0 = _mm256_add_epi64(acc0, acc1);
+    __m128i halves = _mm_add_epi64(_mm256_castsi256_si128(acc0), _mm256_extracti128_si256(acc0, 1));
+    return (uint8_t)(fold_sum_sse2(halves) + sum8_scalar(data + i, length - i));
+}
+#endif // CHECKSUM_HAVE_X86
+
+// --- Runtime Dispatch ---
+// The kernels are called through pointers that start out at a resolver. The first
+// call picks the implementation for this CPU and replaces the pointers, so later
+// calls cost one indirect call. Atomic so that threads racing on the first call are
+// well defined (they all store the same pointers).
+
+typedef uint8_t (*ChecksumKernel)(const uint8_t *data, size_t length);
+
+static uint8_t xor8_first_call(const uint8_t *data, size_t length);
+static uint8_t sum8_first_call(const uint8_t *data, size_t length);
+
+static _Atomic(ChecksumKernel) xor8_kernel = xor8_first_call;
+static _Atomic(ChecksumKernel) sum8_kernel = sum8_first_call;
+static _Atomic(int) active_impl = CHECKSUM_IMPL_AUTO;
+
+static bool impl_supported(ChecksumImpl impl)
+{
+    switch (impl)
+    {
+    case CHECKSUM_IMPL_SCALAR:
+        return true;
+#ifdef CHECKSUM_HAVE_X86
+    case CHECKSUM_IMPL_SSE2:
+        return __builtin_cpu_supports("sse2");
+    case CHECKSUM_IMPL_AVX2:
+        return __builtin_cpu_supports("avx2");
+#endif
+    default:
+        return false;
+    }
+}
+
+bool checksum_select(ChecksumImpl impl)
+{
+    if (impl == CHECKSUM_IMPL_AUTO)
+    {
+        impl = CHECKSUM_IMPL_SCALAR;
+        if (impl_supported(CHECKSUM_IMPL_SSE2))
+            impl = CHECKSUM_IMPL_SSE2;
+        if (impl_supported(CHECKSUM_IMPL_AVX2))
+            impl = CHECKSUM_IMPL_AVX2;
+    }
+    if (!impl_supported(impl))
+        return false;
+
+    ChecksumKernel xor8 = xor8_scalar;
+    ChecksumKernel sum8 = sum8_scalar;
+#ifdef CHECKSUM_HAVE_X86
+    if (impl == CHECKSUM_IMPL_SSE2)
+    {
+        xor8 = xor8_sse2;
+        sum8 = sum8_sse2;
+    }
+    else if (impl == CHECKSUM_IMPL_AVX2)
+    {
+        xor8 = xor8_avx2;
+        sum8 = sum8_avx2;
+    }
+#endif
+    atomic_store_explicit(&xor8_kernel, xor8, memory_order_relaxed);
+    atomic_store_explicit(&sum8_kernel, sum8, memory_order_relaxed);
+    atomic_store_explicit(&active_impl, (int)impl, memory_order_relaxed);
+    return true;
+}
+
+ChecksumImpl checksum_active(void)
+{
+    if (atomic_load_explicit(&active_impl, memory_order_relaxed) == CHECKSUM_IMPL_AUTO)
+        checksum_select(CHECKSUM_IMPL_AUTO);
+    return (ChecksumImpl)atomic_load_explicit(&active_impl, memory_order_relaxed);
+}
+
+const char *checksum_impl_name(ChecksumImpl impl)
+{
+    switch (impl)
+    {
+    case CHECKSUM_IMPL_AUTO:
+        return "auto";
+    case CHECKSUM_IMPL_SCALAR:
+        return "scalar";
+    case CHECKSUM_IMPL_SSE2:
+        return "sse2";
+    case CHECKSUM_IMPL_AVX2:
+        return "avx2";
+    }
+    return "unknown";
+}
+
+static uint8_t xor8_first_call(const uint8_t *data, size_t length)
+{
+    checksum_select(CHECKSUM_IMPL_AUTO);
+    return checksum_xor8(data, length);
+}
+
+static uint8_t sum8_first_call(const uint8_t *data, size_t length)
+{
+    checksum_select(CHECKSUM_IMPL_AUTO);
+    return checksum_sum8(data, length);
+}
+
+// --- Public Kernels ---
+
+uint8_t checksum_xor8(const uint8_t *data, size_t length)
+{
+    if (!data)
+        return 0;
+    return atomic_load_explicit(&xor8_kernel, memory_order_relaxed)(data, length);
+}
+
+uint8_t checksum_sum8(const uint8_t *data, size_t length)
+{
+    if (!data)
+        return 0;
+    return atomic_load_explicit(&sum8_kernel, memory_order_relaxed)(data, length);
+}
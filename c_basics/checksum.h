@@ -0,0 +1,66 @@
+#ifndef CHECKSUM_H_
+#define CHECKSUM_H_
+
+#include <stdbool.h> // For bool type
+#include <stddef.h>  // For size_t
+#include <stdint.h>  // For uint8_t
+
+#ifdef __cplusplus
+extern "C" // Also used by the C++ packet validator
+{
+#endif
+
+// --- Checksum Kernels ---
+// The 8-bit checksums used on the command link, for buffers of any size: the XOR
+// of all bytes (command_protocol) and the sum of all bytes modulo 256 (the
+// packet validator). Each has a portable implementation plus SSE2 and AVX2 ones
+// on x86; the fastest one the CPU supports is picked at runtime on first use, so
+// one binary runs everywhere.
+
+typedef enum
+{
+    CHECKSUM_IMPL_AUTO = 0, // Best supported by this CPU
+    CHECKSUM_IMPL_SCALAR,   // Portable C, 8 bytes at a time
+    CHECKSUM_IMPL_SSE2,     // 16 bytes per instruction (every x86-64 CPU)
+    CHECKSUM_IMPL_AVX2,     // 32 bytes per instruction
+} ChecksumImpl;
+
+/**
+ * @brief XOR of all bytes in a buffer.
+ * @param data Pointer to the data buffer.
+ * @param length The number of bytes to checksum.
+ * @return The 8-bit XOR checksum (0 for an empty buffer).
+ */
+uint8_t checksum_xor8(const uint8_t *data, size_t length);
+
+/**
+ * @brief Sum of all bytes in a buffer, ignoring overflow (i.e. modulo 256).
+ * @param data Pointer to the data buffer.
+ * @param length The number of bytes to checksum.
+ * @return The 8-bit additive checksum (0 for an empty buffer).
+ */
+uint8_t checksum_sum8(const uint8_t *data, size_t length);
+
+/**
+ * @brief Forces a specific implementation, e.g. to benchmark or test them against each other.
+ * @param impl The implementation to use from now on; CHECKSUM_IMPL_AUTO restores the default choice.
+ * @return True if successful, false if this CPU (or build) does not support it.
+ */
+bool checksum_select(ChecksumImpl impl);
+
+/**
+ * @brief Reports which implementation the kernels currently use.
+ * @return The active implementation (never CHECKSUM_IMPL_AUTO).
+ */
+ChecksumImpl checksum_active(void);
+
+/**
+ * @brief Human-readable name of an implementation ("scalar", "sse2", ...).
+ */
+const char *checksum_impl_name(ChecksumImpl impl);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // CHECKSUM_H_
@@ -0,0 +1,42 @@
+#include "command_dispatch.h"
+#include <stddef.h> // For NULL
+
+DispatchResult command_dispatch(const CommandSpec *table, const PacketView *packet, void *context, DispatchStats *stats)
+{
+    DispatchResult result;
+    if (!table || !packet || !packet->wire)
+    {
+        result = DISPATCH_UNKNOWN_COMMAND;
+    }
+    else
+    {
+        // One index, no search: the cost does not depend on how many types are registered
+        const CommandSpec *spec = &table[packet_view_type(packet)];
+        uint16_t length = packet_view_payload_length(packet);
+        if (!spec->handler)
+            result = DISPATCH_UNKNOWN_COMMAND;
+        else if (length < spec->min_payload || length > spec->max_payload)
+            result = DISPATCH_BAD_LENGTH;
+        else
+            result = spec->handler(packet, context) ? DISPATCH_OK : DISPATCH_HANDLER_FAILED;
+    }
+    if (stats)
+        stats->results[result]++;
+    return result;
+}
+
+const char *command_dispatch_result_name(DispatchResult result)
+{
+    switch (result)
+    {
+    case DISPATCH_OK:
+        return "ok";
+    case DISPATCH_UNKNOWN_COMMAND:
+        return "unknown command";
+    case DISPATCH_BAD_LENGTH:
+        return "bad payload length";
+    case DISPATCH_HANDLER_FAILED:
+        return "handler failed";
+    }
+    return "unknown";
+}
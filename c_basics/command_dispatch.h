@@ -0,0 +1,77 @@
+#ifndef COMMAND_DISPATCH_H_
+#define COMMAND_DISPATCH_H_
+
+#include <stdbool.h> // For bool type
+#include <stdint.h>  // For fixed-width integers
+
+#include "command_protocol.h" // For PacketView
+
+// --- Dispatch Table ---
+// Receivers used to switch on command_type and call a hand-written extractor per
+// command. Instead, each command type gets one entry in a 256-slot table indexed by
+// the type byte: its handler and the payload lengths it accepts. Dispatching is one
+// array index, the same cost for 3 command types or 256, and the length check is
+// declared once per type instead of repeated in every extractor.
+//
+// Tables are normally `static const` and filled at compile time with COMMAND_ENTRY
+// (designated initializers), so unregistered types are all-zero entries:
+//
+//   static const CommandSpec flight_commands[COMMAND_TABLE_SIZE] = {
+//       COMMAND_ENTRY(CMD_SET_RUDDER_ANGLE, 1, 1, on_set_rudder),
+//       COMMAND_ENTRY(CMD_REQUEST_SENSOR_DATA, 0, 0, on_request_sensor_data),
+//   };
+
+#define COMMAND_TABLE_SIZE 256 // One slot per possible command_type byte
+
+/**
+ * @brief Handles one validated packet.
+ * @param packet The packet; its payload length is already within the entry's limits.
+ * @param context The context pointer given to command_dispatch.
+ * @return True if the command was carried out.
+ */
+typedef bool (*CommandHandler)(const PacketView *packet, void *context);
+
+typedef struct
+{
+    CommandHandler handler; // NULL: command type not supported
+    uint16_t min_payload;   // Shortest accepted payload
+    uint16_t max_payload;   // Longest accepted payload (over MAX_PAYLOAD_SIZE: extended frames)
+    const char *name;       // For logs and statistics
+} CommandSpec;
+
+// Registers `handler` for command `type` inside a CommandSpec table initializer
+#define COMMAND_ENTRY(type, min_payload, max_payload, handler) \
+    [(type)] = {(handler), (min_payload), (max_payload), #type}
+
+typedef enum
+{
+    DISPATCH_OK = 0,          // Handler ran and succeeded
+    DISPATCH_UNKNOWN_COMMAND, // No handler registered for the type
+    DISPATCH_BAD_LENGTH,      // Payload length outside the entry's limits
+    DISPATCH_HANDLER_FAILED,  // Handler ran and returned false
+} DispatchResult;
+
+// Outcome counters, indexed by DispatchResult
+typedef struct
+{
+    uint64_t results[DISPATCH_HANDLER_FAILED + 1];
+} DispatchStats;
+
+// --- Function Declarations ---
+
+/**
+ * @brief Runs the handler registered for a packet's command type.
+ * @param table A table of COMMAND_TABLE_SIZE entries.
+ * @param packet A validated packet (e.g. from packet_view_init or the stream decoder).
+ * @param context Passed to the handler unchanged.
+ * @param stats Counts the outcome if not NULL.
+ * @return What happened to the packet.
+ */
+DispatchResult command_dispatch(const CommandSpec *table, const PacketView *packet, void *context, DispatchStats *stats);
+
+/**
+ * @brief Human-readable name of a dispatch result.
+ */
+const char *command_dispatch_result_name(DispatchResult result);
+
+#endif // COMMAND_DISPATCH_H_
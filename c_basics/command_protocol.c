@@ -1,16 +1,13 @@
 #include "command_protocol.h"
+#include "checksum.h" // For the vectorized checksum kernels
+#include "crc.h"      // For the CRC integrity modes
 #include <string.h> // For memcpy and memset
 #include <stdio.h>  // For fprintf (for error messages if needed)
 
 // --- Checksum Calculation ---
 uint8_t command_calculate_checksum(const uint8_t *data, uint8_t length)
 {
-    uint8_t checksum = 0;
-    for (uint8_t i = 0; i < length; ++i)
-    {
-        checksum ^= data[i]; // Simple XOR checksum
-    }
-    return checksum;
+    return checksum_xor8(data, length); // Simple XOR checksum, SIMD where the CPU has it
 }
 
 // --- Helper to prepare a basic packet structure ---
@@ -83,6 +80,136 @@ bool command_create_request_sensor_data(CommandPacket *packet)
     return true;
 }
 
+// --- Integrity Codes ---
+
+uint8_t command_integrity_size(IntegrityMode mode)
+{
+    switch (mode)
+    {
+    case INTEGRITY_XOR8:
+        return 1;
+    case INTEGRITY_CRC16:
+        return 2;
+    case INTEGRITY_CRC32C:
+        return 4;
+    }
+    return 0;
+}
+
+// Integrity code of `length` covered bytes (header and payload) for a mode
+static uint32_t compute_integrity(const uint8_t *covered, size_t length, IntegrityMode mode)
+{
+    switch (mode)
+    {
+    case INTEGRITY_CRC16:
+        return crc16_ccitt(covered, length);
+    case INTEGRITY_CRC32C:
+        return crc32c(covered, length);
+    default:
+        return checksum_xor8(covered, length);
+    }
+}
+
+// The integrity code is stored little-endian, in command_integrity_size(mode) bytes
+static void write_integrity(uint8_t *out, uint32_t code, uint8_t size)
+{
+    for (uint8_t i = 0; i < size; ++i)
+        out[i] = (uint8_t)(code >> (8 * i));
+}
+
+static uint32_t read_integrity(const uint8_t *in, uint8_t size)
+{
+    uint32_t code = 0;
+    for (uint8_t i = 0; i < size; ++i)
+        code |= (uint32_t)in[i] << (8 * i);
+    return code;
+}
+
+bool command_seal_packet(CommandPacket *packet, IntegrityMode mode)
+{
+    if (!packet || packet->payload_length > MAX_PAYLOAD_SIZE || command_integrity_size(mode) == 0)
+        return false;
+
+    // The code covers the header as sent, i.e. with the mode bits in payload_length
+    uint8_t covered[3 + MAX_PAYLOAD_SIZE];
+    covered[0] = packet->start_byte;
+    covered[1] = packet->command_type;
+    covered[2] = (uint8_t)(packet->payload_length | mode << PACKET_INTEGRITY_SHIFT);
+    memcpy(&covered[3], packet->payload, packet->payload_length);
+
+    uint32_t code = compute_integrity(covered, 3u + packet->payload_length, mode);
+    packet->integrity_mode = (uint8_t)mode;
+    packet->checksum = mode == INTEGRITY_XOR8 ? (uint8_t)code : 0;
+    packet->crc = mode == INTEGRITY_XOR8 ? 0 : code;
+    return true;
+}
+
+size_t command_header_size(uint8_t start_byte)
+{
+    if (start_byte == PACKET_START_BYTE)
+        return PACKET_HEADER_SIZE;
+    if (start_byte == PACKET_EXT_START_BYTE)
+        return PACKET_EXT_HEADER_SIZE;
+    return 0;
+}
+
+size_t command_frame_size(const uint8_t *header)
+{
+    if (!header)
+        return 0;
+    if (header[0] == PACKET_EXT_START_BYTE)
+    {
+        size_t payload_length = header[3] | (size_t)header[4] << 8;
+        uint8_t integrity_size = command_integrity_size((IntegrityMode)(header[2] >> PACKET_INTEGRITY_SHIFT));
+        if ((header[2] & PACKET_LENGTH_MASK) != 0 || payload_length > PACKET_EXT_MAX_PAYLOAD_SIZE || integrity_size == 0)
+            return 0;
+        return PACKET_EXT_HEADER_SIZE + payload_length + integrity_size;
+    }
+    if (header[0] != PACKET_START_BYTE)
+        return 0;
+    uint8_t payload_length = header[2] & PACKET_LENGTH_MASK;
+    uint8_t integrity_size = command_integrity_size((IntegrityMode)(header[2] >> PACKET_INTEGRITY_SHIFT));
+    if (payload_length > MAX_PAYLOAD_SIZE || integrity_size == 0)
+        return 0;
+    return 3u + payload_length + integrity_size;
+}
+
+bool command_frame_intact(const uint8_t *frame, size_t frame_size)
+{
+    if (!frame)
+        return false;
+    IntegrityMode mode = (IntegrityMode)(frame[2] >> PACKET_INTEGRITY_SHIFT);
+    uint8_t integrity_size = command_integrity_size(mode);
+    if (integrity_size == 0 || frame_size < 3u + integrity_size)
+        return false;
+    size_t covered = frame_size - integrity_size;
+    return compute_integrity(frame, covered, mode) == read_integrity(frame + covered, integrity_size);
+}
+
+// --- Serialization Function ---
+
+size_t command_serialize_packet(const CommandPacket *packet, uint8_t *buffer, size_t buffer_size)
+{
+    if (!packet || !buffer)
+        return 0;
+    uint8_t integrity_size = command_integrity_size((IntegrityMode)packet->integrity_mode);
+    if (packet->payload_length > MAX_PAYLOAD_SIZE || integrity_size == 0)
+        return 0;
+
+    size_t total_length = sizeof(packet->start_byte) + sizeof(packet->command_type) +
+                          sizeof(packet->payload_length) + packet->payload_length + integrity_size;
+    if (buffer_size < total_length)
+        return 0;
+
+    buffer[0] = packet->start_byte;
+    buffer[1] = packet->command_type;
+    buffer[2] = (uint8_t)(packet->payload_length | packet->integrity_mode << PACKET_INTEGRITY_SHIFT);
+    memcpy(&buffer[3], packet->payload, packet->payload_length);
+    uint32_t code = packet->integrity_mode == INTEGRITY_XOR8 ? packet->checksum : packet->crc;
+    write_integrity(&buffer[total_length - integrity_size], code, integrity_size);
+    return total_length;
+}
+
 // --- Deserialization/Parsing Function ---
 
 bool command_parse_packet(const uint8_t *buffer, uint8_t buffer_length, CommandPacket *parsed_packet)
@@ -108,10 +235,11 @@ bool command_parse_packet(const uint8_t *buffer, uint8_t buffer_length, CommandP
         return false;
     }
 
-    // Temporarily copy header to get payload_length
+    // Temporarily copy header to get payload_length and the integrity mode
     parsed_packet->start_byte = buffer[0];
     parsed_packet->command_type = buffer[1];
-    parsed_packet->payload_length = buffer[2];
+    parsed_packet->payload_length = buffer[2] & PACKET_LENGTH_MASK;
+    parsed_packet->integrity_mode = buffer[2] >> PACKET_INTEGRITY_SHIFT;
 
     if (parsed_packet->payload_length > MAX_PAYLOAD_SIZE)
     {
@@ -119,12 +247,19 @@ bool command_parse_packet(const uint8_t *buffer, uint8_t buffer_length, CommandP
         return false;
     }
 
+    uint8_t integrity_size = command_integrity_size((IntegrityMode)parsed_packet->integrity_mode);
+    if (integrity_size == 0)
+    {
+        fprintf(stderr, "Error: Reserved integrity mode in packet header.\n");
+        return false;
+    }
+
     // Check if buffer_length matches expected total packet length
     uint8_t expected_total_length = sizeof(parsed_packet->start_byte) +
                                     sizeof(parsed_packet->command_type) +
                                     sizeof(parsed_packet->payload_length) +
                                     parsed_packet->payload_length +
-                                    sizeof(parsed_packet->checksum);
+                                    integrity_size;
 
     if (buffer_length != expected_total_length)
     {
@@ -137,23 +272,120 @@ bool command_parse_packet(const uint8_t *buffer, uint8_t buffer_length, CommandP
     memset(parsed_packet->payload, 0, MAX_PAYLOAD_SIZE);
     memcpy(parsed_packet->payload, &buffer[3], parsed_packet->payload_length);
 
-    // Extract the received checksum
-    uint8_t received_checksum = buffer[expected_total_length - 1]; // Last byte
+    // Extract the received integrity code (the last bytes)
+    uint8_t covered_length = expected_total_length - integrity_size;
+    uint32_t received_code = read_integrity(&buffer[covered_length], integrity_size);
 
-    // Calculate checksum on the received data (excluding the checksum byte itself)
-    uint8_t calculated_checksum_len = expected_total_length - sizeof(parsed_packet->checksum);
-    uint8_t calculated_checksum = command_calculate_checksum(buffer, calculated_checksum_len);
+    // Calculate it on the received data (excluding the code itself)
+    uint32_t calculated_code = compute_integrity(buffer, covered_length, (IntegrityMode)parsed_packet->integrity_mode);
 
-    if (received_checksum != calculated_checksum)
+    if (received_code != calculated_code)
     {
-        fprintf(stderr, "Error: Checksum mismatch. Expected 0x%02X, Got 0x%02X\n", calculated_checksum, received_checksum);
+        fprintf(stderr, "Error: Checksum mismatch. Expected 0x%02X, Got 0x%02X\n", (unsigned)calculated_code, (unsigned)received_code);
         return false;
     }
 
-    parsed_packet->checksum = received_checksum; // Store the validated checksum
+    // Store the validated code
+    parsed_packet->checksum = parsed_packet->integrity_mode == INTEGRITY_XOR8 ? (uint8_t)received_code : 0;
+    parsed_packet->crc = parsed_packet->integrity_mode == INTEGRITY_XOR8 ? 0 : received_code;
     return true;
 }
 
+// --- Zero-Copy Wire Access ---
+
+bool packet_view_init(PacketView *view, const uint8_t *buffer, size_t buffer_length)
+{
+    if (!view || !buffer || buffer_length == 0)
+        return false;
+    size_t header_size = command_header_size(buffer[0]);
+    if (header_size == 0 || buffer_length < header_size)
+        return false;
+    size_t size = command_frame_size(buffer);
+    if (size == 0 || size > buffer_length || !command_frame_intact(buffer, size))
+        return false;
+
+    view->wire = (const WirePacket *)buffer;
+    view->size = size;
+    return true;
+}
+
+bool packet_view_get_rudder_angle(const PacketView *view, int8_t *out_angle)
+{
+    if (!view || !out_angle)
+        return false;
+    if (packet_view_type(view) != CMD_SET_RUDDER_ANGLE || packet_view_payload_length(view) != sizeof(int8_t))
+        return false;
+    *out_angle = (int8_t)packet_view_payload(view)[0];
+    return true;
+}
+
+bool packet_view_get_op_mode(const PacketView *view, OperationalMode *out_mode)
+{
+    if (!view || !out_mode)
+        return false;
+    if (packet_view_type(view) != CMD_SET_OPERATIONAL_MODE || packet_view_payload_length(view) != sizeof(uint8_t))
+        return false;
+    *out_mode = (OperationalMode)packet_view_payload(view)[0];
+    return true;
+}
+
+size_t command_build_packet(uint8_t *out, size_t out_size, CommandType type, const uint8_t *payload,
+                            uint8_t payload_length, IntegrityMode mode)
+{
+    uint8_t integrity_size = command_integrity_size(mode);
+    if (!out || (!payload && payload_length > 0) || payload_length > MAX_PAYLOAD_SIZE || integrity_size == 0)
+        return 0;
+    size_t covered = PACKET_HEADER_SIZE + payload_length;
+    if (out_size < covered + integrity_size)
+        return 0;
+
+    out[0] = PACKET_START_BYTE;
+    out[1] = (uint8_t)type;
+    out[2] = (uint8_t)(payload_length | mode << PACKET_INTEGRITY_SHIFT);
+    if (payload_length > 0)
+        memcpy(&out[PACKET_HEADER_SIZE], payload, payload_length);
+    write_integrity(&out[covered], compute_integrity(out, covered, mode), integrity_size);
+    return covered + integrity_size;
+}
+
+size_t command_build_ext_packet(uint8_t *out, size_t out_size, CommandType type, const uint8_t *payload,
+                                uint16_t payload_length, IntegrityMode mode)
+{
+    uint8_t integrity_size = command_integrity_size(mode);
+    if (!out || (!payload && payload_length > 0) || payload_length > PACKET_EXT_MAX_PAYLOAD_SIZE || integrity_size == 0)
+        return 0;
+    size_t covered = PACKET_EXT_HEADER_SIZE + (size_t)payload_length;
+    if (out_size < covered + integrity_size)
+        return 0;
+
+    out[0] = PACKET_EXT_START_BYTE;
+    out[1] = (uint8_t)type;
+    out[2] = (uint8_t)(mode << PACKET_INTEGRITY_SHIFT);
+    out[3] = (uint8_t)payload_length;
+    out[4] = (uint8_t)(payload_length >> 8);
+    if (payload_length > 0)
+        memcpy(&out[PACKET_EXT_HEADER_SIZE], payload, payload_length);
+    write_integrity(&out[covered], compute_integrity(out, covered, mode), integrity_size);
+    return covered + integrity_size;
+}
+
+size_t command_build_set_rudder(uint8_t *out, size_t out_size, int8_t angle, IntegrityMode mode)
+{
+    uint8_t payload = (uint8_t)angle;
+    return command_build_packet(out, out_size, CMD_SET_RUDDER_ANGLE, &payload, sizeof(payload), mode);
+}
+
+size_t command_build_set_op_mode(uint8_t *out, size_t out_size, OperationalMode op_mode, IntegrityMode mode)
+{
+    uint8_t payload = (uint8_t)op_mode; // Assuming OperationalMode enum fits in uint8_t
+    return command_build_packet(out, out_size, CMD_SET_OPERATIONAL_MODE, &payload, sizeof(payload), mode);
+}
+
+size_t command_build_request_sensor_data(uint8_t *out, size_t out_size, IntegrityMode mode)
+{
+    return command_build_packet(out, out_size, CMD_REQUEST_SENSOR_DATA, NULL, 0, mode);
+}
+
 // --- Payload Extraction Functions ---
 
 bool command_get_rudder_angle_payload(const CommandPacket *packet, int8_t *out_angle)
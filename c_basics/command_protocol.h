@@ -3,10 +3,44 @@
 
 #include <stdint.h>  // For fixed-width integers
 #include <stdbool.h> // For bool type
+#include <stddef.h>  // For size_t
 
 // --- Constants ---
 #define MAX_PAYLOAD_SIZE 16    // Maximum size of the command payload in bytes
 #define PACKET_START_BYTE 0xAA // Defines the start of a command packet
+#define PACKET_HEADER_SIZE 3   // start_byte, command_type, payload_length
+#define PACKET_MAX_WIRE_SIZE (PACKET_HEADER_SIZE + MAX_PAYLOAD_SIZE + 4) // Header, payload, CRC-32C
+
+// --- Integrity Modes ---
+// The top two bits of the payload_length byte on the wire select how the packet is
+// protected; the low six bits hold the length. Existing packets (length <= 16, top
+// bits 0) are XOR-checksummed exactly as before. The integrity code follows the
+// payload and covers the three header bytes (flag bits included) and the payload.
+#define PACKET_INTEGRITY_SHIFT 6
+#define PACKET_INTEGRITY_MASK 0xC0 // Bits 7-6 of the wire payload_length byte
+#define PACKET_LENGTH_MASK 0x3F    // Bits 5-0: the payload length itself
+
+// --- Extended Frames ---
+// Bulk data (waypoint lists, configuration blobs) would take hundreds of short packets,
+// each paying a header and a checksum for at most 16 payload bytes. Extended frames
+// have their own start byte and a 16-bit payload length:
+//   PACKET_EXT_START_BYTE, command_type, mode byte, length low byte, length high byte
+// The mode byte is where the short format keeps payload_length: its bits 7-6 hold the
+// IntegrityMode as usual and bits 5-0 must be zero. The integrity code follows the
+// payload and covers the five header bytes and the payload. Short commands keep using
+// the short format; it costs two header bytes less.
+#define PACKET_EXT_START_BYTE 0xAB         // Defines the start of an extended packet
+#define PACKET_EXT_HEADER_SIZE 5           // start_byte, command_type, mode, 16-bit length
+#define PACKET_EXT_MAX_PAYLOAD_SIZE 1024   // The format allows 65535; receivers buffer up to this much
+#define PACKET_EXT_MAX_WIRE_SIZE (PACKET_EXT_HEADER_SIZE + PACKET_EXT_MAX_PAYLOAD_SIZE + 4)
+
+typedef enum
+{
+    INTEGRITY_XOR8 = 0,   // 1-byte XOR checksum (the original format)
+    INTEGRITY_CRC16 = 1,  // 2-byte CRC-16-CCITT, little-endian
+    INTEGRITY_CRC32C = 2, // 4-byte CRC-32C, little-endian
+    // 3 is reserved; packets using it are rejected
+} IntegrityMode;
 
 // --- Command Types ---
 // 'enum' creates a set of named integer constants.
@@ -17,6 +51,9 @@ typedef enum
     CMD_SET_RUDDER_ANGLE = 1,     // Command to set the rudder angle
     CMD_REQUEST_SENSOR_DATA = 2,  // Command to request current sensor data
     CMD_SET_OPERATIONAL_MODE = 3, // Command to set system operational mode (e.g., standby, active)
+    CMD_BULK_FRAGMENT = 4,        // One fragment of a larger transfer (see fragment.h)
+    CMD_UPLOAD_WAYPOINTS = 5,     // Waypoint list; sent as a fragmented transfer
+    CMD_TELEMETRY_BATCH = 6,      // A batch of sensor samples (see telemetry.h)
     // Add more commands as needed
 } CommandType;
 
@@ -38,7 +75,9 @@ typedef struct
     uint8_t command_type;              // One of CommandType values
     uint8_t payload_length;            // Actual length of data in the payload array
     uint8_t payload[MAX_PAYLOAD_SIZE]; // Data specific to the command type
-    uint8_t checksum;                  // Simple checksum for data integrity
+    uint8_t checksum;                  // Simple checksum for data integrity (INTEGRITY_XOR8)
+    uint8_t integrity_mode;            // IntegrityMode; travels in the top bits of payload_length
+    uint32_t crc;                      // CRC-16 or CRC-32C value for the CRC modes
 } CommandPacket;
 
 // --- Function Declarations ---
@@ -77,7 +116,7 @@ bool command_create_request_sensor_data(CommandPacket *packet);
 
 /**
  * @brief Deserializes (parses) a byte buffer into a CommandPacket struct.
- *        Validates start byte, payload length, and checksum.
+ *        Validates start byte, payload length, and the checksum or CRC of the packet's integrity mode.
  * @param buffer Pointer to the raw byte buffer received.
  * @param buffer_length The length of the received buffer.
  * @param A CommandPacket struct that will be filled if deserialization is successful.
@@ -85,6 +124,56 @@ bool command_create_request_sensor_data(CommandPacket *packet);
  */
 bool command_parse_packet(const uint8_t *buffer, uint8_t buffer_length, CommandPacket *parsed_packet);
 
+/**
+ * @brief Switches a built packet to another integrity mode and computes its integrity code.
+ *        The command_create_* functions produce INTEGRITY_XOR8 packets; seal them again
+ *        to send them with a CRC instead.
+ * @param packet Pointer to a packet whose header and payload are filled in.
+ * @param mode The integrity mode to use.
+ * @return True if successful, false if packet is NULL, the payload is too large or the mode unknown.
+ */
+bool command_seal_packet(CommandPacket *packet, IntegrityMode mode);
+
+/**
+ * @brief Size in bytes of the integrity code that follows the payload for a mode.
+ * @return 1, 2 or 4, or 0 for an unknown mode.
+ */
+uint8_t command_integrity_size(IntegrityMode mode);
+
+/**
+ * @brief Header size of the frame format a start byte announces.
+ * @return PACKET_HEADER_SIZE, PACKET_EXT_HEADER_SIZE, or 0 if it is not a start byte.
+ */
+size_t command_header_size(uint8_t start_byte);
+
+/**
+ * @brief Total wire size of the frame whose header bytes are given.
+ * @param header The first command_header_size(header[0]) bytes of a frame.
+ * @return The frame size including the integrity code, or 0 if the header is invalid
+ *         (bad start byte, payload too long or reserved integrity mode).
+ */
+size_t command_frame_size(const uint8_t *header);
+
+/**
+ * @brief Checks the integrity code of a complete frame, whichever mode it uses.
+ * @param frame The frame's bytes, starting with the start byte.
+ * @param frame_size The size returned by command_frame_size for this frame.
+ * @return True if the integrity code matches the header and payload.
+ */
+bool command_frame_intact(const uint8_t *frame, size_t frame_size);
+
+/**
+ * @brief Serializes a packet into its wire format: header, payload_length payload bytes and
+ *        the integrity code for its mode. Unlike copying the struct's memory, the unused
+ *        payload bytes are left out and the code follows the payload directly, as
+ *        command_parse_packet expects.
+ * @param packet Pointer to the packet to serialize.
+ * @param buffer Output buffer for the wire bytes.
+ * @param buffer_size Size of the output buffer.
+ * @return The number of bytes written, or 0 if a pointer is NULL, the payload is too large or the buffer too small.
+ */
+size_t command_serialize_packet(const CommandPacket *packet, uint8_t *buffer, size_t buffer_size);
+
 // --- Functions to extract data from a parsed packet's payload ---
 // These demonstrate how to safely get typed data from the generic payload.
 
@@ -104,4 +193,116 @@ bool command_get_rudder_angle_payload(const CommandPacket *packet, int8_t *out_a
  */
 bool command_get_op_mode_payload(const CommandPacket *packet, OperationalMode *out_mode);
 
+// --- Zero-Copy Wire Access ---
+// CommandPacket is convenient but costs copies: parsing memcpy's the payload into it,
+// and its memory layout is not the wire format (the checksum sits after all 16 payload
+// bytes, and the compiler may add padding). The functions below work on the wire bytes
+// themselves: builders write a packet straight into an output buffer, and a PacketView
+// validates a received packet where it lies and reads its fields from there.
+
+// The wire layout, byte for byte. `packed` guarantees no padding, so a pointer into a
+// received buffer can be read through this struct directly. Extended frames share the
+// first three bytes; their 16-bit length is in payload[0..1], before the payload.
+typedef struct __attribute__((packed))
+{
+    uint8_t start_byte;
+    uint8_t command_type;
+    uint8_t length_and_mode; // Payload length (bits 5-0) and IntegrityMode (bits 7-6)
+    uint8_t payload[];       // payload_length bytes, then the integrity code
+} WirePacket;
+
+_Static_assert(sizeof(WirePacket) == PACKET_HEADER_SIZE, "WirePacket must match the wire header exactly");
+
+// A validated packet inside someone else's buffer. It copies nothing and is only
+// valid as long as that buffer is.
+typedef struct
+{
+    const WirePacket *wire;
+    size_t size; // Whole frame, integrity code included
+} PacketView;
+
+/**
+ * @brief Validates the packet at the start of a buffer in place and points a view at it.
+ *        Checks start byte, payload length, integrity mode and checksum/CRC.
+ * @param view Filled in if the packet is valid.
+ * @param buffer The received bytes; may continue past the packet (view->size tells where it ends).
+ * @param buffer_length Number of bytes available at buffer.
+ * @return True if a complete, valid packet starts at buffer.
+ */
+bool packet_view_init(PacketView *view, const uint8_t *buffer, size_t buffer_length);
+
+static inline bool packet_view_is_extended(const PacketView *view) { return view->wire->start_byte == PACKET_EXT_START_BYTE; }
+static inline uint8_t packet_view_type(const PacketView *view) { return view->wire->command_type; }
+static inline IntegrityMode packet_view_integrity(const PacketView *view) { return (IntegrityMode)(view->wire->length_and_mode >> PACKET_INTEGRITY_SHIFT); }
+static inline const uint8_t *packet_view_bytes(const PacketView *view) { return (const uint8_t *)view->wire; }
+
+static inline uint16_t packet_view_payload_length(const PacketView *view)
+{
+    if (packet_view_is_extended(view))
+        return (uint16_t)(view->wire->payload[0] | view->wire->payload[1] << 8);
+    return view->wire->length_and_mode & PACKET_LENGTH_MASK;
+}
+
+static inline const uint8_t *packet_view_payload(const PacketView *view)
+{
+    return view->wire->payload + (packet_view_is_extended(view) ? PACKET_EXT_HEADER_SIZE - PACKET_HEADER_SIZE : 0);
+}
+
+/**
+ * @brief Reads the angle of a CMD_SET_RUDDER_ANGLE packet straight from the wire bytes.
+ * @return True if the packet is the correct type and payload is valid, false otherwise.
+ */
+bool packet_view_get_rudder_angle(const PacketView *view, int8_t *out_angle);
+
+/**
+ * @brief Reads the mode of a CMD_SET_OPERATIONAL_MODE packet straight from the wire bytes.
+ * @return True if the packet is the correct type and payload is valid, false otherwise.
+ */
+bool packet_view_get_op_mode(const PacketView *view, OperationalMode *out_mode);
+
+/**
+ * @brief Writes a complete packet (header, payload, integrity code) into an output buffer.
+ * @param out Output buffer; PACKET_MAX_WIRE_SIZE bytes always suffice.
+ * @param out_size Size of the output buffer.
+ * @param type The command type.
+ * @param payload Payload bytes (may be NULL if payload_length is 0).
+ * @param payload_length Number of payload bytes, at most MAX_PAYLOAD_SIZE.
+ * @param mode Integrity code to append.
+ * @return The number of bytes written, or 0 if the arguments are invalid or the buffer too small.
+ */
+size_t command_build_packet(uint8_t *out, size_t out_size, CommandType type, const uint8_t *payload,
+                            uint8_t payload_length, IntegrityMode mode);
+
+/**
+ * @brief Writes a complete extended packet into an output buffer. Use it for payloads
+ *        over MAX_PAYLOAD_SIZE; command_build_packet is smaller for the rest.
+ * @param out Output buffer; PACKET_EXT_MAX_WIRE_SIZE bytes always suffice.
+ * @param out_size Size of the output buffer.
+ * @param type The command type.
+ * @param payload Payload bytes (may be NULL if payload_length is 0).
+ * @param payload_length Number of payload bytes, at most PACKET_EXT_MAX_PAYLOAD_SIZE.
+ * @param mode Integrity code to append.
+ * @return The number of bytes written, or 0 if the arguments are invalid or the buffer too small.
+ */
+size_t command_build_ext_packet(uint8_t *out, size_t out_size, CommandType type, const uint8_t *payload,
+                                uint16_t payload_length, IntegrityMode mode);
+
+/**
+ * @brief Writes a CMD_SET_RUDDER_ANGLE packet into an output buffer.
+ * @return The number of bytes written, or 0 on failure.
+ */
+size_t command_build_set_rudder(uint8_t *out, size_t out_size, int8_t angle, IntegrityMode mode);
+
+/**
+ * @brief Writes a CMD_SET_OPERATIONAL_MODE packet into an output buffer.
+ * @return The number of bytes written, or 0 on failure.
+ */
+size_t command_build_set_op_mode(uint8_t *out, size_t out_size, OperationalMode op_mode, IntegrityMode mode);
+
+/**
+ * @brief Writes a CMD_REQUEST_SENSOR_DATA packet (no payload) into an output buffer.
+ * @return The number of bytes written, or 0 on failure.
+ */
+size_t command_build_request_sensor_data(uint8_t *out, size_t out_size, IntegrityMode mode);
+
 #endif // COMMAND_PROTOCOL_H_
\ No newline at end of file
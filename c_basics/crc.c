@@ -0,0 +1,231 @@
+#include "crc.h"
+#include <stdatomic.h> // For the dispatch pointers
+#include <string.h>    // For memcpy
+#include <threads.h>   // For call_once (building the tables exactly once)
+
+#if defined(__GNUC__) && defined(__x86_64__)
+#define CRC_HAVE_SSE42 1
+#include <immintrin.h> // For _mm_crc32_u8/_mm_crc32_u64
+#endif
+
+#define CRC16_POLY 0x1021u     // x^16 + x^12 + x^5 + 1
+#define CRC32C_POLY 0x82F63B78u // Castagnoli polynomial, bit-reversed for LSB-first processing
+
+// --- Bitwise Reference Implementations ---
+
+static uint16_t crc16_bitwise(const uint8_t *data, size_t length)
+{
+    uint16_t crc = 0xFFFF;
+    for (size_t i = 0; i < length; ++i)
+    {
+        crc ^= (uint16_t)(data[i] << 8);
+        for (int bit = 0; bit < 8; ++bit)
+            crc = (crc & 0x8000) ? (uint16_t)((crc << 1) ^ CRC16_POLY) : (uint16_t)(crc << 1);
+    }
+    return crc;
+}
+
+static uint32_t crc32c_bitwise(const uint8_t *data, size_t length)
+{
+    uint32_t crc = 0xFFFFFFFFu;
+    for (size_t i = 0; i < length; ++i)
+    {
+        crc ^= data[i];
+        for (int bit = 0; bit < 8; ++bit)
+            crc = (crc & 1) ? (crc >> 1) ^ CRC32C_POLY : crc >> 1;
+    }
+    return ~crc;
+}
+
+// --- Slicing-by-8 Tables ---
+// table[0][x] is the CRC update for byte x; table[k][x] is the update for byte x
+// followed by k zero bytes. Eight lookups (one per byte of a 64-bit word) XORed
+// together then advance the CRC by 8 bytes at once, with no dependency between
+// the lookups.
+
+static uint16_t crc16_table[8][256];
+static uint32_t crc32c_table[8][256];
+static once_flag tables_once = ONCE_FLAG_INIT;
+
+static void build_tables(void)
+{
+    for (uint32_t x = 0; x < 256; ++x)
+    {
+        uint16_t crc16 = (uint16_t)(x << 8);
+        for (int bit = 0; bit < 8; ++bit)
+            crc16 = (crc16 & 0x8000) ? (uint16_t)((crc16 << 1) ^ CRC16_POLY) : (uint16_t)(crc16 << 1);
+        crc16_table[0][x] = crc16;
+        uint32_t crc = x;
+        for (int bit = 0; bit < 8; ++bit)
+            crc = (crc & 1) ? (crc >> 1) ^ CRC32C_POLY : crc >> 1;
+        crc32c_table[0][x] = crc;
+    }
+    for (int k = 1; k < 8; ++k)
+    {
+        for (uint32_t x = 0; x < 256; ++x)
+        {
+            uint16_t previous16 = crc16_table[k - 1][x];
+            crc16_table[k][x] = (uint16_t)((previous16 << 8) ^ crc16_table[0][previous16 >> 8]);
+            uint32_t previous32 = crc32c_table[k - 1][x];
+            crc32c_table[k][x] = (previous32 >> 8) ^ crc32c_table[0][previous32 & 0xFF];
+        }
+    }
+}
+
+static uint16_t crc16_slice8(const uint8_t *data, size_t length)
+{
+    uint16_t crc = 0xFFFF;
+    for (; length >= 8; data += 8, length -= 8)
+    {
+        // MSB first: the CRC lines up with the first two bytes of the block
+        uint16_t top = (uint16_t)(crc ^ (data[0] << 8 | data[1]));
+        crc = (uint16_t)(crc16_table[7][top >> 8] ^ crc16_table[6][top & 0xFF] ^
+                         crc16_table[5][data[2]] ^ crc16_table[4][data[3]] ^
+                         crc16_table[3][data[4]] ^ crc16_table[2][data[5]] ^
+                         crc16_table[1][data[6]] ^ crc16_table[0][data[7]]);
+    }
+    for (; length > 0; ++data, --length)
+        crc = (uint16_t)((crc << 8) ^ crc16_table[0][(crc >> 8) ^ *data]);
+    return crc;
+}
+
+static uint32_t crc32c_slice8(const uint8_t *data, size_t length)
+{
+    uint32_t crc = 0xFFFFFFFFu;
+    for (; length >= 8; data += 8, length -= 8)
+    {
+        // LSB first: the CRC lines up with the first four bytes of the block
+        uint32_t low = crc ^ (uint32_t)(data[0] | data[1] << 8 | data[2] << 16 | (uint32_t)data[3] << 24);
+        crc = crc32c_table[7][low & 0xFF] ^ crc32c_table[6][(low >> 8) & 0xFF] ^
+              crc32c_table[5][(low >> 16) & 0xFF] ^ crc32c_table[4][low >> 24] ^
+              crc32c_table[3][data[4]] ^ crc32c_table[2][data[5]] ^
+              crc32c_table[1][data[6]] ^ crc32c_table[0][data[7]];
+    }
+    for (; length > 0; ++data, --length)
+        crc = (crc >> 8) ^ crc32c_table[0][(crc ^ *data) & 0xFF];
+    return ~crc;
+}
+
+#ifdef CRC_HAVE_SSE42
+// --- SSE4.2 Implementation ---
+// The crc32 instruction computes exactly CRC-32C, 8 bytes per instruction.
+
+__attribute__((target("sse4.2"))) static uint32_t crc32c_sse42(const uint8_t *data, size_t length)
+{
+    uint64_t crc = 0xFFFFFFFFu;
+    for (; length >= 8; data += 8, length -= 8)
+    {
+        uint64_t word;
+        memcpy(&word, data, sizeof(word));
+        crc = _mm_crc32_u64(crc, word);
+    }
+    for (; length > 0; ++data, --length)
+        crc = _mm_crc32_u8((uint32_t)crc, *data);
+    return ~(uint32_t)crc;
+}
+#endif
+
+// --- Runtime Dispatch ---
+// Same scheme as checksum.c: pointers start at a resolver that picks the
+// implementation (after building the tables) on the first call. The pointers are
+// published with release and read with acquire, so a thread that sees a table
+// kernel also sees the finished tables.
+
+typedef uint16_t (*Crc16Kernel)(const uint8_t *data, size_t length);
+typedef uint32_t (*Crc32Kernel)(const uint8_t *data, size_t length);
+
+static uint16_t crc16_first_call(const uint8_t *data, size_t length);
+static uint32_t crc32c_first_call(const uint8_t *data, size_t length);
+
+static _Atomic(Crc16Kernel) crc16_kernel = crc16_first_call;
+static _Atomic(Crc32Kernel) crc32c_kernel = crc32c_first_call;
+static _Atomic(int) active_impl = CRC_IMPL_AUTO;
+
+bool crc_select(CrcImpl impl)
+{
+    call_once(&tables_once, build_tables);
+    if (impl == CRC_IMPL_AUTO)
+    {
+        impl = CRC_IMPL_SLICE8;
+#ifdef CRC_HAVE_SSE42
+        if (__builtin_cpu_supports("sse4.2"))
+            impl = CRC_IMPL_SSE42;
+#endif
+    }
+
+    Crc16Kernel crc16 = crc16_slice8;
+    Crc32Kernel crc32 = crc32c_slice8;
+    switch (impl)
+    {
+    case CRC_IMPL_BITWISE:
+        crc16 = crc16_bitwise;
+        crc32 = crc32c_bitwise;
+        break;
+    case CRC_IMPL_SLICE8:
+        break;
+#ifdef CRC_HAVE_SSE42
+    case CRC_IMPL_SSE42:
+        if (!__builtin_cpu_supports("sse4.2"))
+            return false;
+        crc32 = crc32c_sse42;
+        break;
+#endif
+    default:
+        return false;
+    }
+    atomic_store_explicit(&crc16_kernel, crc16, memory_order_release);
+    atomic_store_explicit(&crc32c_kernel, crc32, memory_order_release);
+    atomic_store_explicit(&active_impl, (int)impl, memory_order_relaxed);
+    return true;
+}
+
+CrcImpl crc_active(void)
+{
+    if (atomic_load_explicit(&active_impl, memory_order_relaxed) == CRC_IMPL_AUTO)
+        crc_select(CRC_IMPL_AUTO);
+    return (CrcImpl)atomic_load_explicit(&active_impl, memory_order_relaxed);
+}
+
+const char *crc_impl_name(CrcImpl impl)
+{
+    switch (impl)
+    {
+    case CRC_IMPL_AUTO:
+        return "auto";
+    case CRC_IMPL_BITWISE:
+        return "bitwise";
+    case CRC_IMPL_SLICE8:
+        return "slice8";
+    case CRC_IMPL_SSE42:
+        return "sse4.2";
+    }
+    return "unknown";
+}
+
+static uint16_t crc16_first_call(const uint8_t *data, size_t length)
+{
+    crc_select(CRC_IMPL_AUTO);
+    return crc16_ccitt(data, length);
+}
+
+static uint32_t crc32c_first_call(const uint8_t *data, size_t length)
+{
+    crc_select(CRC_IMPL_AUTO);
+    return crc32c(data, length);
+}
+
+// --- Public Functions ---
+
+uint16_t crc16_ccitt(const uint8_t *data, size_t length)
+{
+    if (!data)
+        length = 0;
+    return atomic_load_explicit(&crc16_kernel, memory_order_acquire)(data, length);
+}
+
+uint32_t crc32c(const uint8_t *data, size_t length)
+{
+    if (!data)
+        length = 0;
+    return atomic_load_explicit(&crc32c_kernel, memory_order_acquire)(data, length);
+}
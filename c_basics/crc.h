@@ -0,0 +1,73 @@
+#ifndef CRC_H_
+#define CRC_H_
+
+#include <stdbool.h> // For bool type
+#include <stddef.h>  // For size_t
+#include <stdint.h>  // For fixed-width integers
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+// --- Cyclic Redundancy Checks ---
+// Stronger integrity codes than the 8-bit XOR/sum checksums: a CRC detects every
+// burst error up to its width and every swap of two bytes, which XOR and addition
+// cannot see at all.
+//
+//  CRC-16-CCITT ("CCITT-FALSE"): polynomial 0x1021, initial value 0xFFFF, MSB first,
+//                                no final XOR. CRC of "123456789" = 0x29B1.
+//  CRC-32C (Castagnoli):         polynomial 0x1EDC6F41 (reflected 0x82F63B78), initial
+//                                value and final XOR 0xFFFFFFFF, LSB first.
+//                                CRC of "123456789" = 0xE3069283.
+//
+// Both use slicing-by-8 tables (8 bytes per step instead of 1). CRC-32C also uses
+// the SSE4.2 `crc32` instruction on x86 CPUs that have it, picked at runtime.
+
+typedef enum
+{
+    CRC_IMPL_AUTO = 0, // Best supported by this CPU
+    CRC_IMPL_BITWISE,  // One bit per step; the reference the others are checked against
+    CRC_IMPL_SLICE8,   // Table-driven, 8 bytes per step
+    CRC_IMPL_SSE42,    // Hardware crc32 instruction (CRC-32C only)
+} CrcImpl;
+
+/**
+ * @brief CRC-16-CCITT of a buffer.
+ * @param data Pointer to the data buffer.
+ * @param length The number of bytes to process.
+ * @return The 16-bit CRC (0xFFFF for an empty buffer).
+ */
+uint16_t crc16_ccitt(const uint8_t *data, size_t length);
+
+/**
+ * @brief CRC-32C of a buffer.
+ * @param data Pointer to the data buffer.
+ * @param length The number of bytes to process.
+ * @return The 32-bit CRC (0 for an empty buffer).
+ */
+uint32_t crc32c(const uint8_t *data, size_t length);
+
+/**
+ * @brief Forces a specific implementation, e.g. to benchmark them against each other.
+ *        CRC_IMPL_SSE42 makes CRC-16 use its table version.
+ * @param impl The implementation to use from now on; CRC_IMPL_AUTO restores the default choice.
+ * @return True if successful, false if this CPU (or build) does not support it.
+ */
+bool crc_select(CrcImpl impl);
+
+/**
+ * @brief Reports which implementation CRC-32C currently uses (never CRC_IMPL_AUTO).
+ */
+CrcImpl crc_active(void);
+
+/**
+ * @brief Human-readable name of an implementation ("bitwise", "slice8", ...).
+ */
+const char *crc_impl_name(CrcImpl impl);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // CRC_H_
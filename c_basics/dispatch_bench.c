@@ -0,0 +1,97 @@
+// Benchmark for the table-driven command dispatcher.
+//
+// Usage: dispatch_bench [million packets per measurement]
+//
+// Dispatches a stream of pre-built packets with random command types through a
+// table with 3 registered types and through one with all 256, and reports the cost
+// per packet. Both should be the same: lookup is one array index regardless of how
+// many types are registered. Packets with a wrong payload length are mixed in to
+// show that rejecting them costs no more than handling them.
+
+#define _POSIX_C_SOURCE 200809L // For clock_gettime
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "command_dispatch.h"
+
+static double now_seconds(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+#define PACKET_COUNT 4096 // Pre-built packets, cycled through during timing
+
+static bool count_payload(const PacketView *packet, void *context)
+{
+    uint64_t *total = (uint64_t *)context;
+    *total += packet_view_payload_length(packet) + packet_view_type(packet);
+    return true;
+}
+
+// The three commands the flight system knows today, registered at compile time
+static const CommandSpec small_table[COMMAND_TABLE_SIZE] = {
+    COMMAND_ENTRY(CMD_SET_RUDDER_ANGLE, 1, 1, count_payload),
+    COMMAND_ENTRY(CMD_REQUEST_SENSOR_DATA, 0, 0, count_payload),
+    COMMAND_ENTRY(CMD_SET_OPERATIONAL_MODE, 1, 1, count_payload),
+};
+
+// Every type registered; filled at startup since 256 entries by hand would be silly
+static CommandSpec full_table[COMMAND_TABLE_SIZE];
+
+static uint8_t wire[PACKET_COUNT][PACKET_MAX_WIRE_SIZE];
+static PacketView packets[PACKET_COUNT];
+
+// Builds packets whose types are drawn from [0, type_count) (0 is replaced by 1).
+// Every eighth packet gets one payload byte too many for its table entry.
+static void build_packets(unsigned type_count, uint32_t seed)
+{
+    uint8_t payload[MAX_PAYLOAD_SIZE] = {0};
+    for (size_t i = 0; i < PACKET_COUNT; ++i)
+    {
+        seed = seed * 1103515245u + 12345u;
+        uint8_t type = (uint8_t)((seed >> 16) % type_count);
+        if (type == 0)
+            type = 1;
+        uint8_t length = type == CMD_REQUEST_SENSOR_DATA ? 0 : 1;
+        if (i % 8 == 7)
+            length++;
+        size_t size = command_build_packet(wire[i], sizeof(wire[i]), (CommandType)type, payload, length, INTEGRITY_XOR8);
+        packet_view_init(&packets[i], wire[i], size);
+    }
+}
+
+static void time_table(const char *label, const CommandSpec *table, size_t total)
+{
+    DispatchStats stats = {{0}};
+    uint64_t sum = 0;
+    double start = now_seconds();
+    for (size_t i = 0; i < total; ++i)
+        command_dispatch(table, &packets[i % PACKET_COUNT], &sum, &stats);
+    double seconds = now_seconds() - start;
+    printf("%-22s %8.2f ns/packet   %10llu ok %10llu bad length %6llu unknown (sink %llu)\n", label,
+           seconds * 1e9 / (double)total, (unsigned long long)stats.results[DISPATCH_OK],
+           (unsigned long long)stats.results[DISPATCH_BAD_LENGTH],
+           (unsigned long long)stats.results[DISPATCH_UNKNOWN_COMMAND], (unsigned long long)sum);
+}
+
+int main(int argc, char *argv[])
+{
+    size_t total = (argc > 1 ? strtoul(argv[1], NULL, 10) : 50) * 1000 * 1000;
+
+    for (unsigned type = 1; type < COMMAND_TABLE_SIZE; ++type)
+    {
+        uint8_t length = type == CMD_REQUEST_SENSOR_DATA ? 0 : 1;
+        full_table[type] = (CommandSpec){count_payload, length, length, "generated"};
+    }
+
+    build_packets(4, 7);
+    time_table("3 types, 3 registered", small_table, total);
+    time_table("3 types, 255 registered", full_table, total);
+    build_packets(COMMAND_TABLE_SIZE, 7);
+    time_table("255 types registered", full_table, total);
+    return 0;
+}
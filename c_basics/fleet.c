@@ -0,0 +1,124 @@
+#include "fleet.h"
+#include <stdlib.h> // For aligned_alloc and free
+#include <string.h> // For memset
+
+#define FLEET_ALIGN 64           // Each array starts on its own cache line
+#define FLEET_CONTROL_CHUNK 1024 // Aircraft per rudder_set_angles call; the targets live on the stack
+
+static size_t align_up(size_t size)
+{
+    return (size + FLEET_ALIGN - 1) / FLEET_ALIGN * FLEET_ALIGN;
+}
+
+// --- Setup ---
+
+bool fleet_init(Fleet *fleet, size_t count, uint64_t seed)
+{
+    memset(fleet, 0, sizeof(*fleet));
+    if (count == 0 || count > SIZE_MAX / 2 / (sizeof(SensorRng) + 16))
+        return false;
+
+    // One allocation, carved into the arrays in order
+    size_t sizes[] = {
+        count * sizeof(float),     count * sizeof(int16_t), count * sizeof(float),
+        count * sizeof(uint8_t),   count * sizeof(uint8_t), count * sizeof(int8_t),
+        count * sizeof(SensorRng),
+    };
+    size_t total = 0;
+    for (size_t i = 0; i < sizeof(sizes) / sizeof(sizes[0]); ++i)
+        total += align_up(sizes[i]);
+    uint8_t *storage = aligned_alloc(FLEET_ALIGN, total);
+    if (!storage)
+        return false;
+    memset(storage, 0, total);
+
+    uint8_t *next = storage;
+    fleet->altitude_m = (float *)next;
+    next += align_up(sizes[0]);
+    fleet->airspeed_kmh = (int16_t *)next;
+    next += align_up(sizes[1]);
+    fleet->temperature_c = (float *)next;
+    next += align_up(sizes[2]);
+    fleet->status_flags = next;
+    next += align_up(sizes[3]);
+    fleet->op_mode = next;
+    next += align_up(sizes[4]);
+    fleet->rudder_angle_deg = (int8_t *)next;
+    next += align_up(sizes[5]);
+    fleet->rng = (SensorRng *)next;
+
+    fleet->storage = storage;
+    fleet->count = count;
+    for (size_t i = 0; i < count; ++i)
+    {
+        fleet->op_mode[i] = MODE_ACTIVE_FLIGHT;
+        fleet->airspeed_kmh[i] = (FLIGHT_OVERSPEED_KMH + FLIGHT_UNDERSPEED_KMH) / 2; // Until the first reading
+        // Consecutive seeds: SplitMix64 steps its own state by the golden-ratio increment,
+        // so seed + i never lands on another aircraft's expansion
+        sensor_rng_seed(&fleet->rng[i], SENSOR_RNG_XOSHIRO256SS, seed + i);
+    }
+    return true;
+}
+
+void fleet_free(Fleet *fleet)
+{
+    free(fleet->storage);
+    memset(fleet, 0, sizeof(*fleet));
+}
+
+// --- Simulation Steps ---
+
+void fleet_sample_range(Fleet *fleet, size_t begin, size_t end)
+{
+    for (size_t i = begin; i < end; ++i)
+    {
+        SensorData data = sensor_read_data_from(&fleet->rng[i]);
+        fleet->altitude_m[i] = data.altitude_m;
+        fleet->airspeed_kmh[i] = data.airspeed_kmh;
+        fleet->temperature_c[i] = data.temperature_c;
+        fleet->status_flags[i] = data.status_flags;
+    }
+}
+
+// The control law (flight_control_decide's rule) for count aircraft. An aircraft that
+// is not steering targets its current angle, so it stays put. Branch-free and over
+// arrays that do not overlap, so the compiler vectorizes it (at -O2 only when inlined
+// with a fixed count, as for whole chunks below).
+static inline void control_targets(int8_t *restrict targets, const int16_t *restrict speed, const uint8_t *restrict mode,
+                            const int8_t *restrict angle, size_t count)
+{
+    for (size_t i = 0; i < count; ++i)
+    {
+        int8_t target = (int8_t)(((speed[i] < FLIGHT_UNDERSPEED_KMH) - (speed[i] > FLIGHT_OVERSPEED_KMH)) *
+                                 FLIGHT_SPEED_CORRECTION_DEG);
+        int8_t current = angle[i]; // Loaded either way, so the select needs no branch
+        targets[i] = mode[i] == MODE_ACTIVE_FLIGHT ? target : current;
+    }
+}
+
+void fleet_control_range(Fleet *fleet, size_t begin, size_t end)
+{
+    // The targets go through rudder_set_angles, which applies the rudder limits
+    int8_t targets[FLEET_CONTROL_CHUNK];
+    for (size_t chunk = begin; chunk < end; chunk += FLEET_CONTROL_CHUNK)
+    {
+        size_t count = end - chunk;
+        if (count >= FLEET_CONTROL_CHUNK)
+        {
+            count = FLEET_CONTROL_CHUNK;
+            control_targets(targets, fleet->airspeed_kmh + chunk, fleet->op_mode + chunk,
+                            fleet->rudder_angle_deg + chunk, FLEET_CONTROL_CHUNK);
+        }
+        else
+            control_targets(targets, fleet->airspeed_kmh + chunk, fleet->op_mode + chunk,
+                            fleet->rudder_angle_deg + chunk, count);
+        RudderBatch batch = {fleet->rudder_angle_deg + chunk, targets, count, 0, {0, 0, 0}};
+        rudder_set_angles(&batch);
+    }
+}
+
+void fleet_step(Fleet *fleet)
+{
+    fleet_sample_range(fleet, 0, fleet->count);
+    fleet_control_range(fleet, 0, fleet->count);
+}
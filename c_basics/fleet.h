@@ -0,0 +1,76 @@
+#ifndef FLEET_H_
+#define FLEET_H_
+
+#include <stdbool.h> // For bool type
+#include <stddef.h>  // For size_t
+#include <stdint.h>  // For fixed-width integers
+
+#include "flight_control.h" // For the control law constants
+#include "rudder_control.h" // For the rudder limits
+#include "sensor_module.h"  // For SensorRng and the simulated readings
+
+// --- Fleet Simulation ---
+// Many aircraft in one process. An array of per-aircraft structs would put each
+// aircraft's fields side by side in memory; a control loop that only needs airspeed
+// and rudder angle would then drag every other field through the cache as well, and
+// the compiler could not process several aircraft per instruction. A Fleet instead
+// keeps one array per field (struct of arrays): aircraft i is index i in each, and
+// the control step over all aircraft is two branch-free passes over a few contiguous
+// arrays: the control law, which the compiler vectorizes, then rudder_set_angles.
+//
+// Each aircraft has its own sensor generator, so its readings do not depend on how
+// the fleet is split between threads. The fleet_*_range functions let each thread
+// take a contiguous share of the aircraft.
+
+typedef struct
+{
+    size_t count;
+
+    // Latest sensor reading of each aircraft
+    float *altitude_m;
+    int16_t *airspeed_kmh;
+    float *temperature_c;
+    uint8_t *status_flags;
+
+    // Control state
+    uint8_t *op_mode;          // OperationalMode; only MODE_ACTIVE_FLIGHT aircraft steer
+    int8_t *rudder_angle_deg;  // Current rudder angle, within the rudder limits
+
+    SensorRng *rng;            // One sensor generator per aircraft
+
+    void *storage;             // The single allocation all arrays above live in
+} Fleet;
+
+// --- Function Declarations ---
+
+/**
+ * @brief Allocates a fleet: every aircraft in active flight, rudder centred, sensors seeded.
+ * @param fleet The fleet to set up.
+ * @param count Number of aircraft.
+ * @param seed Aircraft i's sensors are seeded with seed + i.
+ * @return True if successful, false if the memory could not be allocated.
+ */
+bool fleet_init(Fleet *fleet, size_t count, uint64_t seed);
+
+/**
+ * @brief Frees a fleet's arrays.
+ */
+void fleet_free(Fleet *fleet);
+
+/**
+ * @brief Takes a new sensor reading for aircraft [begin, end).
+ */
+void fleet_sample_range(Fleet *fleet, size_t begin, size_t end);
+
+/**
+ * @brief Runs the control law (flight_control_decide's rule) for aircraft [begin, end),
+ *        then applies the rudder limits to their targets with rudder_set_angles.
+ */
+void fleet_control_range(Fleet *fleet, size_t begin, size_t end);
+
+/**
+ * @brief One simulation step for the whole fleet: sample, then control.
+ */
+void fleet_step(Fleet *fleet);
+
+#endif // FLEET_H_
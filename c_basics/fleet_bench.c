@@ -0,0 +1,187 @@
+// Benchmark for fleet simulation.
+//
+// Usage: fleet_bench [aircraft]
+//
+// Simulates a fleet (default 100,000 aircraft) two ways:
+//   - an array of per-aircraft structs, each updated with flight_control_decide and
+//     rudder_instance_set_angle (one aircraft per call)
+//   - a Fleet (struct of arrays) updated with fleet_control_range (vectorized passes)
+// and reports aircraft per second for the control step, the sensor step and whole
+// simulation steps on 1, 2 and 4 threads. Both layouts start from the same seeds and
+// every rudder angle is compared after each step.
+
+#define _POSIX_C_SOURCE 200809L // For clock_gettime
+
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "fleet.h"
+
+#define BENCH_SEED 7
+#define CONTROL_ROUNDS 200
+#define STEP_ROUNDS 10
+#define MAX_THREADS 4
+
+static double now_seconds(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+// One aircraft as a single struct
+typedef struct
+{
+    SensorData sensor;
+    RudderConfig rudder;
+    uint8_t op_mode;
+    SensorRng rng;
+} Aircraft;
+
+static Fleet fleet;
+static Aircraft *aircraft;
+static size_t count;
+
+// The simulated airspeed stays within 250-349 km/h, where the control law never acts;
+// a fixed gust per aircraft spreads it over 150-449 so every branch is exercised
+static int16_t gust(size_t i)
+{
+    return (int16_t)(i * 7919 % 201) - 100;
+}
+
+static void aos_sample(void)
+{
+    for (size_t i = 0; i < count; ++i)
+    {
+        aircraft[i].sensor = sensor_read_data_from(&aircraft[i].rng);
+        aircraft[i].sensor.airspeed_kmh += gust(i);
+    }
+}
+
+static void fleet_sample(size_t begin, size_t end)
+{
+    fleet_sample_range(&fleet, begin, end);
+    for (size_t i = begin; i < end; ++i)
+        fleet.airspeed_kmh[i] += gust(i);
+}
+
+static void aos_control(void)
+{
+    for (size_t i = 0; i < count; ++i)
+    {
+        if (aircraft[i].op_mode == MODE_ACTIVE_FLIGHT)
+            rudder_instance_set_angle(&aircraft[i].rudder, flight_control_decide(&aircraft[i].sensor));
+    }
+}
+
+static size_t mismatches(void)
+{
+    size_t wrong = 0;
+    for (size_t i = 0; i < count; ++i)
+        wrong += fleet.rudder_angle_deg[i] != aircraft[i].rudder.current_angle_deg;
+    return wrong;
+}
+
+typedef struct
+{
+    size_t begin;
+    size_t end;
+} Range;
+
+static void *step_range(void *arg)
+{
+    Range *range = (Range *)arg;
+    for (int round = 0; round < STEP_ROUNDS; ++round)
+    {
+        fleet_sample(range->begin, range->end);
+        fleet_control_range(&fleet, range->begin, range->end);
+    }
+    return NULL;
+}
+
+int main(int argc, char *argv[])
+{
+    count = argc > 1 ? (size_t)atol(argv[1]) : 100000;
+    if (count == 0)
+        count = 1;
+    aircraft = malloc(count * sizeof(Aircraft));
+    if (!aircraft || !fleet_init(&fleet, count, BENCH_SEED))
+    {
+        fprintf(stderr, "Error: Out of memory.\n");
+        return 1;
+    }
+    for (size_t i = 0; i < count; ++i)
+    {
+        // Same seeds as fleet_init, and every 8th aircraft in standby
+        aircraft[i].sensor = (SensorData){0.0f, (FLIGHT_OVERSPEED_KMH + FLIGHT_UNDERSPEED_KMH) / 2, 0.0f, 0};
+        rudder_instance_init(&aircraft[i].rudder, 0);
+        aircraft[i].op_mode = i % 8 == 3 ? MODE_STANDBY : MODE_ACTIVE_FLIGHT;
+        fleet.op_mode[i] = aircraft[i].op_mode;
+        sensor_rng_seed(&aircraft[i].rng, SENSOR_RNG_XOSHIRO256SS, BENCH_SEED + i);
+    }
+    printf("%zu aircraft: %zu bytes per aircraft as a struct, %zu in the fleet arrays (plus its generator)\n", count,
+           sizeof(Aircraft), sizeof(float) * 2 + sizeof(int16_t) + 3);
+
+    // Sensor step
+    double start = now_seconds();
+    aos_sample();
+    double aos_sample_s = now_seconds() - start;
+    start = now_seconds();
+    fleet_sample(0, count);
+    double soa_sample_s = now_seconds() - start;
+
+    // Control step, repeated (the result is the same every round)
+    start = now_seconds();
+    for (int round = 0; round < CONTROL_ROUNDS; ++round)
+        aos_control();
+    double aos_control_s = (now_seconds() - start) / CONTROL_ROUNDS;
+    start = now_seconds();
+    for (int round = 0; round < CONTROL_ROUNDS; ++round)
+        fleet_control_range(&fleet, 0, count);
+    double soa_control_s = (now_seconds() - start) / CONTROL_ROUNDS;
+    size_t wrong = mismatches();
+
+    printf("\n== One thread ==\n");
+    printf("sensor step    structs %8.2f ns/aircraft   fleet %8.2f ns/aircraft\n", aos_sample_s * 1e9 / count,
+           soa_sample_s * 1e9 / count);
+    printf("control step   structs %8.3f ns/aircraft   fleet %8.3f ns/aircraft  (%.1fx, %.0f M aircraft/s)\n",
+           aos_control_s * 1e9 / count, soa_control_s * 1e9 / count, aos_control_s / soa_control_s,
+           count / soa_control_s / 1e6);
+    size_t steering = 0;
+    for (size_t i = 0; i < count; ++i)
+        steering += fleet.rudder_angle_deg[i] != 0;
+    printf("%zu rudder angles differ between the two (%zu aircraft steering)\n", wrong, steering);
+
+    printf("\n== Whole steps, fleet split between threads ==\n");
+    for (unsigned threads = 1; threads <= MAX_THREADS; threads *= 2)
+    {
+        pthread_t ids[MAX_THREADS];
+        Range ranges[MAX_THREADS];
+        start = now_seconds();
+        for (unsigned t = 0; t < threads; ++t)
+        {
+            // Split on multiples of 64 so no two threads write the same cache line
+            ranges[t].begin = count * t / threads / 64 * 64;
+            ranges[t].end = t + 1 == threads ? count : count * (t + 1) / threads / 64 * 64;
+            pthread_create(&ids[t], NULL, step_range, &ranges[t]);
+        }
+        for (unsigned t = 0; t < threads; ++t)
+            pthread_join(ids[t], NULL);
+        double seconds = (now_seconds() - start) / STEP_ROUNDS;
+        printf("%u thread(s): %.2f ms per step, %.1f M aircraft/s\n", threads, seconds * 1e3, count / seconds / 1e6);
+    }
+
+    // Whole steps leave the fleet ahead of the structs: catch them up and compare again
+    for (int round = 0; round < STEP_ROUNDS * 3; ++round)
+    {
+        aos_sample();
+        aos_control();
+    }
+    printf("%zu rudder angles differ after %d more steps\n", mismatches(), STEP_ROUNDS * 3);
+
+    fleet_free(&fleet);
+    free(aircraft);
+    return 0;
+}
@@ -0,0 +1,77 @@
+#include "flight_control.h"
+#include <stdio.h> // For printf
+
+// --- Command Handlers ---
+// One function per command type, registered in flight_commands below. The dispatcher
+// has already checked each packet's payload length against the table, so handlers
+// read the payload directly.
+
+static bool on_set_rudder(const PacketView *packet, void *context)
+{
+    FlightContext *flight = (FlightContext *)context;
+    int8_t angle = (int8_t)packet_view_payload(packet)[0];
+    if (flight->verbose)
+        printf("Extracted angle from payload: %d\n", angle);
+    rudder_set_angle(flight->rudder, angle);
+    if (flight->verbose)
+        printf("Rudder - Set by command. Current Angle: %d degrees\n", rudder_get_current_angle(flight->rudder));
+    return true;
+}
+
+static bool on_set_op_mode(const PacketView *packet, void *context)
+{
+    FlightContext *flight = (FlightContext *)context;
+    uint8_t mode = packet_view_payload(packet)[0];
+    if (mode > MODE_DIAGNOSTIC)
+        return false; // Not a mode we know; keep the current one
+    *flight->op_mode = (OperationalMode)mode;
+    if (flight->verbose)
+        printf("System operational mode set to: %d\n", *flight->op_mode);
+    return true;
+}
+
+static bool on_request_sensor_data(const PacketView *packet, void *context)
+{
+    FlightContext *flight = (FlightContext *)context;
+    (void)packet;
+    SensorData s_data = sensor_read_data();
+    if (flight->verbose)
+    {
+        printf("Received CMD_REQUEST_SENSOR_DATA. (Simulating sending data back...)\n");
+        printf("  Sensor - Alt: %.2f m, Speed: %d km/h, Temp: %.1f C\n",
+               s_data.altitude_m, s_data.airspeed_kmh, s_data.temperature_c);
+        sensor_process_status_flags(s_data.status_flags);
+    }
+    return true;
+}
+
+static bool on_bulk_fragment(const PacketView *packet, void *context)
+{
+    FlightContext *flight = (FlightContext *)context;
+    return flight->bulk && fragment_pool_accept(flight->bulk, packet);
+}
+
+// Supporting a new command is one line here (plus its handler)
+const CommandSpec flight_commands[COMMAND_TABLE_SIZE] = {
+    COMMAND_ENTRY(CMD_SET_RUDDER_ANGLE, sizeof(int8_t), sizeof(int8_t), on_set_rudder),
+    COMMAND_ENTRY(CMD_REQUEST_SENSOR_DATA, 0, 0, on_request_sensor_data),
+    COMMAND_ENTRY(CMD_SET_OPERATIONAL_MODE, sizeof(uint8_t), sizeof(uint8_t), on_set_op_mode),
+    COMMAND_ENTRY(CMD_BULK_FRAGMENT, FRAGMENT_HEADER_SIZE + 1, PACKET_EXT_MAX_PAYLOAD_SIZE, on_bulk_fragment),
+};
+
+// --- Control Law ---
+
+int8_t flight_control_decide(const SensorData *data)
+{
+    // Too fast: turn against it; too slow: turn the other way
+    if (data->airspeed_kmh > FLIGHT_OVERSPEED_KMH)
+        return -FLIGHT_SPEED_CORRECTION_DEG;
+    if (data->airspeed_kmh < FLIGHT_UNDERSPEED_KMH)
+        return FLIGHT_SPEED_CORRECTION_DEG;
+    return 0;
+}
+
+int8_t flight_control_update(FlightContext *flight, const SensorData *data)
+{
+    return rudder_set_angle(flight->rudder, flight_control_decide(data));
+}
@@ -0,0 +1,51 @@
+#ifndef FLIGHT_CONTROL_H_
+#define FLIGHT_CONTROL_H_
+
+#include <stdbool.h> // For bool type
+#include <stdint.h>  // For int8_t
+
+#include "command_dispatch.h" // For CommandSpec
+#include "fragment.h"         // For FragmentPool
+#include "rudder_control.h"   // For RudderConfig
+#include "sensor_module.h"    // For SensorData
+
+// --- Flight Control ---
+// The decisions flight_sim makes: what each command does, and how the rudder reacts
+// to a sensor sample. They live here rather than in main.c so the live simulation
+// and the replay harness (replay.h) run exactly the same code.
+
+// --- Control Law ---
+// Too fast: rudder to -FLIGHT_SPEED_CORRECTION_DEG; too slow: to +FLIGHT_SPEED_CORRECTION_DEG;
+// otherwise centred. (fleet.c runs the same rule over whole arrays.)
+#define FLIGHT_OVERSPEED_KMH 350
+#define FLIGHT_UNDERSPEED_KMH 250
+#define FLIGHT_SPEED_CORRECTION_DEG 10
+
+// State the command handlers and the control law act on
+typedef struct
+{
+    RudderConfig *rudder;
+    OperationalMode *op_mode;
+    FragmentPool *bulk; // Reassembles CMD_BULK_FRAGMENT transfers
+    bool verbose;       // Print what each command does (off for replay at full speed)
+} FlightContext;
+
+// Handlers of the flight commands, indexed by command type (see command_dispatch.h)
+extern const CommandSpec flight_commands[COMMAND_TABLE_SIZE];
+
+/**
+ * @brief The control law: the rudder angle the aircraft wants for a sensor sample.
+ * @param data The sample.
+ * @return Target rudder angle in degrees (before the rudder's limits are applied).
+ */
+int8_t flight_control_decide(const SensorData *data);
+
+/**
+ * @brief Applies the control law to the rudder.
+ * @param flight The aircraft; its rudder is set.
+ * @param data The sample.
+ * @return The rudder angle after the update.
+ */
+int8_t flight_control_update(FlightContext *flight, const SensorData *data);
+
+#endif // FLIGHT_CONTROL_H_
@@ -0,0 +1,312 @@
+#define _POSIX_C_SOURCE 200809L // For posix_fallocate and clock_gettime
+
+#include "flight_recorder.h"
+#include "crc.h"       // For crc32c
+#include <errno.h>     // For EINTR
+#include <fcntl.h>     // For open
+#include <string.h>    // For memcpy and memset
+#include <sys/mman.h>  // For mmap
+#include <sys/stat.h>  // For fstat
+#include <time.h>      // For clock_gettime
+#include <unistd.h>    // For close and ftruncate
+
+#define RECORDER_PAGE_SIZE 4096
+#define RECORD_BODY_OFFSET sizeof(atomic_uint_least64_t) // Everything after the tag
+#define RECORDER_MAX_CAPACITY (SIZE_MAX / 4 / sizeof(FlightRecord)) // Keeps file_size() from overflowing
+
+_Static_assert(sizeof(FlightRecorderHeader) <= RECORDER_PAGE_SIZE, "header must fit its page");
+
+// --- File Layout ---
+
+static size_t round_to_page(size_t size)
+{
+    return (size + RECORDER_PAGE_SIZE - 1) / RECORDER_PAGE_SIZE * RECORDER_PAGE_SIZE;
+}
+
+static size_t index_size(uint64_t capacity)
+{
+    return round_to_page((size_t)(capacity / FLIGHT_RECORDER_CHECKPOINT_INTERVAL) * sizeof(FlightCheckpoint));
+}
+
+static size_t file_size(uint64_t capacity)
+{
+    return RECORDER_PAGE_SIZE + index_size(capacity) + (size_t)capacity * sizeof(FlightRecord);
+}
+
+static bool header_valid(const FlightRecorderHeader *header, size_t size)
+{
+    return header->magic == FLIGHT_RECORDER_MAGIC && header->version == FLIGHT_RECORDER_VERSION &&
+           header->record_size == sizeof(FlightRecord) &&
+           header->checkpoint_interval == FLIGHT_RECORDER_CHECKPOINT_INTERVAL && header->capacity > 0 &&
+           header->capacity % FLIGHT_RECORDER_CHECKPOINT_INTERVAL == 0 &&
+           header->capacity <= RECORDER_MAX_CAPACITY &&
+           file_size(header->capacity) <= size;
+}
+
+// Maps the whole file and points the handle at its three parts
+static bool map_file(FlightRecorder *recorder, size_t size, bool writable)
+{
+    void *map = mmap(NULL, size, writable ? PROT_READ | PROT_WRITE : PROT_READ, MAP_SHARED, recorder->fd, 0);
+    if (map == MAP_FAILED)
+        return false;
+    recorder->map = (uint8_t *)map;
+    recorder->map_size = size;
+    recorder->writable = writable;
+    recorder->header = (FlightRecorderHeader *)map;
+    return true;
+}
+
+static void locate_sections(FlightRecorder *recorder)
+{
+    uint64_t capacity = recorder->header->capacity;
+    recorder->checkpoints = (FlightCheckpoint *)(recorder->map + RECORDER_PAGE_SIZE);
+    recorder->records = (FlightRecord *)(recorder->map + RECORDER_PAGE_SIZE + index_size(capacity));
+}
+
+static void unmap_and_close(FlightRecorder *recorder)
+{
+    if (recorder->map)
+        munmap(recorder->map, recorder->map_size);
+    if (recorder->fd >= 0)
+        close(recorder->fd);
+    recorder->map = NULL;
+    recorder->fd = -1;
+}
+
+// --- Opening and Closing ---
+
+bool flight_recorder_create(FlightRecorder *recorder, const char *path, uint64_t capacity)
+{
+    if (!recorder || !path || capacity == 0)
+        return false;
+    memset(recorder, 0, sizeof(*recorder));
+    capacity = (capacity + FLIGHT_RECORDER_CHECKPOINT_INTERVAL - 1) / FLIGHT_RECORDER_CHECKPOINT_INTERVAL *
+               FLIGHT_RECORDER_CHECKPOINT_INTERVAL;
+    if (capacity > RECORDER_MAX_CAPACITY)
+        return false;
+    size_t size = file_size(capacity);
+
+    recorder->fd = open(path, O_RDWR | O_CREAT, 0644);
+    if (recorder->fd < 0)
+        return false;
+
+    // Keep an existing recorder of the same capacity: its records are the history
+    struct stat st;
+    if (fstat(recorder->fd, &st) == 0 && (size_t)st.st_size == size && map_file(recorder, size, true))
+    {
+        if (header_valid(recorder->header, size) && recorder->header->capacity == capacity)
+        {
+            locate_sections(recorder);
+            return true;
+        }
+        munmap(recorder->map, size);
+        recorder->map = NULL;
+    }
+
+    // Start a new one. Allocating every block now means an append can never fail
+    // for lack of disk space (a write to an unallocated page of a full disk would
+    // kill the program with SIGBUS).
+    if (ftruncate(recorder->fd, 0) != 0)
+    {
+        unmap_and_close(recorder);
+        return false;
+    }
+    int result;
+    do
+    {
+        result = posix_fallocate(recorder->fd, 0, (off_t)size);
+    } while (result == EINTR);
+    if ((result != 0 && ftruncate(recorder->fd, (off_t)size) != 0) || !map_file(recorder, size, true))
+    {
+        unmap_and_close(recorder);
+        return false;
+    }
+
+    FlightRecorderHeader *header = recorder->header;
+    header->version = FLIGHT_RECORDER_VERSION;
+    header->record_size = sizeof(FlightRecord);
+    header->checkpoint_interval = FLIGHT_RECORDER_CHECKPOINT_INTERVAL;
+    header->capacity = capacity;
+    atomic_store_explicit(&header->next_sequence, 0, memory_order_relaxed);
+    atomic_thread_fence(memory_order_release);
+    header->magic = FLIGHT_RECORDER_MAGIC; // Last: a file without it is not a recorder yet
+    locate_sections(recorder);
+    return true;
+}
+
+bool flight_recorder_open(FlightRecorder *recorder, const char *path)
+{
+    if (!recorder || !path)
+        return false;
+    memset(recorder, 0, sizeof(*recorder));
+    recorder->fd = open(path, O_RDONLY);
+    if (recorder->fd < 0)
+        return false;
+    struct stat st;
+    if (fstat(recorder->fd, &st) != 0 || (size_t)st.st_size < RECORDER_PAGE_SIZE ||
+        !map_file(recorder, (size_t)st.st_size, false) || !header_valid(recorder->header, (size_t)st.st_size))
+    {
+        unmap_and_close(recorder);
+        return false;
+    }
+    locate_sections(recorder);
+    return true;
+}
+
+void flight_recorder_close(FlightRecorder *recorder)
+{
+    if (recorder)
+        unmap_and_close(recorder);
+}
+
+uint64_t flight_recorder_now_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_REALTIME, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000u + (uint64_t)ts.tv_nsec;
+}
+
+bool flight_recorder_sync(FlightRecorder *recorder)
+{
+    return recorder && recorder->map && msync(recorder->map, recorder->map_size, MS_SYNC) == 0;
+}
+
+// --- Appending ---
+
+// CRC of everything after the tag, with the crc field zero. Mixing in the sequence
+// number rejects a slot that still holds an intact record from an earlier lap.
+static uint32_t record_crc(const FlightRecord *record, uint64_t sequence)
+{
+    FlightRecord copy;
+    memcpy(&copy, record, sizeof(copy));
+    copy.crc = 0;
+    return crc32c((const uint8_t *)&copy + RECORD_BODY_OFFSET, sizeof(copy) - RECORD_BODY_OFFSET) ^
+           (uint32_t)(sequence ^ (sequence >> 32));
+}
+
+// Claims the next slot and writes `record` (whose tag is ignored) into it
+static uint64_t append(FlightRecorder *recorder, FlightRecord *record)
+{
+    FlightRecorderHeader *header = recorder->header;
+    uint64_t sequence = atomic_fetch_add_explicit(&header->next_sequence, 1, memory_order_relaxed);
+    record->crc = record_crc(record, sequence);
+
+    // Clear the tag before touching the body, publish it again after: a reader that
+    // sees the same tag before and after copying has a consistent record
+    FlightRecord *slot = &recorder->records[sequence % header->capacity];
+    atomic_store_explicit(&slot->tag, 0, memory_order_relaxed);
+    atomic_thread_fence(memory_order_release);
+    memcpy((uint8_t *)slot + RECORD_BODY_OFFSET, (const uint8_t *)record + RECORD_BODY_OFFSET,
+           sizeof(*record) - RECORD_BODY_OFFSET);
+    atomic_store_explicit(&slot->tag, sequence + 1, memory_order_release);
+
+    if (sequence % FLIGHT_RECORDER_CHECKPOINT_INTERVAL == 0)
+    {
+        uint64_t index = sequence / FLIGHT_RECORDER_CHECKPOINT_INTERVAL;
+        FlightCheckpoint *checkpoint =
+            &recorder->checkpoints[index % (header->capacity / FLIGHT_RECORDER_CHECKPOINT_INTERVAL)];
+        atomic_store_explicit(&checkpoint->tag, 0, memory_order_relaxed);
+        atomic_thread_fence(memory_order_release);
+        checkpoint->timestamp_ns = record->timestamp_ns;
+        atomic_store_explicit(&checkpoint->tag, sequence + 1, memory_order_release);
+    }
+    return sequence;
+}
+
+uint64_t flight_recorder_log_sensor(FlightRecorder *recorder, uint64_t timestamp_ns, uint8_t source,
+                                    const SensorData *data)
+{
+    FlightRecord record;
+    memset(&record, 0, sizeof(record));
+    record.timestamp_ns = timestamp_ns;
+    record.kind = FLIGHT_RECORD_SENSOR;
+    record.source = source;
+    record.length = sizeof(SensorData);
+    record.data.sensor = *data;
+    return append(recorder, &record);
+}
+
+uint64_t flight_recorder_log_packet(FlightRecorder *recorder, uint64_t timestamp_ns, const PacketView *packet)
+{
+    FlightRecord record;
+    memset(&record, 0, sizeof(record));
+    record.timestamp_ns = timestamp_ns;
+    record.kind = FLIGHT_RECORD_COMMAND;
+    record.length = (uint16_t)packet->size;
+    memcpy(record.data.bytes, packet->wire,
+           packet->size < FLIGHT_RECORD_DATA_SIZE ? packet->size : FLIGHT_RECORD_DATA_SIZE);
+    return append(recorder, &record);
+}
+
+// --- Reading ---
+
+void flight_recorder_bounds(const FlightRecorder *recorder, uint64_t *oldest, uint64_t *next)
+{
+    uint64_t head = atomic_load_explicit(&recorder->header->next_sequence, memory_order_acquire);
+    uint64_t capacity = recorder->header->capacity;
+    *oldest = head > capacity ? head - capacity : 0;
+    *next = head;
+}
+
+bool flight_recorder_read(const FlightRecorder *recorder, uint64_t sequence, FlightRecord *out)
+{
+    uint64_t oldest, next;
+    flight_recorder_bounds(recorder, &oldest, &next);
+    if (sequence < oldest || sequence >= next)
+        return false;
+    FlightRecord *slot = &recorder->records[sequence % recorder->header->capacity];
+    uint64_t before = atomic_load_explicit(&slot->tag, memory_order_acquire);
+    memcpy(out, slot, sizeof(*out));
+    atomic_thread_fence(memory_order_acquire);
+    uint64_t after = atomic_load_explicit(&slot->tag, memory_order_relaxed);
+    return before == sequence + 1 && after == before && out->crc == record_crc(out, sequence);
+}
+
+// Timestamp of checkpoint `index` (the record index * interval), if it is intact
+static bool read_checkpoint(const FlightRecorder *recorder, uint64_t index, uint64_t *timestamp_ns)
+{
+    uint64_t count = recorder->header->capacity / FLIGHT_RECORDER_CHECKPOINT_INTERVAL;
+    FlightCheckpoint *checkpoint = &recorder->checkpoints[index % count];
+    uint64_t expected = index * FLIGHT_RECORDER_CHECKPOINT_INTERVAL + 1;
+    uint64_t before = atomic_load_explicit(&checkpoint->tag, memory_order_acquire);
+    *timestamp_ns = checkpoint->timestamp_ns;
+    atomic_thread_fence(memory_order_acquire);
+    return before == expected && atomic_load_explicit(&checkpoint->tag, memory_order_relaxed) == expected;
+}
+
+uint64_t flight_recorder_seek(const FlightRecorder *recorder, uint64_t timestamp_ns)
+{
+    uint64_t oldest, next;
+    flight_recorder_bounds(recorder, &oldest, &next);
+    if (next == oldest)
+        return next;
+
+    // Last checkpoint strictly before the time. A checkpoint that cannot be read
+    // counts as "not before", which can only move the start earlier: slower, never wrong.
+    uint64_t low = (oldest + FLIGHT_RECORDER_CHECKPOINT_INTERVAL - 1) / FLIGHT_RECORDER_CHECKPOINT_INTERVAL;
+    uint64_t high = (next - 1) / FLIGHT_RECORDER_CHECKPOINT_INTERVAL + 1; // Exclusive
+    uint64_t start = oldest;
+    while (low < high)
+    {
+        uint64_t middle = low + (high - low) / 2;
+        uint64_t checkpoint_ns;
+        if (read_checkpoint(recorder, middle, &checkpoint_ns) && checkpoint_ns < timestamp_ns)
+        {
+            start = middle * FLIGHT_RECORDER_CHECKPOINT_INTERVAL;
+            low = middle + 1;
+        }
+        else
+        {
+            high = middle;
+        }
+    }
+
+    // Then at most one interval of records (more only past damaged checkpoints)
+    FlightRecord record;
+    for (uint64_t sequence = start; sequence < next; ++sequence)
+    {
+        if (flight_recorder_read(recorder, sequence, &record) && record.timestamp_ns >= timestamp_ns)
+            return sequence;
+    }
+    return next;
+}
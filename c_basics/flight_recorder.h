@@ -0,0 +1,178 @@
+#ifndef FLIGHT_RECORDER_H_
+#define FLIGHT_RECORDER_H_
+
+#include <stdatomic.h> // For the commit tags and the write position
+#include <stdbool.h>   // For bool type
+#include <stddef.h>    // For size_t
+#include <stdint.h>    // For fixed-width integers
+
+#include "command_protocol.h" // For PacketView
+#include "sensor_module.h"    // For SensorData
+
+// --- Flight Recorder ---
+// Keeps the recent history of a flight (sensor samples and received commands) in a
+// file mapped into memory, so it is still there after the program exits or crashes.
+// The file is allocated in full when it is created and used as a ring of fixed-size
+// records: once it is full, each new record overwrites the oldest one.
+//
+//   header (4 KiB) | checkpoint index | records[capacity]
+//
+// Appending a record is wait-free: one atomic fetch-and-add claims the next sequence
+// number, whose slot is then written in place. Nothing loops or takes a lock, so
+// any number of threads can append at once. Every record carries a commit tag and a
+// CRC-32C (which also covers its sequence number). A record caught half-written by a
+// crash, or overwritten while it was being read, fails the check and is skipped.
+//
+// Every FLIGHT_RECORDER_CHECKPOINT_INTERVAL-th record also writes its timestamp
+// into the checkpoint index. Seeking to a time binary-searches the index, then reads
+// at most one interval of records: O(log N) for N records.
+//
+// Timestamps are supplied by the caller (see flight_recorder_now_ns) and seeking
+// assumes they do not decrease from one record to the next. Records are stored in
+// host byte order; read the file on the same kind of machine that wrote it.
+
+// --- Constants ---
+#define FLIGHT_RECORDER_MAGIC 0x52434C46u // "FLCR"
+#define FLIGHT_RECORDER_VERSION 1
+#define FLIGHT_RECORDER_CHECKPOINT_INTERVAL 64 // Records per checkpoint
+#define FLIGHT_RECORD_DATA_SIZE 40             // Record payload bytes; longer packets are truncated
+
+typedef enum
+{
+    FLIGHT_RECORD_SENSOR = 1,  // A SensorData sample
+    FLIGHT_RECORD_COMMAND = 2, // A received packet, as wire bytes
+} FlightRecordKind;
+
+// One 64-byte record (a cache line)
+typedef struct
+{
+    atomic_uint_least64_t tag; // Sequence number + 1 once written; 0 while empty or being written
+    uint64_t timestamp_ns;
+    uint8_t kind;              // FlightRecordKind
+    uint8_t source;            // Sensor: sampler index. Command: 0
+    uint16_t length;           // Command: the packet's full wire size (see FLIGHT_RECORD_DATA_SIZE)
+    uint32_t crc;              // CRC-32C of the record, with this field zero, mixed with the sequence number
+    union
+    {
+        SensorData sensor;
+        uint8_t bytes[FLIGHT_RECORD_DATA_SIZE];
+    } data;
+} FlightRecord;
+
+_Static_assert(sizeof(FlightRecord) == 64, "FlightRecord must fill one cache line");
+
+typedef struct
+{
+    atomic_uint_least64_t tag; // Sequence number of the record + 1 once written
+    uint64_t timestamp_ns;
+} FlightCheckpoint;
+
+// First page of the file
+typedef struct
+{
+    uint32_t magic;
+    uint32_t version;
+    uint32_t record_size;         // sizeof(FlightRecord)
+    uint32_t checkpoint_interval; // FLIGHT_RECORDER_CHECKPOINT_INTERVAL
+    uint64_t capacity;            // Records in the ring, a multiple of checkpoint_interval
+    _Alignas(64) atomic_uint_least64_t next_sequence; // Sequence number of the next record
+} FlightRecorderHeader;
+
+// --- FlightRecorder Structure ---
+// One process's handle on a recorder file.
+typedef struct
+{
+    int fd;
+    bool writable;
+    size_t map_size;
+    uint8_t *map;
+    FlightRecorderHeader *header;
+    FlightCheckpoint *checkpoints; // capacity / checkpoint_interval entries
+    FlightRecord *records;
+} FlightRecorder;
+
+// --- Function Declarations ---
+
+/**
+ * @brief Opens a recorder file for appending, creating and preallocating it if needed.
+ *        An existing file of the same capacity keeps its records and appending
+ *        continues after them; any other file at that path is replaced.
+ * @param recorder Handle to fill in.
+ * @param path File name.
+ * @param capacity Records to keep; rounded up to a multiple of FLIGHT_RECORDER_CHECKPOINT_INTERVAL.
+ * @return True if successful, false if the file could not be created or mapped.
+ */
+bool flight_recorder_create(FlightRecorder *recorder, const char *path, uint64_t capacity);
+
+/**
+ * @brief Opens an existing recorder file read-only, e.g. for a postmortem. It may
+ *        still be written by another process; records appended later become visible.
+ * @return True if successful, false if the file is missing or not a recorder file.
+ */
+bool flight_recorder_open(FlightRecorder *recorder, const char *path);
+
+/**
+ * @brief Unmaps and closes the file. The records stay in it.
+ */
+void flight_recorder_close(FlightRecorder *recorder);
+
+/**
+ * @brief Current CLOCK_REALTIME time in nanoseconds: wall-clock time, which still
+ *        means something when the file is read after a restart.
+ */
+uint64_t flight_recorder_now_ns(void);
+
+/**
+ * @brief Appends a sensor sample. Wait-free; safe to call from several threads.
+ * @param recorder A recorder opened with flight_recorder_create.
+ * @param timestamp_ns When the sample was taken.
+ * @param source Sampler index.
+ * @param data The sample.
+ * @return The record's sequence number.
+ */
+uint64_t flight_recorder_log_sensor(FlightRecorder *recorder, uint64_t timestamp_ns, uint8_t source,
+                                    const SensorData *data);
+
+/**
+ * @brief Appends a received packet (its first FLIGHT_RECORD_DATA_SIZE wire bytes).
+ *        Wait-free; safe to call from several threads.
+ * @param recorder A recorder opened with flight_recorder_create.
+ * @param timestamp_ns When the packet arrived.
+ * @param packet A validated packet.
+ * @return The record's sequence number.
+ */
+uint64_t flight_recorder_log_packet(FlightRecorder *recorder, uint64_t timestamp_ns, const PacketView *packet);
+
+/**
+ * @brief Writes the mapped file to disk and waits for it. Records survive a crash of
+ *        the program without this (the kernel holds them); this also covers a crash
+ *        of the machine or a power cut.
+ * @return True if successful.
+ */
+bool flight_recorder_sync(FlightRecorder *recorder);
+
+/**
+ * @brief Sequence numbers still held: [*oldest, *next). Records in that range may
+ *        still be missing if they were being written when the writer stopped.
+ */
+void flight_recorder_bounds(const FlightRecorder *recorder, uint64_t *oldest, uint64_t *next);
+
+/**
+ * @brief Copies one record out and checks it.
+ * @param recorder An open recorder.
+ * @param sequence The record's sequence number.
+ * @param out Receives the record.
+ * @return True if the record is held, complete and intact.
+ */
+bool flight_recorder_read(const FlightRecorder *recorder, uint64_t sequence, FlightRecord *out);
+
+/**
+ * @brief Finds the first record at or after a time, in O(log N).
+ * @param recorder An open recorder.
+ * @param timestamp_ns The time to look for.
+ * @return Sequence number of the first intact record with a timestamp >= timestamp_ns,
+ *         or the next sequence number (see flight_recorder_bounds) if there is none.
+ */
+uint64_t flight_recorder_seek(const FlightRecorder *recorder, uint64_t timestamp_ns);
+
+#endif // FLIGHT_RECORDER_H_
@@ -0,0 +1,173 @@
+#include "fragment.h"
+#include <string.h> // For memcpy and memset
+
+_Static_assert(FRAGMENT_MAX_COUNT * FRAGMENT_MAX_DATA >= FRAGMENT_MAX_TRANSFER_SIZE,
+               "FRAGMENT_MAX_COUNT fragments must be able to carry a full transfer");
+_Static_assert(FRAGMENT_MAX_TRANSFER_SIZE <= UINT16_MAX, "total_length is a 16-bit field");
+
+static uint16_t read_u16(const uint8_t *in)
+{
+    return (uint16_t)(in[0] | in[1] << 8);
+}
+
+static void write_u16(uint8_t *out, uint16_t value)
+{
+    out[0] = (uint8_t)value;
+    out[1] = (uint8_t)(value >> 8);
+}
+
+// Data bytes carried by fragment `index`
+static size_t fragment_data_length(uint16_t index, uint16_t count, uint16_t total_length, uint16_t stride)
+{
+    return index + 1u < count ? stride : total_length - (size_t)(count - 1u) * stride;
+}
+
+// Finds the slot of a transfer in progress, or claims one for a new transfer
+static FragmentSlot *find_slot(FragmentPool *pool, uint8_t transfer_id, uint8_t command_type,
+                               uint16_t count, uint16_t total_length)
+{
+    FragmentSlot *free_slot = NULL;
+    FragmentSlot *oldest = &pool->slots[0];
+    for (size_t i = 0; i < FRAGMENT_POOL_SLOTS; ++i)
+    {
+        FragmentSlot *slot = &pool->slots[i];
+        if (!slot->in_use)
+        {
+            if (!free_slot)
+                free_slot = slot;
+            continue;
+        }
+        if (slot->transfer_id == transfer_id)
+        {
+            if (slot->command_type == command_type && slot->count == count && slot->total_length == total_length)
+                return slot;
+            slot->in_use = false; // The sender reused the id: the old transfer is gone
+            pool->stats.evicted++;
+            if (!free_slot)
+                free_slot = slot;
+            continue;
+        }
+        if (slot->last_used < oldest->last_used)
+            oldest = slot;
+    }
+    if (!free_slot)
+    {
+        free_slot = oldest;
+        pool->stats.evicted++;
+    }
+
+    free_slot->in_use = true;
+    free_slot->transfer_id = transfer_id;
+    free_slot->command_type = command_type;
+    free_slot->count = count;
+    free_slot->total_length = total_length;
+    free_slot->stride = (uint16_t)((total_length + count - 1u) / count);
+    free_slot->received_count = 0;
+    free_slot->received = 0;
+    return free_slot;
+}
+
+// --- Public Functions ---
+
+bool fragment_pool_init(FragmentPool *pool, TransferHandler handler, void *user_data)
+{
+    if (!pool || !handler)
+        return false;
+    memset(pool, 0, sizeof(FragmentPool));
+    pool->handler = handler;
+    pool->user_data = user_data;
+    return true;
+}
+
+bool fragment_pool_accept(FragmentPool *pool, const PacketView *packet)
+{
+    if (!pool || !packet)
+        return false;
+    uint16_t payload_length = packet_view_payload_length(packet);
+    if (packet_view_type(packet) != CMD_BULK_FRAGMENT || payload_length <= FRAGMENT_HEADER_SIZE)
+    {
+        pool->stats.malformed++;
+        return false;
+    }
+
+    const uint8_t *payload = packet_view_payload(packet);
+    uint8_t transfer_id = payload[0];
+    uint8_t command_type = payload[1];
+    uint16_t index = read_u16(&payload[2]);
+    uint16_t count = read_u16(&payload[4]);
+    uint16_t total_length = read_u16(&payload[6]);
+    size_t data_length = payload_length - FRAGMENT_HEADER_SIZE;
+
+    // The header must describe a transfer fragment_encode could have produced
+    if (count == 0 || count > FRAGMENT_MAX_COUNT || index >= count || total_length == 0 ||
+        total_length > FRAGMENT_MAX_TRANSFER_SIZE)
+    {
+        pool->stats.malformed++;
+        return false;
+    }
+    uint16_t stride = (uint16_t)((total_length + count - 1u) / count);
+    if (stride > FRAGMENT_MAX_DATA || (size_t)(count - 1u) * stride >= total_length ||
+        data_length != fragment_data_length(index, count, total_length, stride))
+    {
+        pool->stats.malformed++;
+        return false;
+    }
+
+    FragmentSlot *slot = find_slot(pool, transfer_id, command_type, count, total_length);
+    slot->last_used = ++pool->clock;
+    uint64_t bit = (uint64_t)1 << index;
+    if (slot->received & bit)
+    {
+        pool->stats.duplicates++;
+        return true;
+    }
+    memcpy(&slot->data[(size_t)index * stride], &payload[FRAGMENT_HEADER_SIZE], data_length);
+    slot->received |= bit;
+    slot->received_count++;
+    pool->stats.fragments_received++;
+
+    if (slot->received_count == slot->count)
+    {
+        slot->in_use = false; // Free before the call: the handler may start a new transfer
+        pool->stats.transfers_completed++;
+        pool->handler(slot->command_type, slot->data, slot->total_length, pool->user_data);
+    }
+    return true;
+}
+
+size_t fragment_count_for(size_t length)
+{
+    if (length == 0 || length > FRAGMENT_MAX_TRANSFER_SIZE)
+        return 0;
+    return (length + FRAGMENT_MAX_DATA - 1) / FRAGMENT_MAX_DATA;
+}
+
+size_t fragment_encode(uint8_t *out, size_t out_size, uint8_t transfer_id, CommandType type,
+                       const uint8_t *data, size_t length, IntegrityMode mode)
+{
+    size_t count = fragment_count_for(length);
+    if (!out || !data || count == 0)
+        return 0;
+    // Spread the data evenly: the receiver derives the same stride from length and count
+    uint16_t stride = (uint16_t)((length + count - 1) / count);
+
+    uint8_t payload[PACKET_EXT_MAX_PAYLOAD_SIZE];
+    payload[0] = transfer_id;
+    payload[1] = (uint8_t)type;
+    write_u16(&payload[4], (uint16_t)count);
+    write_u16(&payload[6], (uint16_t)length);
+
+    size_t written = 0;
+    for (uint16_t index = 0; index < count; ++index)
+    {
+        size_t data_length = fragment_data_length(index, (uint16_t)count, (uint16_t)length, stride);
+        write_u16(&payload[2], index);
+        memcpy(&payload[FRAGMENT_HEADER_SIZE], data + (size_t)index * stride, data_length);
+        size_t size = command_build_ext_packet(out + written, out_size - written, CMD_BULK_FRAGMENT, payload,
+                                               (uint16_t)(FRAGMENT_HEADER_SIZE + data_length), mode);
+        if (size == 0)
+            return 0;
+        written += size;
+    }
+    return written;
+}
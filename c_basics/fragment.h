@@ -0,0 +1,108 @@
+#ifndef FRAGMENT_H_
+#define FRAGMENT_H_
+
+#include <stdbool.h> // For bool type
+#include <stddef.h>  // For size_t
+#include <stdint.h>  // For fixed-width integers
+
+#include "command_protocol.h" // For PacketView, extended frames and CMD_BULK_FRAGMENT
+
+// --- Fragment Format ---
+// A transfer larger than one extended frame is split into CMD_BULK_FRAGMENT packets.
+// Each fragment's payload is an 8-byte header followed by its share of the data:
+//   transfer_id (1), command_type of the transfer (1), fragment index (2),
+//   fragment count (2), total transfer length (2); multi-byte fields little-endian.
+// Every fragment except the last carries exactly ceil(total / count) data bytes, so
+// a receiver can place each fragment as it arrives, in any order. Fragments are
+// sent as extended frames; with full 1016-byte fragments and CRC-32C about 98% of
+// the wire bytes are data, against at most 80% for 16-byte short packets.
+#define FRAGMENT_HEADER_SIZE 8
+#define FRAGMENT_MAX_DATA (PACKET_EXT_MAX_PAYLOAD_SIZE - FRAGMENT_HEADER_SIZE) // Data bytes per fragment
+#define FRAGMENT_MAX_COUNT 64           // Fragments per transfer (one bit each in a slot's bitmap)
+#define FRAGMENT_MAX_TRANSFER_SIZE 16384 // Largest transfer a reassembly slot holds
+#define FRAGMENT_POOL_SLOTS 4           // Transfers that can be in progress at once
+
+// --- Reassembly Callback ---
+// Called once per complete transfer. `data` points into the pool's slot and is only
+// valid for the duration of the call.
+typedef void (*TransferHandler)(uint8_t command_type, const uint8_t *data, size_t length, void *user_data);
+
+typedef struct
+{
+    uint64_t fragments_received;  // Well-formed fragments accepted
+    uint64_t transfers_completed; // Transfers delivered to the handler
+    uint64_t duplicates;          // Fragments that had already arrived
+    uint64_t malformed;           // Fragments with inconsistent headers or lengths
+    uint64_t evicted;             // Incomplete transfers dropped to make room for new ones
+} FragmentStats;
+
+// One transfer being reassembled
+typedef struct
+{
+    bool in_use;
+    uint8_t transfer_id;
+    uint8_t command_type;
+    uint16_t count;         // Fragments in the transfer
+    uint16_t total_length;  // Bytes in the transfer
+    uint16_t stride;        // Data bytes per fragment (except the last)
+    uint16_t received_count;
+    uint64_t received;      // Bit i set: fragment i has arrived
+    uint64_t last_used;     // Pool clock at the last fragment, for eviction
+    uint8_t data[FRAGMENT_MAX_TRANSFER_SIZE];
+} FragmentSlot;
+
+// --- FragmentPool Structure ---
+// All reassembly memory is inside the pool, so receiving never allocates. A pool is
+// about 64 KiB: give it static storage rather than putting it on the stack. When a
+// new transfer starts and every slot is busy, the least recently active incomplete
+// transfer is dropped.
+typedef struct
+{
+    TransferHandler handler;
+    void *user_data;
+    FragmentStats stats;
+    uint64_t clock; // Counts accepted fragments; orders slot activity
+    FragmentSlot slots[FRAGMENT_POOL_SLOTS];
+} FragmentPool;
+
+// --- Function Declarations ---
+
+/**
+ * @brief Initializes a pool with all slots free and zeroed statistics.
+ * @param pool Pointer to the pool to initialize.
+ * @param handler Function called for each complete transfer.
+ * @param user_data Passed through to the handler unchanged (may be NULL).
+ * @return True if successful, false if pool or handler is NULL.
+ */
+bool fragment_pool_init(FragmentPool *pool, TransferHandler handler, void *user_data);
+
+/**
+ * @brief Stores one received fragment and delivers its transfer once it is complete.
+ *        Suitable as (part of) the CMD_BULK_FRAGMENT handler in a dispatch table.
+ * @param pool Pointer to an initialized pool.
+ * @param packet A validated CMD_BULK_FRAGMENT packet.
+ * @return False if the fragment is malformed, true otherwise (duplicates included).
+ */
+bool fragment_pool_accept(FragmentPool *pool, const PacketView *packet);
+
+/**
+ * @brief Number of fragments fragment_encode uses for a transfer of `length` bytes.
+ * @return The count, or 0 if length is 0 or over FRAGMENT_MAX_TRANSFER_SIZE.
+ */
+size_t fragment_count_for(size_t length);
+
+/**
+ * @brief Splits a transfer into CMD_BULK_FRAGMENT extended frames, written back to back.
+ * @param out Output buffer; fragment_count_for(length) * PACKET_EXT_MAX_WIRE_SIZE bytes always suffice.
+ * @param out_size Size of the output buffer.
+ * @param transfer_id Tells concurrent transfers apart; reuse it only once a transfer is done.
+ * @param type Command type of the whole transfer, passed to the receiver's TransferHandler.
+ * @param data The bytes to send.
+ * @param length Number of bytes, 1 to FRAGMENT_MAX_TRANSFER_SIZE.
+ * @param mode Integrity code for each fragment.
+ * @return The number of bytes written, or 0 if the arguments are invalid or the buffer too small.
+ */
+size_t fragment_encode(uint8_t *out, size_t out_size, uint8_t transfer_id, CommandType type,
+                       const uint8_t *data, size_t length, IntegrityMode mode);
+
+#endif // FRAGMENT_H_
@@ -0,0 +1,165 @@
+// Benchmark for bulk transfers over the command link.
+//
+// Usage: fragment_bench [megabytes]
+//
+// Sends the same data two ways through the stream decoder and dispatcher: as
+// 16-byte short packets, and as 16 KiB transfers split into extended-frame
+// fragments and reassembled in a FragmentPool. Reports the share of wire bytes
+// that are payload and the payload throughput of the receive side. A final pass
+// delivers every transfer's fragments in reverse order with one duplicate each and
+// checks that all transfers still arrive intact.
+
+#define _POSIX_C_SOURCE 200809L // For clock_gettime
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "command_dispatch.h"
+#include "fragment.h"
+#include "packet_stream.h"
+
+static double now_seconds(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+#define TRANSFER_SIZE FRAGMENT_MAX_TRANSFER_SIZE
+#define CHUNK_SIZE 4096 // Bytes handed to the decoder per call
+
+typedef struct
+{
+    FragmentPool *pool;
+    uint64_t payload_bytes; // Delivered to the application
+    uint64_t mismatches;    // Transfers that differ from what was sent
+    const uint8_t *expected;
+} Receiver;
+
+static bool on_chunk(const PacketView *packet, void *context)
+{
+    ((Receiver *)context)->payload_bytes += packet_view_payload_length(packet);
+    return true;
+}
+
+static bool on_fragment(const PacketView *packet, void *context)
+{
+    return fragment_pool_accept(((Receiver *)context)->pool, packet);
+}
+
+static void on_transfer(uint8_t command_type, const uint8_t *data, size_t length, void *user_data)
+{
+    Receiver *receiver = (Receiver *)user_data;
+    (void)command_type;
+    receiver->payload_bytes += length;
+    if (length != TRANSFER_SIZE || memcmp(data, receiver->expected, length) != 0)
+        receiver->mismatches++;
+}
+
+static const CommandSpec bulk_commands[COMMAND_TABLE_SIZE] = {
+    COMMAND_ENTRY(CMD_UPLOAD_WAYPOINTS, 1, MAX_PAYLOAD_SIZE, on_chunk),
+    COMMAND_ENTRY(CMD_BULK_FRAGMENT, FRAGMENT_HEADER_SIZE + 1, PACKET_EXT_MAX_PAYLOAD_SIZE, on_fragment),
+};
+
+static Receiver *current_receiver;
+
+static void on_packet(const PacketView *packet, void *user_data)
+{
+    (void)user_data;
+    command_dispatch(bulk_commands, packet, current_receiver, NULL);
+}
+
+static FragmentPool pool;
+static PacketStreamParser parser;
+
+// Decodes `length` bytes of link data in CHUNK_SIZE pieces, `repeats` times
+static double receive(const uint8_t *link, size_t length, int repeats, Receiver *receiver)
+{
+    current_receiver = receiver;
+    packet_stream_init(&parser, on_packet, NULL);
+    double start = now_seconds();
+    for (int r = 0; r < repeats; ++r)
+    {
+        for (size_t sent = 0; sent < length; sent += CHUNK_SIZE)
+            packet_stream_feed(&parser, link + sent, length - sent < CHUNK_SIZE ? length - sent : CHUNK_SIZE);
+    }
+    return now_seconds() - start;
+}
+
+static void report(const char *label, size_t wire_bytes, double seconds, const Receiver *receiver)
+{
+    printf("%-26s %6.1f%% payload  %8.1f MB/s payload  (%llu payload bytes, %llu mismatches)\n", label,
+           100.0 * TRANSFER_SIZE / (double)wire_bytes, (double)receiver->payload_bytes / seconds / 1e6,
+           (unsigned long long)receiver->payload_bytes, (unsigned long long)receiver->mismatches);
+}
+
+int main(int argc, char *argv[])
+{
+    size_t total = (argc > 1 ? strtoul(argv[1], NULL, 10) : 128) * 1000 * 1000;
+    int repeats = (int)(total / TRANSFER_SIZE);
+
+    static uint8_t data[TRANSFER_SIZE];
+    uint32_t state = 99;
+    for (size_t i = 0; i < sizeof(data); ++i)
+    {
+        state = state * 1103515245u + 12345u;
+        data[i] = (uint8_t)(state >> 24);
+    }
+
+    // --- Short packets, 16 payload bytes each ---
+    static uint8_t short_link[(TRANSFER_SIZE / MAX_PAYLOAD_SIZE) * PACKET_MAX_WIRE_SIZE];
+    const IntegrityMode modes[] = {INTEGRITY_XOR8, INTEGRITY_CRC32C};
+    for (size_t m = 0; m < 2; ++m)
+    {
+        size_t length = 0;
+        for (size_t offset = 0; offset < TRANSFER_SIZE; offset += MAX_PAYLOAD_SIZE)
+            length += command_build_packet(short_link + length, sizeof(short_link) - length, CMD_UPLOAD_WAYPOINTS,
+                                           data + offset, MAX_PAYLOAD_SIZE, modes[m]);
+        Receiver receiver = {&pool, 0, 0, data};
+        double seconds = receive(short_link, length, repeats, &receiver);
+        report(m == 0 ? "short packets, XOR" : "short packets, CRC-32C", length, seconds, &receiver);
+    }
+
+    // --- Fragmented transfers ---
+    static uint8_t fragment_link[FRAGMENT_MAX_COUNT * PACKET_EXT_MAX_WIRE_SIZE];
+    size_t fragment_length = fragment_encode(fragment_link, sizeof(fragment_link), 1, CMD_UPLOAD_WAYPOINTS, data,
+                                             sizeof(data), INTEGRITY_CRC32C);
+    {
+        Receiver receiver = {&pool, 0, 0, data};
+        fragment_pool_init(&pool, on_transfer, &receiver);
+        double seconds = receive(fragment_link, fragment_length, repeats, &receiver);
+        report("fragments, CRC-32C", fragment_length, seconds, &receiver);
+    }
+
+    // --- Out of order, with duplicates ---
+    // Reverse the frames and send the last fragment (the first one sent) twice.
+    size_t count = fragment_count_for(sizeof(data));
+    size_t frame_sizes[FRAGMENT_MAX_COUNT];
+    const uint8_t *frames[FRAGMENT_MAX_COUNT];
+    for (size_t i = 0, offset = 0; i < count; ++i)
+    {
+        frames[i] = fragment_link + offset;
+        frame_sizes[i] = command_frame_size(frames[i]);
+        offset += frame_sizes[i];
+    }
+    static uint8_t shuffled[(FRAGMENT_MAX_COUNT + 1) * PACKET_EXT_MAX_WIRE_SIZE];
+    size_t shuffled_length = 0;
+    memcpy(shuffled, frames[count - 1], frame_sizes[count - 1]);
+    shuffled_length += frame_sizes[count - 1];
+    for (size_t i = count; i-- > 0;)
+    {
+        memcpy(shuffled + shuffled_length, frames[i], frame_sizes[i]);
+        shuffled_length += frame_sizes[i];
+    }
+    {
+        Receiver receiver = {&pool, 0, 0, data};
+        fragment_pool_init(&pool, on_transfer, &receiver);
+        receive(shuffled, shuffled_length, 1000, &receiver);
+        printf("reversed + duplicate:      %llu transfers completed, %llu duplicates, %llu mismatches\n",
+               (unsigned long long)pool.stats.transfers_completed, (unsigned long long)pool.stats.duplicates,
+               (unsigned long long)receiver.mismatches);
+        return receiver.mismatches == 0 && pool.stats.transfers_completed == 1000 ? 0 : 1;
+    }
+}
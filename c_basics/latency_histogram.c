@@ -0,0 +1,71 @@
+#define _POSIX_C_SOURCE 200809L // For clock_gettime
+
+#include "latency_histogram.h"
+#include <string.h> // For memset
+#include <time.h>   // For clock_gettime
+
+uint64_t latency_now_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000u + (uint64_t)ts.tv_nsec;
+}
+
+void latency_histogram_reset(LatencyHistogram *histogram)
+{
+    if (histogram)
+        memset(histogram, 0, sizeof(LatencyHistogram));
+}
+
+void latency_histogram_record(LatencyHistogram *histogram, uint64_t ns)
+{
+    // floor(log2(ns)); 0 and 1 ns both land in bucket 0
+    unsigned bucket = 63u - (unsigned)__builtin_clzll(ns | 1);
+    if (bucket >= LATENCY_BUCKETS)
+        bucket = LATENCY_BUCKETS - 1;
+    histogram->buckets[bucket]++;
+    histogram->count++;
+    histogram->total_ns += ns;
+    if (ns > histogram->max_ns)
+        histogram->max_ns = ns;
+}
+
+void latency_histogram_merge(LatencyHistogram *target, const LatencyHistogram *source)
+{
+    for (int i = 0; i < LATENCY_BUCKETS; ++i)
+        target->buckets[i] += source->buckets[i];
+    target->count += source->count;
+    target->total_ns += source->total_ns;
+    if (source->max_ns > target->max_ns)
+        target->max_ns = source->max_ns;
+}
+
+uint64_t latency_histogram_percentile(const LatencyHistogram *histogram, double fraction)
+{
+    if (histogram->count == 0)
+        return 0;
+    uint64_t rank = (uint64_t)(fraction * (double)histogram->count);
+    if (rank >= histogram->count)
+        rank = histogram->count - 1;
+    uint64_t seen = 0;
+    for (int i = 0; i < LATENCY_BUCKETS; ++i)
+    {
+        seen += histogram->buckets[i];
+        if (seen > rank)
+        {
+            uint64_t upper = (i + 1 < 64) ? ((uint64_t)1 << (i + 1)) - 1 : UINT64_MAX;
+            return upper < histogram->max_ns ? upper : histogram->max_ns;
+        }
+    }
+    return histogram->max_ns;
+}
+
+void latency_histogram_print(const LatencyHistogram *histogram, const char *label, FILE *out)
+{
+    double mean = histogram->count ? (double)histogram->total_ns / (double)histogram->count : 0.0;
+    fprintf(out, "%-12s n=%-9llu mean %9.1f us  p50 %9.1f us  p99 %9.1f us  p99.9 %9.1f us  max %9.1f us\n",
+            label, (unsigned long long)histogram->count, mean / 1e3,
+            (double)latency_histogram_percentile(histogram, 0.5) / 1e3,
+            (double)latency_histogram_percentile(histogram, 0.99) / 1e3,
+            (double)latency_histogram_percentile(histogram, 0.999) / 1e3, (double)histogram->max_ns / 1e3);
+}
@@ -0,0 +1,65 @@
+#ifndef LATENCY_HISTOGRAM_H_
+#define LATENCY_HISTOGRAM_H_
+
+#include <stdint.h> // For fixed-width integers
+#include <stdio.h>  // For FILE
+
+// --- LatencyHistogram Structure ---
+// Counts durations in power-of-two buckets: bucket i holds [2^i, 2^(i+1)) ns, so
+// recording is a few instructions and the whole histogram is a fixed 300-odd bytes,
+// whatever the range (1 ns to 18 minutes). Percentiles are reported as the upper
+// edge of their bucket, i.e. accurate to within a factor of two, which is what
+// "did p99 go from microseconds to milliseconds" questions need.
+// A histogram has a single writer; read it once that thread is done, or accept that
+// a concurrent reader may see a count or two in flight.
+#define LATENCY_BUCKETS 40
+
+typedef struct
+{
+    uint64_t count;
+    uint64_t total_ns;
+    uint64_t max_ns;
+    uint64_t buckets[LATENCY_BUCKETS];
+} LatencyHistogram;
+
+// --- Function Declarations ---
+
+/**
+ * @brief Current CLOCK_MONOTONIC time in nanoseconds, the time base for all stamps.
+ */
+uint64_t latency_now_ns(void);
+
+/**
+ * @brief Empties a histogram.
+ */
+void latency_histogram_reset(LatencyHistogram *histogram);
+
+/**
+ * @brief Counts one duration.
+ * @param histogram Pointer to the histogram.
+ * @param ns The duration in nanoseconds.
+ */
+void latency_histogram_record(LatencyHistogram *histogram, uint64_t ns);
+
+/**
+ * @brief Adds every count in `source` to `target` (e.g. per-thread histograms into a total).
+ */
+void latency_histogram_merge(LatencyHistogram *target, const LatencyHistogram *source);
+
+/**
+ * @brief Duration below which a fraction of the recorded durations fall.
+ * @param histogram Pointer to the histogram.
+ * @param fraction 0.5 for the median, 0.99 for p99, etc.
+ * @return The upper edge of the bucket holding that percentile (never above the maximum), or 0 if empty.
+ */
+uint64_t latency_histogram_percentile(const LatencyHistogram *histogram, double fraction);
+
+/**
+ * @brief Prints a one-line summary: count, mean, p50, p99, p99.9 and maximum, in microseconds.
+ * @param histogram Pointer to the histogram.
+ * @param label Name printed at the start of the line.
+ * @param out Stream to print to.
+ */
+void latency_histogram_print(const LatencyHistogram *histogram, const char *label, FILE *out);
+
+#endif // LATENCY_HISTOGRAM_H_
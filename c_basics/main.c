@@ -1,37 +1,271 @@
+#include <fcntl.h>  // For open
 #include <stdio.h>  // For printf
-#include <string.h> // For memcmp
-// #include <unistd.h> // For sleep() - POSIX specific
+#include <stdlib.h> // For malloc
+#include <string.h> // For memcpy and strcmp
+#include <unistd.h> // For close
 
 #include "sensor_module.h"    // Our sensor module
 #include "rudder_control.h"   // Our rudder control module
 #include "command_protocol.h" // Our new command protocol module
+#include "byte_ring.h"        // Lock-free buffer between the link and the decoder
+#include "packet_stream.h"    // Streaming decoder for the command link
+#include "command_dispatch.h" // Table-driven command handlers
+#include "flight_control.h"   // Command handlers and the control law
+#include "fragment.h"         // Bulk transfers split into extended frames
+#include "telemetry.h"        // Threaded sensor sampling pipeline
+#include "sensor_codec.h"     // Compact encoding of sensor series
+#include "flight_recorder.h"  // History of samples and commands, kept after the run
+#include "replay.h"           // Replays traces through the flight code at full speed
+#include "fleet.h"            // Many aircraft at once, one array per field
+#include "rt_scheduler.h"     // Periodic tasks at fixed rates
 
-// Main loop delay (if sleep was used)
-// #define MAIN_LOOP_DELAY_S 1
-
-// Helper function to print a packet for debugging
-void print_packet_bytes(const CommandPacket *packet)
+// Helper function to print a packet for debugging. It prints the wire bytes
+// themselves; reinterpreting a CommandPacket's memory would depend on its layout.
+void print_packet_bytes(const uint8_t *bytes, size_t size)
 {
-    if (!packet)
+    if (!bytes)
         return;
     printf("Packet Bytes (Hex): ");
-    const uint8_t *ptr = (const uint8_t *)packet;
-    // Calculate total packet size based on its actual content
-    size_t packet_total_size = sizeof(packet->start_byte) +
-                               sizeof(packet->command_type) +
-                               sizeof(packet->payload_length) +
-                               packet->payload_length +
-                               sizeof(packet->checksum);
-    for (size_t i = 0; i < packet_total_size; ++i)
+    for (size_t i = 0; i < size; ++i)
     {
-        printf("%02X ", ptr[i]);
+        printf("%02X ", bytes[i]);
     }
     printf("\n");
 }
 
+// --- Bulk Transfers ---
+
+#define WAYPOINT_WIRE_SIZE 8 // int16 x, int16 y (m, relative to home), uint16 altitude (m), uint16 speed (km/h)
+#define WAYPOINT_COUNT 300   // 2400 bytes: three fragments
+
+static FragmentPool bulk_pool;          // ~64 KiB of reassembly memory, allocated once
+static PacketStreamParser bulk_parser; // Holds up to one extended frame; kept off the stack
+
+static uint16_t read_u16_le(const uint8_t *in)
+{
+    return (uint16_t)(in[0] | in[1] << 8);
+}
+
+// Called by the fragment pool once every fragment of a transfer has arrived
+static void on_transfer_complete(uint8_t command_type, const uint8_t *data, size_t length, void *user_data)
+{
+    (void)user_data;
+    if (command_type != CMD_UPLOAD_WAYPOINTS || length % WAYPOINT_WIRE_SIZE != 0)
+    {
+        printf("Ignoring a %zu-byte transfer of type %d.\n", length, command_type);
+        return;
+    }
+    size_t count = length / WAYPOINT_WIRE_SIZE;
+    const uint8_t *last = data + (count - 1) * WAYPOINT_WIRE_SIZE;
+    printf("Waypoint list received: %zu waypoints, last at (%d, %d) m, altitude %u m, %u km/h\n", count,
+           (int16_t)read_u16_le(&last[0]), (int16_t)read_u16_le(&last[2]), read_u16_le(&last[4]), read_u16_le(&last[6]));
+}
+
+// Receiving side of the simulated link
+typedef struct
+{
+    FlightContext *flight;
+    DispatchStats dispatch;
+    int received;
+    FlightRecorder *recorder; // Every packet received is recorded (NULL: not recording)
+} LinkReceiver;
+
+// Handler for the streaming decoder: called once per valid packet on the link
+static void on_streamed_packet(const PacketView *packet, void *user_data)
+{
+    LinkReceiver *receiver = (LinkReceiver *)user_data;
+    receiver->received++;
+    if (receiver->recorder)
+        flight_recorder_log_packet(receiver->recorder, flight_recorder_now_ns(), packet);
+    static const char *const integrity_names[] = {"XOR", "CRC-16", "CRC-32C"};
+    printf("  Stream packet #%d: type %d, %d payload byte(s), %s\n", receiver->received, packet_view_type(packet),
+           packet_view_payload_length(packet), integrity_names[packet_view_integrity(packet)]);
+    DispatchResult result = command_dispatch(flight_commands, packet, receiver->flight, &receiver->dispatch);
+    if (result != DISPATCH_OK)
+        printf("  Command rejected: %s\n", command_dispatch_result_name(result));
+}
+
+// --- Telemetry Readback ---
+
+#define TELEMETRY_FILE "telemetry.bin"
+
+#define READBACK_SOURCES 2 // Samplers whose series are compressed; one encoder each
+
+typedef struct
+{
+    uint64_t packets;
+    uint64_t samples;
+    uint64_t errors;           // Samples flagged SENSOR_STATUS_ERROR
+    uint64_t compressed_bytes; // Sensor codec blocks written for the samples
+    uint64_t compressed_samples;
+    uint64_t codec_errors;     // Blocks that did not decode back to their samples
+} TelemetryReadback;
+
+// Samples interleave both sources, which compress badly together: split them per source
+static SensorEncoder readback_encoders[READBACK_SOURCES];
+
+// Writes out one encoder's block and checks that it decodes to as many samples
+static void flush_readback_block(TelemetryReadback *readback, SensorEncoder *encoder)
+{
+    static uint8_t block[SENSOR_CODEC_MAX_BLOCK_SIZE];
+    static TelemetrySample decoded[SENSOR_CODEC_MAX_SAMPLES];
+    size_t count = sensor_encoder_count(encoder);
+    if (count == 0)
+        return;
+    size_t size = sensor_encoder_finish(encoder, block, sizeof(block));
+    readback->compressed_bytes += size;
+    readback->compressed_samples += count;
+    if (sensor_codec_decode(block, size, decoded, SENSOR_CODEC_MAX_SAMPLES) != count)
+        readback->codec_errors++;
+}
+
+static void on_telemetry_packet(const PacketView *packet, void *user_data)
+{
+    TelemetryReadback *readback = (TelemetryReadback *)user_data;
+    TelemetrySample samples[TELEMETRY_MAX_BATCH_SAMPLES];
+    size_t count = telemetry_decode_batch(packet, samples, TELEMETRY_MAX_BATCH_SAMPLES);
+    readback->packets++;
+    readback->samples += count;
+    for (size_t i = 0; i < count; ++i)
+    {
+        readback->errors += (samples[i].data.status_flags & SENSOR_STATUS_ERROR) != 0;
+        if (samples[i].source >= READBACK_SOURCES)
+            continue;
+        SensorEncoder *encoder = &readback_encoders[samples[i].source];
+        if (!sensor_encoder_append(encoder, &samples[i]))
+        {
+            flush_readback_block(readback, encoder);
+            sensor_encoder_append(encoder, &samples[i]);
+        }
+    }
+}
+
+static TelemetryPipeline telemetry; // Queues for the pipeline (~180 KiB), allocated once
+
+// --- Flight Recorder ---
+// Read it with recorder_dump after the run, or after a crash
+#define FLIGHT_RECORDER_FILE "flight.rec"
+#define FLIGHT_RECORDER_CAPACITY 65536 // Records kept (4 MiB); older ones are overwritten
+
+static FlightRecorder recorder;
+
+// --- Replay Mode ---
+// flight_sim --replay [FILE] replays a flight recorder file, or without FILE a
+// synthetic trace, through the command and rudder code instead of simulating.
+#define REPLAY_SYNTHETIC_RECORDS 1000000
+#define REPLAY_SEED 1
+
+#define FLEET_TEST_AIRCRAFT 1000
+
+// --- Real-Time Control Loop ---
+// The simulation loop at fixed rates: sensors sampled at 1 kHz, the command link
+// drained at 100 Hz and the control law applied to the rudder at 10 Hz.
+#define RT_SENSOR_HZ 1000
+#define RT_COMMAND_HZ 100
+#define RT_RUDDER_HZ 10
+#define RT_LOOP_DURATION_MS 500
+#define RT_GROUND_STATION_EVERY 25 // Command runs between packets from the ground station (4 Hz)
+
+typedef struct
+{
+    FlightContext flight;      // Quiet: nothing is printed at these rates
+    FlightRecorder *recorder;  // Samples and packets are recorded (NULL: not recording)
+    SensorRng rng;
+    SensorData latest;         // Most recent sample; the rudder task acts on it
+    uint8_t link_storage[256];
+    ByteRing link;             // Bytes from the simulated ground station
+    PacketStreamParser parser;
+    DispatchStats dispatch;
+    uint32_t command_runs;
+    uint32_t rudder_moves;
+} RealtimeLoop;
+
+static RealtimeLoop realtime; // Holds a stream parser (~1 KiB), kept off the stack
+
+static void on_realtime_packet(const PacketView *packet, void *user_data)
+{
+    RealtimeLoop *loop = (RealtimeLoop *)user_data;
+    if (loop->recorder)
+        flight_recorder_log_packet(loop->recorder, flight_recorder_now_ns(), packet);
+    command_dispatch(flight_commands, packet, &loop->flight, &loop->dispatch);
+}
+
+static void realtime_sample(void *context)
+{
+    RealtimeLoop *loop = (RealtimeLoop *)context;
+    loop->latest = sensor_read_data_from(&loop->rng);
+    if (loop->recorder)
+        flight_recorder_log_sensor(loop->recorder, flight_recorder_now_ns(), 0, &loop->latest);
+}
+
+static void realtime_commands(void *context)
+{
+    RealtimeLoop *loop = (RealtimeLoop *)context;
+    if (loop->command_runs++ % RT_GROUND_STATION_EVERY == 0)
+    {
+        uint8_t request[PACKET_MAX_WIRE_SIZE];
+        size_t length = command_build_request_sensor_data(request, sizeof(request), INTEGRITY_CRC32C);
+        byte_ring_write(&loop->link, request, length);
+    }
+    packet_stream_drain(&loop->parser, &loop->link);
+}
+
+static void realtime_rudder(void *context)
+{
+    RealtimeLoop *loop = (RealtimeLoop *)context;
+    if (*loop->flight.op_mode != MODE_ACTIVE_FLIGHT)
+        return;
+    int8_t before = loop->flight.rudder->current_angle_deg;
+    if (flight_control_update(&loop->flight, &loop->latest) != before)
+        loop->rudder_moves++;
+}
+
+static int run_replay(const char *path)
+{
+    sensor_init_seeded(REPLAY_SEED);
+    rudder_init(0);
+
+    FlightRecord *trace;
+    size_t count;
+    if (path)
+    {
+        count = replay_load_recording(path, &trace);
+        if (count == 0)
+        {
+            fprintf(stderr, "Error: Could not read any records from %s.\n", path);
+            return 1;
+        }
+        printf("Replaying %zu records from %s\n", count, path);
+    }
+    else
+    {
+        count = REPLAY_SYNTHETIC_RECORDS;
+        trace = malloc(count * sizeof(FlightRecord));
+        if (!trace)
+        {
+            fprintf(stderr, "Error: Out of memory.\n");
+            return 1;
+        }
+        replay_synthesize(trace, count, REPLAY_SEED);
+        printf("Replaying a synthetic trace of %zu records (seed %d)\n", count, REPLAY_SEED);
+    }
+
+    RudderConfig rudder = {0};
+    OperationalMode op_mode = MODE_STANDBY;
+    FlightContext flight = {&rudder, &op_mode, NULL, false};
+    ReplayStats stats;
+    replay_run(trace, count, &flight, true, &stats);
+    replay_print_stats(&stats, stdout);
+    free(trace);
+    return 0;
+}
+
 // --- Main Application Logic ---
-int main(void)
+int main(int argc, char *argv[])
 {
+    if (argc > 1 && strcmp(argv[1], "--replay") == 0)
+        return run_replay(argc > 2 ? argv[2] : NULL);
+
     printf("--- Flight System Simulation Starting ---\n");
 
     // Initialize modules
@@ -43,6 +277,13 @@ int main(void)
     // For now, rudder_init directly sets up its internal static global_rudder_config.
     rudder_init(0); // Start rudder at 0 degrees
 
+    uint64_t run_start_ns = flight_recorder_now_ns();
+    FlightRecorder *flight_log = NULL;
+    if (flight_recorder_create(&recorder, FLIGHT_RECORDER_FILE, FLIGHT_RECORDER_CAPACITY))
+        flight_log = &recorder;
+    else
+        printf("Warning: Could not open %s; this run will not be recorded.\n", FLIGHT_RECORDER_FILE);
+
     // Get a pointer to the global rudder config to pass to functions
     // This demonstrates how main might interact with a module's state if necessary,
     // although ideally, interaction is purely through the module's API.
@@ -105,42 +346,32 @@ int main(void)
 
     OperationalMode current_op_mode = MODE_STANDBY;
     printf("System starting in MODE_STANDBY.\n");
+    fragment_pool_init(&bulk_pool, on_transfer_complete, NULL);
+    FlightContext flight = {&controlled_rudder, &current_op_mode, &bulk_pool, true};
 
     // --- Simulate receiving and processing commands ---
     printf("\n--- Command Processing Test ---\n");
 
+    // The builders write each packet straight into a byte buffer, exactly as it goes on
+    // the wire. On the receiving side a PacketView validates the bytes where they are
+    // and reads the fields from there: nothing is copied into a struct. The packet is
+    // then handed to the handler registered for its type in flight_commands.
+
     // 1. Create a "Set Rudder Angle" command
-    CommandPacket rudder_cmd_packet;
+    uint8_t rudder_cmd_bytes[PACKET_MAX_WIRE_SIZE];
     int8_t desired_angle = 25;
-    if (command_create_set_rudder(&rudder_cmd_packet, desired_angle))
+    size_t rudder_cmd_size = command_build_set_rudder(rudder_cmd_bytes, sizeof(rudder_cmd_bytes), desired_angle, INTEGRITY_XOR8);
+    if (rudder_cmd_size > 0)
     {
         printf("Created CMD_SET_RUDDER_ANGLE packet for angle %d.\n", desired_angle);
-        print_packet_bytes(&rudder_cmd_packet);
-
-        // Simulate receiving this packet (as a raw buffer)
-        // In reality, this buffer would come from UART, SPI, CAN, etc.
-        uint8_t raw_buffer[sizeof(CommandPacket)]; // Max possible size
-        size_t actual_packet_size = sizeof(rudder_cmd_packet.start_byte) +
-                                    sizeof(rudder_cmd_packet.command_type) +
-                                    sizeof(rudder_cmd_packet.payload_length) +
-                                    rudder_cmd_packet.payload_length +
-                                    sizeof(rudder_cmd_packet.checksum);
-        memcpy(raw_buffer, &rudder_cmd_packet, actual_packet_size);
-
-        CommandPacket parsed_rudder_cmd;
-        if (command_parse_packet(raw_buffer, actual_packet_size, &parsed_rudder_cmd))
+        print_packet_bytes(rudder_cmd_bytes, rudder_cmd_size);
+
+        // Simulate receiving this packet: in reality the bytes would come from UART, SPI, CAN, etc.
+        PacketView rudder_cmd;
+        if (packet_view_init(&rudder_cmd, rudder_cmd_bytes, rudder_cmd_size))
         {
             printf("Successfully parsed rudder command packet.\n");
-            if (parsed_rudder_cmd.command_type == CMD_SET_RUDDER_ANGLE)
-            {
-                int8_t extracted_angle;
-                if (command_get_rudder_angle_payload(&parsed_rudder_cmd, &extracted_angle))
-                {
-                    printf("Extracted angle from payload: %d\n", extracted_angle);
-                    rudder_set_angle(&controlled_rudder, extracted_angle);
-                    printf("Rudder - Set by command. Current Angle: %d degrees\n", rudder_get_current_angle(&controlled_rudder));
-                }
-            }
+            command_dispatch(flight_commands, &rudder_cmd, &flight, NULL);
         }
         else
         {
@@ -149,35 +380,19 @@ int main(void)
     }
 
     // 2. Create a "Set Operational Mode" command
-    CommandPacket op_mode_cmd_packet;
+    uint8_t op_mode_cmd_bytes[PACKET_MAX_WIRE_SIZE];
     OperationalMode target_mode = MODE_ACTIVE_FLIGHT;
-    if (command_create_set_op_mode(&op_mode_cmd_packet, target_mode))
+    size_t op_mode_cmd_size = command_build_set_op_mode(op_mode_cmd_bytes, sizeof(op_mode_cmd_bytes), target_mode, INTEGRITY_XOR8);
+    if (op_mode_cmd_size > 0)
     {
         printf("\nCreated CMD_SET_OPERATIONAL_MODE packet for mode %d.\n", target_mode);
-        print_packet_bytes(&op_mode_cmd_packet);
-
-        // Simulate receiving and parsing
-        uint8_t raw_op_mode_buffer[sizeof(CommandPacket)];
-        size_t actual_op_mode_packet_size = sizeof(op_mode_cmd_packet.start_byte) +
-                                            sizeof(op_mode_cmd_packet.command_type) +
-                                            sizeof(op_mode_cmd_packet.payload_length) +
-                                            op_mode_cmd_packet.payload_length +
-                                            sizeof(op_mode_cmd_packet.checksum);
-        memcpy(raw_op_mode_buffer, &op_mode_cmd_packet, actual_op_mode_packet_size);
-
-        CommandPacket parsed_op_mode_cmd;
-        if (command_parse_packet(raw_op_mode_buffer, actual_op_mode_packet_size, &parsed_op_mode_cmd))
+        print_packet_bytes(op_mode_cmd_bytes, op_mode_cmd_size);
+
+        PacketView op_mode_cmd;
+        if (packet_view_init(&op_mode_cmd, op_mode_cmd_bytes, op_mode_cmd_size))
         {
             printf("Successfully parsed op mode command.\n");
-            if (parsed_op_mode_cmd.command_type == CMD_SET_OPERATIONAL_MODE)
-            {
-                OperationalMode extracted_mode;
-                if (command_get_op_mode_payload(&parsed_op_mode_cmd, &extracted_mode))
-                {
-                    current_op_mode = extracted_mode;
-                    printf("System operational mode set to: %d\n", current_op_mode);
-                }
-            }
+            command_dispatch(flight_commands, &op_mode_cmd, &flight, NULL);
         }
         else
         {
@@ -186,36 +401,183 @@ int main(void)
     }
 
     // 3. Create a "Request Sensor Data" command
-    CommandPacket req_sensor_cmd_packet;
-    if (command_create_request_sensor_data(&req_sensor_cmd_packet))
+    uint8_t req_sensor_cmd_bytes[PACKET_MAX_WIRE_SIZE];
+    size_t req_sensor_cmd_size = command_build_request_sensor_data(req_sensor_cmd_bytes, sizeof(req_sensor_cmd_bytes), INTEGRITY_XOR8);
+    if (req_sensor_cmd_size > 0)
     {
         printf("\nCreated CMD_REQUEST_SENSOR_DATA packet.\n");
-        print_packet_bytes(&req_sensor_cmd_packet);
+        print_packet_bytes(req_sensor_cmd_bytes, req_sensor_cmd_size);
         // Simulate receiving, parsing, and then acting (e.g., sending sensor data back)
-        // For this demo, we'll just parse it.
-        uint8_t raw_req_sens_buffer[sizeof(CommandPacket)];
-        size_t actual_req_sens_packet_size = sizeof(req_sensor_cmd_packet.start_byte) +
-                                             sizeof(req_sensor_cmd_packet.command_type) +
-                                             sizeof(req_sensor_cmd_packet.payload_length) +
-                                             req_sensor_cmd_packet.payload_length +
-                                             sizeof(req_sensor_cmd_packet.checksum);
-        memcpy(raw_req_sens_buffer, &req_sensor_cmd_packet, actual_req_sens_packet_size);
-
-        CommandPacket parsed_req_sens_cmd;
-        if (command_parse_packet(raw_req_sens_buffer, actual_req_sens_packet_size, &parsed_req_sens_cmd))
+        PacketView req_sensor_cmd;
+        if (packet_view_init(&req_sensor_cmd, req_sensor_cmd_bytes, req_sensor_cmd_size))
+        {
+            command_dispatch(flight_commands, &req_sensor_cmd, &flight, NULL);
+        }
+        else
+        {
+            printf("Failed to parse request sensor data command.\n");
+        }
+    }
+
+    // --- Simulate a continuous link: partial, concatenated and corrupted frames ---
+    printf("\n--- Streaming Link Test ---\n");
+    {
+        uint8_t link_bytes[128];
+        size_t link_length = 0;
+        link_bytes[link_length++] = 0x13; // Line noise before the first frame
+        link_bytes[link_length++] = 0x37;
+        memcpy(link_bytes + link_length, rudder_cmd_bytes, rudder_cmd_size);
+        link_length += rudder_cmd_size;
+        memcpy(link_bytes + link_length, op_mode_cmd_bytes, op_mode_cmd_size);
+        link_bytes[link_length + 3] ^= 0x40; // Flip a payload bit: checksum error
+        link_length += op_mode_cmd_size;
+        memcpy(link_bytes + link_length, req_sensor_cmd_bytes, req_sensor_cmd_size);
+        link_length += req_sensor_cmd_size;
+
+        // The same commands protected by CRCs instead of the XOR checksum
+        link_length += command_build_set_rudder(link_bytes + link_length, sizeof(link_bytes) - link_length,
+                                                desired_angle, INTEGRITY_CRC32C);
+        link_length += command_build_set_op_mode(link_bytes + link_length, sizeof(link_bytes) - link_length,
+                                                 target_mode, INTEGRITY_CRC16);
+
+        // The receive side writes whatever arrived (here: 3 bytes at a time) into the ring,
+        // and the decoder drains it; frames straddle the chunk boundaries.
+        static uint8_t ring_storage[64];
+        ByteRing link_ring;
+        PacketStreamParser parser;
+        LinkReceiver receiver = {&flight, {{0}}, 0, flight_log};
+        byte_ring_init(&link_ring, ring_storage, sizeof(ring_storage));
+        packet_stream_init(&parser, on_streamed_packet, &receiver);
+        for (size_t sent = 0; sent < link_length;)
+        {
+            size_t chunk = link_length - sent < 3 ? link_length - sent : 3;
+            sent += byte_ring_write(&link_ring, link_bytes + sent, chunk);
+            packet_stream_drain(&parser, &link_ring);
+        }
+        printf("Link: %llu bytes, %llu packets ok, %llu checksum errors, %llu length errors, %llu bytes skipped\n",
+               (unsigned long long)parser.stats.bytes_received, (unsigned long long)parser.stats.packets_ok,
+               (unsigned long long)parser.stats.checksum_errors, (unsigned long long)parser.stats.length_errors,
+               (unsigned long long)parser.stats.bytes_skipped);
+        printf("Dispatch: %llu handled, %llu unknown, %llu bad length, %llu failed\n",
+               (unsigned long long)receiver.dispatch.results[DISPATCH_OK],
+               (unsigned long long)receiver.dispatch.results[DISPATCH_UNKNOWN_COMMAND],
+               (unsigned long long)receiver.dispatch.results[DISPATCH_BAD_LENGTH],
+               (unsigned long long)receiver.dispatch.results[DISPATCH_HANDLER_FAILED]);
+    }
+
+    // --- Upload a waypoint list too large for short packets ---
+    printf("\n--- Bulk Transfer Test ---\n");
+    {
+        uint8_t waypoints[WAYPOINT_COUNT * WAYPOINT_WIRE_SIZE];
+        for (size_t i = 0; i < WAYPOINT_COUNT; ++i)
         {
-            if (parsed_req_sens_cmd.command_type == CMD_REQUEST_SENSOR_DATA)
+            uint16_t fields[4] = {(uint16_t)(i * 40), (uint16_t)(-(int)i * 25), (uint16_t)(1000 + i), 300};
+            for (size_t f = 0; f < 4; ++f)
             {
-                printf("Received CMD_REQUEST_SENSOR_DATA. (Simulating sending data back...)\n");
-                SensorData s_data = sensor_read_data();
-                printf("  Sensor - Alt: %.2f m, Speed: %d km/h, Temp: %.1f C\n",
-                       s_data.altitude_m, s_data.airspeed_kmh, s_data.temperature_c);
-                sensor_process_status_flags(s_data.status_flags);
+                waypoints[i * WAYPOINT_WIRE_SIZE + 2 * f] = (uint8_t)fields[f];
+                waypoints[i * WAYPOINT_WIRE_SIZE + 2 * f + 1] = (uint8_t)(fields[f] >> 8);
             }
         }
+
+        // Fragments and an ordinary short command share the link
+        static uint8_t link_bytes[3 * PACKET_EXT_MAX_WIRE_SIZE + PACKET_MAX_WIRE_SIZE];
+        size_t link_length = fragment_encode(link_bytes, sizeof(link_bytes), 1, CMD_UPLOAD_WAYPOINTS,
+                                             waypoints, sizeof(waypoints), INTEGRITY_CRC32C);
+        size_t short_packets = (sizeof(waypoints) + MAX_PAYLOAD_SIZE - 1) / MAX_PAYLOAD_SIZE;
+        printf("%zu bytes in %zu fragments: %zu wire bytes (%.1f%% payload); as CRC-32C short packets: %zu wire bytes\n",
+               sizeof(waypoints), fragment_count_for(sizeof(waypoints)), link_length,
+               100.0 * (double)sizeof(waypoints) / (double)link_length,
+               short_packets * (PACKET_HEADER_SIZE + MAX_PAYLOAD_SIZE + 4));
+        link_length += command_build_set_rudder(link_bytes + link_length, sizeof(link_bytes) - link_length, 0, INTEGRITY_XOR8);
+
+        LinkReceiver receiver = {&flight, {{0}}, 0, flight_log};
+        packet_stream_init(&bulk_parser, on_streamed_packet, &receiver);
+        for (size_t sent = 0; sent < link_length; sent += 64) // 64-byte chunks, as from a UART FIFO
+            packet_stream_feed(&bulk_parser, link_bytes + sent, link_length - sent < 64 ? link_length - sent : 64);
+        printf("Fragments: %llu received, %llu transfers completed, %llu malformed\n",
+               (unsigned long long)bulk_pool.stats.fragments_received,
+               (unsigned long long)bulk_pool.stats.transfers_completed,
+               (unsigned long long)bulk_pool.stats.malformed);
+    }
+
+    // --- Sample sensors on background threads into a telemetry file ---
+    printf("\n--- Telemetry Pipeline Test ---\n");
+    {
+        int fd = open(TELEMETRY_FILE, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+        TelemetryConfig config = {
+            .sampler_count = 2,        // e.g. primary and backup air data computers
+            .sample_rate_hz = 1000,
+            .samples_per_sampler = 250, // A quarter of a second
+            .batch_samples = 25,
+            .max_batch_delay_us = 5000,
+            .integrity = INTEGRITY_CRC32C,
+            .sink_fd = fd,
+        };
+        TelemetryStats stats;
+        if (fd >= 0 && telemetry_start(&telemetry, &config))
+        {
+            telemetry_finish(&telemetry, &stats);
+            telemetry_print_stats(&stats, stdout);
+        }
         else
         {
-            printf("Failed to parse request sensor data command.\n");
+            printf("Failed to start the telemetry pipeline.\n");
+        }
+        if (fd >= 0)
+            close(fd);
+
+        // Read the file back through the ordinary stream decoder
+        TelemetryReadback readback = {0, 0, 0, 0, 0, 0};
+        for (int i = 0; i < READBACK_SOURCES; ++i)
+            sensor_encoder_reset(&readback_encoders[i]);
+        PacketStreamParser *parser = &bulk_parser;
+        packet_stream_init(parser, on_telemetry_packet, &readback);
+        FILE *file = fopen(TELEMETRY_FILE, "rb");
+        if (file)
+        {
+            uint8_t chunk[4096];
+            size_t length;
+            while ((length = fread(chunk, 1, sizeof(chunk), file)) > 0)
+                packet_stream_feed(parser, chunk, length);
+            fclose(file);
+        }
+        printf("Read back %s: %llu packets, %llu samples (%llu with SENSOR_STATUS_ERROR), %llu bad frames\n",
+               TELEMETRY_FILE, (unsigned long long)readback.packets, (unsigned long long)readback.samples,
+               (unsigned long long)readback.errors,
+               (unsigned long long)(parser->stats.checksum_errors + parser->stats.length_errors));
+
+        for (int i = 0; i < READBACK_SOURCES; ++i)
+            flush_readback_block(&readback, &readback_encoders[i]);
+        if (readback.compressed_samples > 0)
+            printf("Sensor codec: %llu samples in %llu bytes (%.1f bytes/sample vs %d on the wire), %llu bad blocks\n",
+                   (unsigned long long)readback.compressed_samples, (unsigned long long)readback.compressed_bytes,
+                   (double)readback.compressed_bytes / (double)readback.compressed_samples, TELEMETRY_SAMPLE_WIRE_SIZE,
+                   (unsigned long long)readback.codec_errors);
+    }
+
+    // --- Many aircraft: the same control law over a whole fleet ---
+    printf("\n--- Fleet Test ---\n");
+    {
+        Fleet fleet;
+        if (fleet_init(&fleet, FLEET_TEST_AIRCRAFT, 42))
+        {
+            for (int step = 0; step < 3; ++step)
+            {
+                // Gusts push a third of the fleet towards overspeed and a third towards stall
+                fleet_sample_range(&fleet, 0, fleet.count);
+                for (size_t i = 0; i < fleet.count; ++i)
+                    fleet.airspeed_kmh[i] += i % 3 == 0 ? 80 : i % 3 == 1 ? -80 : 0;
+                fleet_control_range(&fleet, 0, fleet.count);
+            }
+            size_t left = 0, right = 0;
+            for (size_t i = 0; i < fleet.count; ++i)
+            {
+                left += fleet.rudder_angle_deg[i] < 0;
+                right += fleet.rudder_angle_deg[i] > 0;
+            }
+            printf("%zu aircraft after 3 steps: %zu slowing down (rudder left), %zu speeding up (rudder right)\n",
+                   fleet.count, left, right);
+            fleet_free(&fleet);
         }
     }
 
@@ -228,22 +590,15 @@ int main(void)
         if (current_op_mode == MODE_ACTIVE_FLIGHT)
         {
             SensorData current_sensor_data = sensor_read_data();
+            if (flight_log)
+                flight_recorder_log_sensor(flight_log, flight_recorder_now_ns(), 0, &current_sensor_data);
             printf("Sensor - Altitude: %.2f m, Airspeed: %d km/h, Temp: %.1f C\n",
                    current_sensor_data.altitude_m,
                    current_sensor_data.airspeed_kmh,
                    current_sensor_data.temperature_c);
             sensor_process_status_flags(current_sensor_data.status_flags);
 
-            int8_t target_rudder_angle = 0;
-            if (current_sensor_data.airspeed_kmh > 350)
-            {
-                target_rudder_angle = -10;
-            }
-            else if (current_sensor_data.airspeed_kmh < 250)
-            {
-                target_rudder_angle = 10;
-            }
-            rudder_set_angle(&controlled_rudder, target_rudder_angle);
+            flight_control_update(&flight, &current_sensor_data);
             printf("Rudder - Current Angle: %d degrees\n", rudder_get_current_angle(&controlled_rudder));
 
             if (current_sensor_data.status_flags & SENSOR_STATUS_ERROR)
@@ -262,7 +617,42 @@ int main(void)
             printf("System in DIAGNOSTIC mode. Running self-tests (simulated)...\n");
             // Perform diagnostic routines
         }
-        // sleep(MAIN_LOOP_DELAY_S); // If using sleep
+    }
+
+    // --- The same loop at fixed rates ---
+    printf("\n--- Real-Time Control Loop ---\n");
+    {
+        RealtimeLoop *loop = &realtime;
+        loop->flight = flight;
+        loop->flight.verbose = false;
+        loop->recorder = flight_log;
+        sensor_rng_seed(&loop->rng, SENSOR_RNG_XOSHIRO256SS, run_start_ns);
+        loop->latest = sensor_read_data_from(&loop->rng);
+        byte_ring_init(&loop->link, loop->link_storage, sizeof(loop->link_storage));
+        packet_stream_init(&loop->parser, on_realtime_packet, loop);
+
+        RtScheduler scheduler;
+        rt_scheduler_init(&scheduler);
+        rt_scheduler_add(&scheduler, "sensors", RT_SENSOR_HZ, realtime_sample, loop);
+        rt_scheduler_add(&scheduler, "commands", RT_COMMAND_HZ, realtime_commands, loop);
+        rt_scheduler_add(&scheduler, "rudder", RT_RUDDER_HZ, realtime_rudder, loop);
+        rt_scheduler_run(&scheduler, (uint64_t)RT_LOOP_DURATION_MS * 1000000u);
+        rt_scheduler_print_stats(&scheduler, stdout);
+        printf("Link: %llu commands handled; rudder moved %u times, now at %d degrees\n",
+               (unsigned long long)loop->dispatch.results[DISPATCH_OK], loop->rudder_moves,
+               rudder_get_current_angle(&controlled_rudder));
+    }
+
+    if (flight_log)
+    {
+        uint64_t oldest, next;
+        flight_recorder_bounds(flight_log, &oldest, &next);
+        uint64_t first_of_run = flight_recorder_seek(flight_log, run_start_ns);
+        printf("\nFlight recorder: %llu records this run (#%llu to #%llu), %llu held in %s; read it with recorder_dump\n",
+               (unsigned long long)(next - first_of_run), (unsigned long long)first_of_run,
+               (unsigned long long)(next - 1), (unsigned long long)(next - oldest), FLIGHT_RECORDER_FILE);
+        flight_recorder_sync(flight_log);
+        flight_recorder_close(flight_log);
     }
 
     printf("\n--- Flight System Simulation Ended ---\n");
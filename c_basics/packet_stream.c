@@ -0,0 +1,179 @@
+#include "packet_stream.h"
+#include <string.h> // For memcpy and memset
+
+// --- Frame Checking ---
+
+typedef enum
+{
+    FRAME_INCOMPLETE, // Not enough bytes yet to decide
+    FRAME_DELIVERED,  // Valid; handed to the handler
+    FRAME_REJECTED,   // Invalid length or checksum; counted in the stats
+} FrameStatus;
+
+static bool is_start_byte(uint8_t byte)
+{
+    return byte == PACKET_START_BYTE || byte == PACKET_EXT_START_BYTE;
+}
+
+// Examines the frame that starts (with a start byte) at `frame`, of which
+// `available` bytes are present. On success the packet is delivered and its wire
+// size stored in *frame_size.
+static FrameStatus check_frame(PacketStreamParser *parser, const uint8_t *frame, size_t available, size_t *frame_size)
+{
+    if (available < command_header_size(frame[0]))
+        return FRAME_INCOMPLETE;
+
+    size_t size = command_frame_size(frame);
+    if (size == 0)
+    {
+        parser->stats.length_errors++;
+        return FRAME_REJECTED; // Known as soon as the header is in; no need to wait for the rest
+    }
+    if (available < size)
+        return FRAME_INCOMPLETE;
+
+    if (!command_frame_intact(frame, size))
+    {
+        parser->stats.checksum_errors++;
+        return FRAME_REJECTED;
+    }
+
+    PacketView view = {(const WirePacket *)frame, size}; // Points into the caller's bytes: no copy
+    parser->stats.packets_ok++;
+    parser->handler(&view, parser->user_data);
+    *frame_size = size;
+    return FRAME_DELIVERED;
+}
+
+// Decodes a contiguous block. This is the fast path: whole frames are checked
+// straight out of `data`. Only a frame cut off by the end of the block is copied,
+// into parser->partial. On a clean link every frame is followed directly by the next
+// start byte, so the byte-by-byte search below only runs through line noise.
+static size_t scan_block(PacketStreamParser *parser, const uint8_t *data, size_t length)
+{
+    size_t delivered = 0;
+    size_t i = 0;
+    while (i < length)
+    {
+        if (!is_start_byte(data[i]))
+        {
+            size_t start = i + 1;
+            while (start < length && !is_start_byte(data[start]))
+                start++;
+            parser->stats.bytes_skipped += start - i;
+            i = start;
+            if (i == length)
+                break;
+        }
+
+        size_t frame_size = 0;
+        FrameStatus status = check_frame(parser, data + i, length - i, &frame_size);
+        if (status == FRAME_DELIVERED)
+        {
+            i += frame_size;
+            delivered++;
+        }
+        else if (status == FRAME_REJECTED)
+        {
+            parser->stats.bytes_skipped++; // Resynchronize right after the bad start byte
+            i++;
+        }
+        else
+        {
+            parser->partial_length = length - i;
+            memcpy(parser->partial, data + i, parser->partial_length);
+            break;
+        }
+    }
+    return delivered;
+}
+
+// --- Public Functions ---
+
+bool packet_stream_init(PacketStreamParser *parser, PacketHandler handler, void *user_data)
+{
+    if (!parser || !handler)
+        return false;
+    memset(parser, 0, sizeof(PacketStreamParser));
+    parser->handler = handler;
+    parser->user_data = user_data;
+    return true;
+}
+
+size_t packet_stream_feed(PacketStreamParser *parser, const uint8_t *data, size_t length)
+{
+    if (!parser || (!data && length > 0))
+        return 0;
+
+    parser->stats.bytes_received += length;
+    size_t delivered = 0;
+
+    // Slow path: complete a frame left over from the previous chunk, taking only
+    // the bytes it still needs.
+    while (parser->partial_length > 0 && length > 0)
+    {
+        size_t header_size = command_header_size(parser->partial[0]);
+        size_t needed = parser->partial_length < header_size
+                            ? header_size
+                            : command_frame_size(parser->partial);
+        size_t take = needed - parser->partial_length;
+        if (take > length)
+            take = length;
+        memcpy(parser->partial + parser->partial_length, data, take);
+        parser->partial_length += take;
+        data += take;
+        length -= take;
+
+        size_t frame_size = 0;
+        FrameStatus status = check_frame(parser, parser->partial, parser->partial_length, &frame_size);
+        if (status == FRAME_DELIVERED)
+        {
+            parser->partial_length = 0;
+            delivered++;
+        }
+        else if (status == FRAME_REJECTED)
+        {
+            // The bytes after the bad start byte may hold the next frame's start;
+            // scan them again. That may leave a new partial frame behind.
+            uint8_t replay[PACKET_EXT_MAX_WIRE_SIZE];
+            size_t replay_length = parser->partial_length - 1;
+            memcpy(replay, parser->partial + 1, replay_length);
+            parser->partial_length = 0;
+            parser->stats.bytes_skipped++;
+            delivered += scan_block(parser, replay, replay_length);
+        }
+    }
+
+    if (length > 0)
+        delivered += scan_block(parser, data, length);
+    return delivered;
+}
+
+size_t packet_stream_drain(PacketStreamParser *parser, ByteRing *ring)
+{
+    if (!parser || !ring)
+        return 0;
+
+    // Only what is there now: a fast producer must not keep the consumer here forever.
+    size_t budget = byte_ring_size(ring);
+    size_t delivered = 0;
+    while (budget > 0)
+    {
+        const uint8_t *data = NULL;
+        size_t length = byte_ring_peek(ring, &data);
+        if (length == 0)
+            break;
+        if (length > budget)
+            length = budget;
+        delivered += packet_stream_feed(parser, data, length);
+        byte_ring_consume(ring, length);
+        budget -= length;
+    }
+    return delivered;
+}
+
+void packet_stream_reset(PacketStreamParser *parser)
+{
+    if (parser)
+        parser->partial_length = 0;
+}
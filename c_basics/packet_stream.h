@@ -0,0 +1,80 @@
+#ifndef PACKET_STREAM_H_
+#define PACKET_STREAM_H_
+
+#include <stdbool.h> // For bool type
+#include <stddef.h>  // For size_t
+#include <stdint.h>  // For fixed-width integers
+
+#include "byte_ring.h"        // For draining a ByteRing
+#include "command_protocol.h" // For PacketView and the start bytes
+
+// --- Callback Type ---
+// Called once for every complete packet whose length and checksum (or CRC) are valid.
+// The view points into the bytes that were fed (or into the ring being drained), so
+// nothing is copied; it is only valid for the duration of the call.
+typedef void (*PacketHandler)(const PacketView *packet, void *user_data);
+
+// --- Stream Statistics ---
+// Errors are counted here instead of printed, so a noisy link cannot flood the console
+// (or slow the decoder down to the speed of stderr).
+typedef struct
+{
+    uint64_t bytes_received;  // Every byte handed to the parser
+    uint64_t packets_ok;      // Packets delivered to the handler
+    uint64_t checksum_errors; // Frames dropped because the checksum or CRC did not match
+    uint64_t length_errors;   // Frames dropped for a payload length over the format's maximum or a reserved integrity mode
+    uint64_t bytes_skipped;   // Bytes discarded while searching for a start byte
+} PacketStreamStats;
+
+// --- PacketStreamParser Structure ---
+// A resumable decoder for a continuous byte stream. Bytes may arrive in chunks of any
+// size: a frame split across two chunks is kept in `partial` until the rest arrives,
+// and several frames in one chunk are all decoded. Short and extended frames may be
+// mixed freely. After a bad frame the parser resynchronizes on the next start byte
+// after the bad frame's start byte, so a start byte inside a corrupted frame's payload
+// is not missed.
+typedef struct
+{
+    PacketHandler handler;
+    void *user_data;
+    PacketStreamStats stats;
+    uint8_t partial[PACKET_EXT_MAX_WIRE_SIZE]; // Start of a frame that is not complete yet
+    size_t partial_length;                     // Bytes in `partial` (0 while searching)
+} PacketStreamParser;
+
+// --- Function Declarations ---
+
+/**
+ * @brief Initializes a parser with zeroed statistics and no partial frame.
+ * @param parser Pointer to the parser to initialize.
+ * @param handler Function called for each valid packet.
+ * @param user_data Passed through to the handler unchanged (may be NULL).
+ * @return True if successful, false if parser or handler is NULL.
+ */
+bool packet_stream_init(PacketStreamParser *parser, PacketHandler handler, void *user_data);
+
+/**
+ * @brief Decodes the next chunk of the byte stream.
+ * @param parser Pointer to an initialized parser.
+ * @param data The received bytes.
+ * @param length Number of received bytes.
+ * @return The number of packets delivered to the handler from this chunk.
+ */
+size_t packet_stream_feed(PacketStreamParser *parser, const uint8_t *data, size_t length);
+
+/**
+ * @brief Decodes everything currently in a ring buffer and releases it to the producer.
+ *        Call it from the ring's consumer thread.
+ * @param parser Pointer to an initialized parser.
+ * @param ring Ring filled by the receiving side.
+ * @return The number of packets delivered to the handler.
+ */
+size_t packet_stream_drain(PacketStreamParser *parser, ByteRing *ring);
+
+/**
+ * @brief Discards any partial frame, e.g. after the link was reset. Statistics are kept.
+ * @param parser Pointer to an initialized parser.
+ */
+void packet_stream_reset(PacketStreamParser *parser);
+
+#endif // PACKET_STREAM_H_
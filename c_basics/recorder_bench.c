@@ -0,0 +1,179 @@
+// Benchmark for the flight recorder.
+//
+// Usage: recorder_bench [records]
+//
+//   1. append cost from one thread and from four threads at once
+//   2. seek cost on a full (wrapped) ring of 16 Ki and of `records` records (default
+//      1 Mi, a 64 MiB file): O(log N) means the larger ring costs only a little more.
+//      Every seek is checked against the record it should find.
+//   3. crash survival: a child process appends until it is killed with SIGKILL, then
+//      the file is reopened and every record it holds is checked
+// The files are created in the current directory and removed afterwards.
+
+#define _POSIX_C_SOURCE 200809L // For clock_gettime and nanosleep
+
+#include <pthread.h>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <sys/wait.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "flight_recorder.h"
+
+#define BENCH_FILE "recorder_bench.rec"
+#define BASE_NS 1700000000000000000ull // Synthetic clock: record i is at BASE_NS + i us
+#define APPEND_THREADS 4
+
+static double now_seconds(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+static FlightRecorder recorder;
+
+typedef struct
+{
+    uint64_t count;
+    uint8_t source;
+} AppendJob;
+
+static void *append_thread(void *arg)
+{
+    AppendJob *job = (AppendJob *)arg;
+    SensorData data = {1000.0f, 300, 15.0f, SENSOR_STATUS_OK};
+    for (uint64_t i = 0; i < job->count; ++i)
+    {
+        data.airspeed_kmh = (int16_t)(300 + i % 50);
+        flight_recorder_log_sensor(&recorder, flight_recorder_now_ns(), job->source, &data);
+    }
+    return NULL;
+}
+
+static void bench_append(uint64_t records)
+{
+    printf("== Append ==\n");
+    if (!flight_recorder_create(&recorder, BENCH_FILE, records))
+    {
+        printf("Could not create %s\n", BENCH_FILE);
+        return;
+    }
+    for (unsigned threads = 1; threads <= APPEND_THREADS; threads += APPEND_THREADS - 1)
+    {
+        pthread_t ids[APPEND_THREADS];
+        AppendJob jobs[APPEND_THREADS];
+        double start = now_seconds();
+        for (unsigned t = 0; t < threads; ++t)
+        {
+            jobs[t].count = records / threads;
+            jobs[t].source = (uint8_t)t;
+            pthread_create(&ids[t], NULL, append_thread, &jobs[t]);
+        }
+        for (unsigned t = 0; t < threads; ++t)
+            pthread_join(ids[t], NULL);
+        double seconds = now_seconds() - start;
+        uint64_t appended = records / threads * threads;
+        printf("%u thread(s): %llu records in %.3f s, %.1f ns per record, %.1f M records/s\n", threads,
+               (unsigned long long)appended, seconds, seconds * 1e9 / (double)appended,
+               (double)appended / seconds / 1e6);
+    }
+    flight_recorder_close(&recorder);
+    remove(BENCH_FILE);
+}
+
+static void bench_seek(uint64_t capacity)
+{
+    if (!flight_recorder_create(&recorder, BENCH_FILE, capacity))
+    {
+        printf("Could not create %s\n", BENCH_FILE);
+        return;
+    }
+    capacity = recorder.header->capacity;
+    uint64_t total = capacity + capacity / 2; // Wrap once so the oldest half was overwritten
+    SensorData data = {1000.0f, 300, 15.0f, SENSOR_STATUS_OK};
+    for (uint64_t i = 0; i < total; ++i)
+        flight_recorder_log_sensor(&recorder, BASE_NS + i * 1000, 0, &data);
+
+    uint64_t oldest, next;
+    flight_recorder_bounds(&recorder, &oldest, &next);
+    const unsigned seeks = 200000;
+    unsigned wrong = 0;
+    uint64_t state = 88172645463325252ull; // xorshift64 for the seek targets
+    double start = now_seconds();
+    for (unsigned i = 0; i < seeks; ++i)
+    {
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        uint64_t target = oldest + state % (next - oldest);
+        uint64_t found = flight_recorder_seek(&recorder, BASE_NS + target * 1000 - 500); // Between two records
+        wrong += found != target;
+    }
+    double seconds = now_seconds() - start;
+    printf("%8llu records (%3llu MiB): %.0f ns per seek, %u wrong\n", (unsigned long long)capacity,
+           (unsigned long long)(capacity * sizeof(FlightRecord) >> 20), seconds * 1e9 / seeks, wrong);
+    flight_recorder_close(&recorder);
+    remove(BENCH_FILE);
+}
+
+static void bench_crash(void)
+{
+    printf("\n== Crash survival ==\n");
+    if (!flight_recorder_create(&recorder, BENCH_FILE, 1u << 16))
+    {
+        printf("Could not create %s\n", BENCH_FILE);
+        return;
+    }
+    pid_t child = fork();
+    if (child == 0)
+    {
+        SensorData data = {1000.0f, 300, 15.0f, SENSOR_STATUS_OK};
+        for (;;)
+            flight_recorder_log_sensor(&recorder, flight_recorder_now_ns(), 0, &data);
+    }
+    struct timespec run_for = {0, 200000000}; // 200 ms
+    nanosleep(&run_for, NULL);
+    kill(child, SIGKILL);
+    waitpid(child, NULL, 0);
+    flight_recorder_close(&recorder);
+
+    FlightRecorder reader;
+    if (!flight_recorder_open(&reader, BENCH_FILE))
+    {
+        printf("Could not reopen %s after the crash\n", BENCH_FILE);
+        return;
+    }
+    uint64_t oldest, next, intact = 0, out_of_order = 0, previous_ns = 0;
+    flight_recorder_bounds(&reader, &oldest, &next);
+    FlightRecord record;
+    for (uint64_t sequence = oldest; sequence < next; ++sequence)
+    {
+        if (!flight_recorder_read(&reader, sequence, &record))
+            continue;
+        intact++;
+        out_of_order += record.timestamp_ns < previous_ns;
+        previous_ns = record.timestamp_ns;
+    }
+    printf("Writer killed after %llu appends; %llu of the %llu records held are intact, %llu out of order\n",
+           (unsigned long long)next, (unsigned long long)intact, (unsigned long long)(next - oldest),
+           (unsigned long long)out_of_order);
+    flight_recorder_close(&reader);
+    remove(BENCH_FILE);
+}
+
+int main(int argc, char *argv[])
+{
+    uint64_t records = argc > 1 ? (uint64_t)atoll(argv[1]) : 1u << 20;
+    if (records < 1u << 14)
+        records = 1u << 14;
+
+    bench_append(records);
+    printf("\n== Seek (full ring) ==\n");
+    bench_seek(1u << 14);
+    bench_seek(records);
+    bench_crash();
+    return 0;
+}
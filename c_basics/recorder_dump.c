@@ -0,0 +1,136 @@
+// Reads a flight recorder file, e.g. after a crash.
+//
+// Usage: recorder_dump FILE [FROM [COUNT]]
+//
+// Prints the range of records the file holds, then COUNT records (default 20)
+// starting at the first one recorded at or after FROM. FROM is a Unix time in
+// seconds (as printed in the listing), or a negative number of seconds before the
+// newest record; without it the listing starts at the oldest record. A FROM outside
+// the recording is clamped to its first or last record.
+
+#define _POSIX_C_SOURCE 200809L // For localtime_r
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "flight_recorder.h"
+
+static void print_time(uint64_t timestamp_ns)
+{
+    time_t seconds = (time_t)(timestamp_ns / 1000000000u);
+    struct tm local;
+    char text[32] = "?";
+    if (localtime_r(&seconds, &local))
+        strftime(text, sizeof(text), "%Y-%m-%d %H:%M:%S", &local);
+    printf("%s.%06u (%llu.%06u)", text, (unsigned)(timestamp_ns % 1000000000u / 1000u),
+           (unsigned long long)seconds, (unsigned)(timestamp_ns % 1000000000u / 1000u));
+}
+
+static void print_record(uint64_t sequence, const FlightRecord *record)
+{
+    printf("#%-8llu ", (unsigned long long)sequence);
+    print_time(record->timestamp_ns);
+    if (record->kind == FLIGHT_RECORD_SENSOR)
+    {
+        const SensorData *data = &record->data.sensor;
+        printf("  SENSOR  src %u  alt %.2f m  airspeed %d km/h  temp %.1f C  flags 0x%02X\n", record->source,
+               data->altitude_m, data->airspeed_kmh, data->temperature_c, data->status_flags);
+    }
+    else if (record->kind == FLIGHT_RECORD_COMMAND)
+    {
+        size_t shown = record->length < FLIGHT_RECORD_DATA_SIZE ? record->length : FLIGHT_RECORD_DATA_SIZE;
+        printf("  COMMAND type %u  %u bytes:", shown > 1 ? record->data.bytes[1] : 0, record->length);
+        for (size_t i = 0; i < shown; ++i)
+            printf(" %02X", record->data.bytes[i]);
+        printf("%s\n", shown < record->length ? " ..." : "");
+    }
+    else
+    {
+        printf("  kind %u\n", record->kind);
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    if (argc < 2)
+    {
+        fprintf(stderr, "Usage: %s FILE [FROM [COUNT]]\n", argv[0]);
+        return 1;
+    }
+    FlightRecorder recorder;
+    if (!flight_recorder_open(&recorder, argv[1]))
+    {
+        fprintf(stderr, "Error: %s is not a readable flight recorder file.\n", argv[1]);
+        return 1;
+    }
+
+    uint64_t oldest, next;
+    flight_recorder_bounds(&recorder, &oldest, &next);
+    printf("%s: %llu records held (#%llu to #%llu), capacity %llu\n", argv[1], (unsigned long long)(next - oldest),
+           (unsigned long long)oldest, (unsigned long long)(next ? next - 1 : 0),
+           (unsigned long long)recorder.header->capacity);
+
+    // Timestamps of the first and last intact records, for the summary and for FROM < 0
+    FlightRecord record;
+    uint64_t first = oldest;
+    while (first < next && !flight_recorder_read(&recorder, first, &record))
+        first++;
+    uint64_t last = next;
+    FlightRecord newest;
+    while (last > first && !flight_recorder_read(&recorder, last - 1, &newest))
+        last--;
+    if (first == next || last == first)
+    {
+        printf("No intact records.\n");
+        flight_recorder_close(&recorder);
+        return 0;
+    }
+    printf("From ");
+    print_time(record.timestamp_ns);
+    printf(" to ");
+    print_time(newest.timestamp_ns);
+    printf("\n\n");
+
+    uint64_t start = first;
+    if (argc > 2)
+    {
+        // Clamped to the recording before converting: a FROM further back than the
+        // oldest record would wrap below zero, and one past the range of uint64_t
+        // is undefined behaviour in the cast
+        double from = atof(argv[2]);
+        uint64_t oldest_ns = record.timestamp_ns;
+        uint64_t from_ns;
+        if (from < 0)
+        {
+            double back_ns = -from * 1e9;
+            from_ns = back_ns >= (double)(newest.timestamp_ns - oldest_ns) ? oldest_ns
+                                                                           : newest.timestamp_ns - (uint64_t)back_ns;
+        }
+        else if (!(from * 1e9 > (double)oldest_ns)) // Also catches NaN
+            from_ns = oldest_ns;
+        else if (from * 1e9 >= (double)newest.timestamp_ns)
+            from_ns = newest.timestamp_ns;
+        else
+            from_ns = (uint64_t)(from * 1e9);
+        start = flight_recorder_seek(&recorder, from_ns);
+    }
+    long count = argc > 3 ? atol(argv[3]) : 20;
+
+    size_t skipped = 0;
+    for (uint64_t sequence = start; sequence < next && count > 0; ++sequence)
+    {
+        if (!flight_recorder_read(&recorder, sequence, &record))
+        {
+            skipped++;
+            continue;
+        }
+        print_record(sequence, &record);
+        count--;
+    }
+    if (skipped > 0)
+        printf("(%zu missing or damaged records skipped)\n", skipped);
+
+    flight_recorder_close(&recorder);
+    return 0;
+}
@@ -0,0 +1,204 @@
+#include "replay.h"
+#include "packet_stream.h" // For the stream decoder commands go through
+#include <stdlib.h>        // For malloc and free
+#include <string.h>        // For memset
+
+#define FNV_OFFSET 0xCBF29CE484222325ull
+#define FNV_PRIME 0x100000001B3ull
+
+// --- Synthetic Traces ---
+
+// SplitMix64: a small generator owned by the trace, so a seed means the same trace
+// whatever else in the program draws random numbers
+static uint64_t next_random(uint64_t *state)
+{
+    uint64_t z = (*state += 0x9E3779B97F4A7C15ull);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+    return z ^ (z >> 31);
+}
+
+// Uniform in [low, high]
+static int random_between(uint64_t *state, int low, int high)
+{
+    return low + (int)(next_random(state) % (uint64_t)(high - low + 1));
+}
+
+static void make_command(FlightRecord *record, uint64_t *state)
+{
+    static const IntegrityMode modes[] = {INTEGRITY_XOR8, INTEGRITY_CRC16, INTEGRITY_CRC32C};
+    IntegrityMode integrity = modes[random_between(state, 0, 2)];
+    int choice = random_between(state, 0, 99);
+    size_t size;
+    if (choice < 70)
+        size = command_build_set_rudder(record->data.bytes, sizeof(record->data.bytes),
+                                        (int8_t)random_between(state, RUDDER_MIN_ANGLE, RUDDER_MAX_ANGLE), integrity);
+    else
+        size = command_build_set_op_mode(record->data.bytes, sizeof(record->data.bytes),
+                                         random_between(state, 0, 3) ? MODE_ACTIVE_FLIGHT : MODE_STANDBY, integrity);
+    if (choice >= 95 && size > 0)
+        record->data.bytes[size - 1] ^= 0x5A; // A frame damaged on the link
+    record->kind = FLIGHT_RECORD_COMMAND;
+    record->length = (uint16_t)size;
+}
+
+void replay_synthesize(FlightRecord *out, size_t count, uint64_t seed)
+{
+    uint64_t state = seed;
+    uint64_t timestamp = 1700000000ull * 1000000000ull;
+    double airspeed = 300.0;
+    double altitude = 1000.0;
+    double temperature = 15.0;
+    for (size_t i = 0; i < count; ++i)
+    {
+        FlightRecord *record = &out[i];
+        memset(record, 0, sizeof(*record));
+        record->timestamp_ns = timestamp;
+        if (i == 0 || random_between(&state, 0, 99) == 0)
+        {
+            make_command(record, &state);
+            if (i == 0) // Take off: start in active flight
+                record->length = (uint16_t)command_build_set_op_mode(record->data.bytes, sizeof(record->data.bytes),
+                                                                     MODE_ACTIVE_FLIGHT, INTEGRITY_CRC16);
+            continue;
+        }
+        // Airspeed wanders, pulled back towards 300 km/h, and now and then past 250 or 350
+        airspeed += random_between(&state, -8, 8) + (300.0 - airspeed) / 500.0;
+        altitude += random_between(&state, -2, 3) * 0.25;
+        temperature += random_between(&state, -1, 1) * 0.05;
+        record->kind = FLIGHT_RECORD_SENSOR;
+        record->length = sizeof(SensorData);
+        record->data.sensor.airspeed_kmh = (int16_t)airspeed;
+        record->data.sensor.altitude_m = (float)altitude;
+        record->data.sensor.temperature_c = (float)temperature;
+        record->data.sensor.status_flags = random_between(&state, 0, 49) ? SENSOR_STATUS_OK
+                                                                         : SENSOR_STATUS_OK | SENSOR_STATUS_LOW_BATTERY;
+        timestamp += 1000000; // 1 kHz
+    }
+}
+
+// --- Recorded Traces ---
+
+size_t replay_load_recording(const char *path, FlightRecord **out)
+{
+    *out = NULL;
+    FlightRecorder recorder;
+    if (!flight_recorder_open(&recorder, path))
+        return 0;
+    uint64_t oldest, next;
+    flight_recorder_bounds(&recorder, &oldest, &next);
+    FlightRecord *records = next > oldest ? malloc((size_t)(next - oldest) * sizeof(FlightRecord)) : NULL;
+    size_t count = 0;
+    if (records)
+    {
+        for (uint64_t sequence = oldest; sequence < next; ++sequence)
+            count += flight_recorder_read(&recorder, sequence, &records[count]);
+    }
+    flight_recorder_close(&recorder);
+    if (count == 0)
+    {
+        free(records);
+        return 0;
+    }
+    *out = records;
+    return count;
+}
+
+// --- Replay ---
+
+typedef struct
+{
+    FlightContext *flight;
+    DispatchStats *dispatch;
+} ReplayLink;
+
+// Handler for the stream decoder: the same dispatch the live link uses
+static void on_replayed_packet(const PacketView *packet, void *user_data)
+{
+    ReplayLink *link = (ReplayLink *)user_data;
+    command_dispatch(flight_commands, packet, link->flight, link->dispatch);
+}
+
+static uint64_t fnv1a(uint64_t hash, uint8_t byte)
+{
+    return (hash ^ byte) * FNV_PRIME;
+}
+
+void replay_run(const FlightRecord *trace, size_t count, FlightContext *flight, bool time_events,
+                ReplayStats *stats)
+{
+    memset(stats, 0, sizeof(*stats));
+    latency_histogram_reset(&stats->decision);
+    latency_histogram_reset(&stats->command);
+    ReplayLink link = {flight, &stats->dispatch};
+    PacketStreamParser parser;
+    packet_stream_init(&parser, on_replayed_packet, &link);
+
+    uint64_t digest = FNV_OFFSET;
+    int8_t last_angle = rudder_get_current_angle(flight->rudder);
+    uint64_t start_ns = latency_now_ns();
+    for (size_t i = 0; i < count; ++i)
+    {
+        const FlightRecord *record = &trace[i];
+        uint64_t taken_ns = time_events ? latency_now_ns() : 0;
+        if (record->kind == FLIGHT_RECORD_SENSOR)
+        {
+            stats->samples++;
+            if (*flight->op_mode == MODE_ACTIVE_FLIGHT)
+                flight_control_update(flight, &record->data.sensor);
+            if (time_events)
+                latency_histogram_record(&stats->decision, latency_now_ns() - taken_ns);
+        }
+        else if (record->kind == FLIGHT_RECORD_COMMAND && record->length > 0 &&
+                 record->length <= FLIGHT_RECORD_DATA_SIZE)
+        {
+            stats->commands++;
+            packet_stream_feed(&parser, record->data.bytes, record->length);
+            if (time_events)
+                latency_histogram_record(&stats->command, latency_now_ns() - taken_ns);
+        }
+        else
+        {
+            stats->skipped++; // Packets longer than a record keep only their start
+        }
+
+        int8_t angle = rudder_get_current_angle(flight->rudder);
+        stats->rudder_changes += angle != last_angle;
+        last_angle = angle;
+        digest = fnv1a(fnv1a(digest, (uint8_t)angle), (uint8_t)*flight->op_mode);
+    }
+    stats->elapsed_ns = latency_now_ns() - start_ns;
+    stats->digest = digest;
+    stats->bad_frames = parser.stats.checksum_errors + parser.stats.length_errors;
+}
+
+static void print_latency(const LatencyHistogram *histogram, const char *label, FILE *out)
+{
+    if (histogram->count == 0)
+        return;
+    fprintf(out, "%-16s n=%-9llu mean %6.0f ns  p50 %6llu ns  p99 %6llu ns  p99.9 %6llu ns  max %8llu ns\n", label,
+            (unsigned long long)histogram->count, (double)histogram->total_ns / (double)histogram->count,
+            (unsigned long long)latency_histogram_percentile(histogram, 0.5),
+            (unsigned long long)latency_histogram_percentile(histogram, 0.99),
+            (unsigned long long)latency_histogram_percentile(histogram, 0.999), (unsigned long long)histogram->max_ns);
+}
+
+void replay_print_stats(const ReplayStats *stats, FILE *out)
+{
+    double seconds = (double)stats->elapsed_ns / 1e9;
+    uint64_t records = stats->samples + stats->commands + stats->skipped;
+    fprintf(out, "Replayed %llu records in %.3f s: %.2f M samples/s (%llu samples, %llu commands, %llu skipped)\n",
+            (unsigned long long)records, seconds, seconds > 0 ? (double)stats->samples / seconds / 1e6 : 0.0,
+            (unsigned long long)stats->samples, (unsigned long long)stats->commands,
+            (unsigned long long)stats->skipped);
+    fprintf(out, "Commands: %llu handled, %llu unknown, %llu bad length, %llu failed, %llu bad frames\n",
+            (unsigned long long)stats->dispatch.results[DISPATCH_OK],
+            (unsigned long long)stats->dispatch.results[DISPATCH_UNKNOWN_COMMAND],
+            (unsigned long long)stats->dispatch.results[DISPATCH_BAD_LENGTH],
+            (unsigned long long)stats->dispatch.results[DISPATCH_HANDLER_FAILED],
+            (unsigned long long)stats->bad_frames);
+    fprintf(out, "Rudder moved %llu times; decision digest %016llx\n", (unsigned long long)stats->rudder_changes,
+            (unsigned long long)stats->digest);
+    print_latency(&stats->decision, "sample->rudder", out);
+    print_latency(&stats->command, "packet->handled", out);
+}
@@ -0,0 +1,81 @@
+#ifndef REPLAY_H_
+#define REPLAY_H_
+
+#include <stdbool.h> // For bool type
+#include <stddef.h>  // For size_t
+#include <stdint.h>  // For fixed-width integers
+#include <stdio.h>   // For FILE
+
+#include "command_dispatch.h"  // For DispatchStats
+#include "flight_control.h"    // For FlightContext and the code being replayed
+#include "flight_recorder.h"   // For FlightRecord, the trace format
+#include "latency_histogram.h" // For decision latency
+
+// --- Replay Harness ---
+// Runs a trace of sensor samples and received packets through flight_sim's own
+// decision code as fast as it will go, with no sensors, link or clock involved:
+//   sensor record  -> flight_control_update (control law, rudder limits)
+//   command record -> stream decoder -> flight_commands dispatch table -> handler
+// A trace is an array of FlightRecord, either read from a flight recorder file or
+// generated from a seed, so the same input can be replayed any number of times.
+//
+// After every record the rudder angle and operational mode are folded into a
+// digest. The same trace must always produce the same digest: a changed digest
+// means a change in behaviour, a changed samples/s a change in speed.
+//
+// Replay is deterministic except for CMD_REQUEST_SENSOR_DATA, whose handler reads the
+// sensor simulator; seed it with sensor_init_seeded() for repeatable runs.
+
+typedef struct
+{
+    uint64_t samples;         // Sensor records replayed
+    uint64_t commands;        // Command records fed to the decoder
+    uint64_t skipped;         // Records that cannot be replayed (truncated packets, unknown kinds)
+    uint64_t bad_frames;      // Command records the decoder rejected
+    DispatchStats dispatch;   // Outcome of each decoded command
+    uint64_t rudder_changes;  // Records after which the rudder angle differed
+    uint64_t digest;          // FNV-1a of the rudder angle and mode after every record
+    uint64_t elapsed_ns;      // Wall time of the whole replay
+    LatencyHistogram decision; // Sensor record taken -> rudder set (timed runs only)
+    LatencyHistogram command;  // Command record taken -> handler returned (timed runs only)
+} ReplayStats;
+
+// --- Function Declarations ---
+
+/**
+ * @brief Generates a repeatable trace: a flight sampled at 1 kHz whose airspeed
+ *        wanders across the control law's thresholds, with a rudder or mode command
+ *        about every hundredth record.
+ * @param out Receives count records.
+ * @param count Number of records.
+ * @param seed Same seed, same trace.
+ */
+void replay_synthesize(FlightRecord *out, size_t count, uint64_t seed);
+
+/**
+ * @brief Reads every intact record of a flight recorder file, oldest first.
+ * @param path The recorder file.
+ * @param out Set to a malloc'd array of the records; free() it when done.
+ * @return The number of records, or 0 if the file could not be read (then *out is NULL).
+ */
+size_t replay_load_recording(const char *path, FlightRecord **out);
+
+/**
+ * @brief Replays a trace.
+ * @param trace The records.
+ * @param count Number of records.
+ * @param flight The aircraft to fly. Its rudder must be initialized (rudder_init), and
+ *               verbose is best left off: printing would dominate the timings.
+ * @param time_events Time every record into the latency histograms. This adds two clock
+ *                    reads per record, so leave it off to measure throughput.
+ * @param stats Filled with the results.
+ */
+void replay_run(const FlightRecord *trace, size_t count, FlightContext *flight, bool time_events,
+                ReplayStats *stats);
+
+/**
+ * @brief Prints the counters, samples per second, the digest and, for timed runs, the latencies in ns.
+ */
+void replay_print_stats(const ReplayStats *stats, FILE *out);
+
+#endif // REPLAY_H_
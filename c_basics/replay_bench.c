@@ -0,0 +1,84 @@
+// Regression benchmark: replays a synthetic trace through the flight code.
+//
+// Usage: replay_bench [records [expected digest]]
+//
+// Replays the same seeded trace (default 1,000,000 records) several times:
+//   - untimed runs for throughput (samples/s; the best of three is reported)
+//   - one run timing every record, for the sample->rudder decision latency and the
+//     packet->handled command latency
+// Every run must end with the same decision digest. If an expected digest (hex) is
+// given, it must match too: a different digest means the control law, the rudder
+// limits or the command handling now behave differently. Exits with status 1 on a
+// mismatch, so `make regression` fails.
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "replay.h"
+
+#define BENCH_SEED 1
+#define THROUGHPUT_RUNS 3
+
+static FlightRecord *trace;
+
+static void replay_once(size_t count, bool time_events, ReplayStats *stats)
+{
+    RudderConfig rudder = {0};
+    OperationalMode op_mode = MODE_STANDBY;
+    FlightContext flight = {&rudder, &op_mode, NULL, false};
+    replay_run(trace, count, &flight, time_events, stats);
+}
+
+int main(int argc, char *argv[])
+{
+    size_t count = argc > 1 ? (size_t)atol(argv[1]) : 1000000;
+    if (count == 0)
+        count = 1;
+    trace = malloc(count * sizeof(FlightRecord));
+    if (!trace)
+    {
+        fprintf(stderr, "Error: Out of memory.\n");
+        return 1;
+    }
+    sensor_init_seeded(BENCH_SEED);
+    rudder_init(0);
+    replay_synthesize(trace, count, BENCH_SEED);
+
+    ReplayStats best, stats;
+    bool consistent = true;
+    for (int run = 0; run < THROUGHPUT_RUNS; ++run)
+    {
+        replay_once(count, false, &stats);
+        consistent = consistent && (run == 0 || stats.digest == best.digest);
+        if (run == 0 || stats.elapsed_ns < best.elapsed_ns)
+            best = stats;
+    }
+    printf("\n== Throughput (best of %d untimed runs) ==\n", THROUGHPUT_RUNS);
+    replay_print_stats(&best, stdout);
+
+    replay_once(count, true, &stats);
+    consistent = consistent && stats.digest == best.digest;
+    printf("\n== Latency (every record timed) ==\n");
+    replay_print_stats(&stats, stdout);
+    free(trace);
+
+    printf("\n");
+    if (!consistent)
+    {
+        printf("FAIL: runs of the same trace made different decisions\n");
+        return 1;
+    }
+    if (argc > 2)
+    {
+        unsigned long long expected = strtoull(argv[2], NULL, 16);
+        if (expected != best.digest)
+        {
+            printf("FAIL: decision digest %016llx, expected %016llx\n", (unsigned long long)best.digest, expected);
+            return 1;
+        }
+        printf("OK: decision digest matches %016llx\n", expected);
+        return 0;
+    }
+    printf("OK: all runs made the same decisions (digest %016llx)\n", (unsigned long long)best.digest);
+    return 0;
+}
@@ -0,0 +1,135 @@
+#define _POSIX_C_SOURCE 200809L // For clock_nanosleep, sched_setscheduler and mlockall
+
+#include "rt_scheduler.h"
+#include <errno.h>    // For EINTR
+#include <sched.h>    // For sched_setscheduler
+#include <string.h>   // For memset
+#include <sys/mman.h> // For mlockall
+#include <time.h>     // For clock_nanosleep
+
+#define NS_PER_SECOND 1000000000ull
+
+// --- Setup ---
+
+void rt_scheduler_init(RtScheduler *scheduler)
+{
+    memset(scheduler, 0, sizeof(*scheduler));
+}
+
+bool rt_scheduler_add(RtScheduler *scheduler, const char *name, uint32_t rate_hz, RtTaskFn run, void *context)
+{
+    if (scheduler->task_count >= RT_SCHEDULER_MAX_TASKS || rate_hz == 0 || rate_hz > 1000000 || !run)
+        return false;
+    RtTask task = {name, NS_PER_SECOND / rate_hz, run, context, 0, {0, 0, 0, {0}, {0}}};
+
+    // Keep the table in rate-monotonic order; equal periods run in the order added
+    size_t i = scheduler->task_count;
+    for (; i > 0 && scheduler->tasks[i - 1].period_ns > task.period_ns; --i)
+        scheduler->tasks[i] = scheduler->tasks[i - 1];
+    scheduler->tasks[i] = task;
+    scheduler->task_count++;
+    return true;
+}
+
+bool rt_scheduler_promote(int priority)
+{
+    struct sched_param param = {.sched_priority = priority};
+    if (sched_setscheduler(0, SCHED_FIFO, &param) != 0)
+        return false;
+    return mlockall(MCL_CURRENT | MCL_FUTURE) == 0;
+}
+
+// --- Running ---
+
+static void sleep_until(uint64_t deadline_ns)
+{
+    struct timespec deadline = {(time_t)(deadline_ns / NS_PER_SECOND), (long)(deadline_ns % NS_PER_SECOND)};
+    // Absolute, so a signal only means going back to sleep until the same instant
+    while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &deadline, NULL) == EINTR)
+    {
+    }
+}
+
+void rt_scheduler_run(RtScheduler *scheduler, uint64_t duration_ns)
+{
+    uint64_t start = latency_now_ns();
+    uint64_t end = start + duration_ns;
+    for (size_t i = 0; i < scheduler->task_count; ++i)
+    {
+        RtTask *task = &scheduler->tasks[i];
+        task->next_release_ns = start;
+        memset(&task->stats, 0, sizeof(task->stats));
+    }
+    scheduler->stop_requested = false;
+    scheduler->sleep_ns = 0;
+
+    while (!scheduler->stop_requested && scheduler->task_count > 0)
+    {
+        // Rate-monotonic: the first due task in the table, which is sorted by period.
+        // Releases at or after the end are never due.
+        uint64_t now = latency_now_ns();
+        RtTask *task = NULL;
+        uint64_t earliest = UINT64_MAX;
+        for (size_t i = 0; i < scheduler->task_count; ++i)
+        {
+            uint64_t release = scheduler->tasks[i].next_release_ns;
+            if (release <= now && release < end)
+            {
+                task = &scheduler->tasks[i];
+                break;
+            }
+            if (release < earliest)
+                earliest = release;
+        }
+        if (!task)
+        {
+            // Nothing due: sleep until the next release, then choose again
+            if (earliest >= end)
+                break;
+            sleep_until(earliest);
+            uint64_t woke = latency_now_ns();
+            // Waking late is latency, charged to the task as jitter, not idle time
+            scheduler->sleep_ns += (woke < earliest ? woke : earliest) - now;
+            continue;
+        }
+        uint64_t release = task->next_release_ns;
+        latency_histogram_record(&task->stats.jitter, now - release);
+        task->run(task->context);
+        uint64_t finished = latency_now_ns();
+        latency_histogram_record(&task->stats.execution, finished - now);
+        task->stats.runs++;
+
+        task->next_release_ns = release + task->period_ns;
+        if (finished > task->next_release_ns)
+        {
+            task->stats.deadline_misses++;
+            // Releases whose whole period has already passed are dropped
+            uint64_t behind = (finished - task->next_release_ns) / task->period_ns;
+            task->stats.skipped += behind;
+            task->next_release_ns += behind * task->period_ns;
+        }
+    }
+    scheduler->elapsed_ns = latency_now_ns() - start;
+}
+
+void rt_scheduler_stop(RtScheduler *scheduler)
+{
+    scheduler->stop_requested = true;
+}
+
+// --- Reporting ---
+
+void rt_scheduler_print_stats(const RtScheduler *scheduler, FILE *out)
+{
+    fprintf(out, "Scheduler: %.3f s, %.1f%% idle\n", (double)scheduler->elapsed_ns / 1e9,
+            scheduler->elapsed_ns ? 100.0 * (double)scheduler->sleep_ns / (double)scheduler->elapsed_ns : 0.0);
+    for (size_t i = 0; i < scheduler->task_count; ++i)
+    {
+        const RtTask *task = &scheduler->tasks[i];
+        fprintf(out, "%s: %.0f Hz, %llu runs, %llu deadline misses, %llu releases skipped\n", task->name,
+                (double)NS_PER_SECOND / (double)task->period_ns, (unsigned long long)task->stats.runs,
+                (unsigned long long)task->stats.deadline_misses, (unsigned long long)task->stats.skipped);
+        latency_histogram_print(&task->stats.jitter, "  jitter", out);
+        latency_histogram_print(&task->stats.execution, "  execution", out);
+    }
+}
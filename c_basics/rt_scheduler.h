@@ -0,0 +1,106 @@
+#ifndef RT_SCHEDULER_H_
+#define RT_SCHEDULER_H_
+
+#include <stdbool.h> // For bool type
+#include <stddef.h>  // For size_t
+#include <stdint.h>  // For fixed-width integers
+#include <stdio.h>   // For FILE
+
+#include "latency_histogram.h" // For jitter and execution times
+
+// --- Real-Time Scheduler ---
+// Runs periodic tasks (e.g. sensors at 1 kHz, commands at 100 Hz, rudder at 10 Hz)
+// on the calling thread. Each task is released at start + k * period and sleeps until
+// then with clock_nanosleep on an absolute CLOCK_MONOTONIC deadline, so a late run
+// never pushes back the releases after it and the rates do not drift.
+//
+// Tasks run to completion, one at a time. When several are due, the one with the
+// shortest period runs first (rate-monotonic order). A task's deadline is its next
+// release: a run that finishes later counts as a deadline miss. If a task falls a
+// whole period or more behind, the releases it missed are dropped and counted, not
+// run back to back.
+//
+// For each task the scheduler records the jitter (start minus release) and the
+// execution time of every run. Stats are plain counters, read once rt_scheduler_run
+// has returned.
+
+#define RT_SCHEDULER_MAX_TASKS 8
+
+typedef void (*RtTaskFn)(void *context);
+
+typedef struct
+{
+    uint64_t runs;             // Times the task ran
+    uint64_t deadline_misses;  // Runs that finished after the task's next release
+    uint64_t skipped;          // Releases dropped because the task was a whole period behind
+    LatencyHistogram jitter;   // Release -> start of the run
+    LatencyHistogram execution; // Start -> end of the run
+} RtTaskStats;
+
+typedef struct
+{
+    const char *name;
+    uint64_t period_ns;
+    RtTaskFn run;
+    void *context;
+    uint64_t next_release_ns; // CLOCK_MONOTONIC (latency_now_ns)
+    RtTaskStats stats;
+} RtTask;
+
+typedef struct
+{
+    RtTask tasks[RT_SCHEDULER_MAX_TASKS]; // Sorted by period, shortest first
+    size_t task_count;
+    bool stop_requested;  // Set by rt_scheduler_stop, e.g. from a task
+    uint64_t elapsed_ns;  // Length of the last rt_scheduler_run
+    uint64_t sleep_ns;    // Idle time in it: asleep until a release, not counting waking late
+} RtScheduler;
+
+// --- Function Declarations ---
+
+/**
+ * @brief Empties a scheduler.
+ */
+void rt_scheduler_init(RtScheduler *scheduler);
+
+/**
+ * @brief Adds a periodic task.
+ * @param scheduler The scheduler (not running).
+ * @param name Name used in the stats; must outlive the scheduler.
+ * @param rate_hz How many times per second the task runs (at most 1,000,000).
+ * @param run Called once per period with `context`.
+ * @param context Passed to `run`.
+ * @return True if successful, false if the scheduler is full or the rate is out of range.
+ */
+bool rt_scheduler_add(RtScheduler *scheduler, const char *name, uint32_t rate_hz, RtTaskFn run, void *context);
+
+/**
+ * @brief Runs the tasks until `duration_ns` has passed or rt_scheduler_stop is called.
+ *        Every task is first released at the start; stats are reset.
+ * @param scheduler The scheduler.
+ * @param duration_ns How long to run; releases at or after start + duration are not run.
+ */
+void rt_scheduler_run(RtScheduler *scheduler, uint64_t duration_ns);
+
+/**
+ * @brief Makes rt_scheduler_run return before the next release. Call it from a task.
+ */
+void rt_scheduler_stop(RtScheduler *scheduler);
+
+/**
+ * @brief Asks the OS to treat the calling thread as real-time: SCHED_FIFO at `priority`
+ *        and all memory locked, so neither other processes nor page faults delay it.
+ * @param priority SCHED_FIFO priority (1-99).
+ * @return True if both took effect; false without the privileges (e.g. CAP_SYS_NICE).
+ */
+bool rt_scheduler_promote(int priority);
+
+/**
+ * @brief Prints one line per task: rate, runs, deadline misses, skipped releases, and
+ *        the jitter and execution time percentiles.
+ * @param scheduler The scheduler, after rt_scheduler_run.
+ * @param out Stream to print to.
+ */
+void rt_scheduler_print_stats(const RtScheduler *scheduler, FILE *out);
+
+#endif // RT_SCHEDULER_H_
@@ -0,0 +1,197 @@
+// Benchmark for batch rudder updates.
+//
+// Usage: rudder_bench [rudders]
+//
+// Moves a batch of rudders (default 100,003, so the vector kernels also leave a tail)
+// back and forth between two sets of random targets over the whole int8_t range,
+// about 65% of which are outside the limits:
+//   - one rudder_instance_set_angle call per rudder, counting limited targets with branches
+//   - rudder_set_angles with each kernel this CPU supports, without and with a
+//     slew-rate limit
+// and reports rudders per second. Each kernel is first checked against a plain C
+// reference, angles and counters both, over several rounds and every tail length.
+
+#define _POSIX_C_SOURCE 200809L // For clock_gettime
+
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "rudder_control.h"
+#include "sensor_module.h" // For SensorRng
+
+#define BENCH_SEED 11
+#define ROUNDS 200
+#define CHECK_ROUNDS 20
+#define SLEW_STEP_DEG 5
+
+static double now_seconds(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+static void random_targets(SensorRng *rng, int8_t *targets, size_t count)
+{
+    for (size_t i = 0; i < count; ++i)
+        targets[i] = (int8_t)(sensor_rng_next(rng) >> 56);
+}
+
+// The obvious per-rudder code, for checking
+static void reference(int8_t *angles, const int8_t *targets, size_t count, int max_step, RudderLimitCounters *limits)
+{
+    for (size_t i = 0; i < count; ++i)
+    {
+        int target = targets[i];
+        if (target > RUDDER_MAX_ANGLE)
+        {
+            target = RUDDER_MAX_ANGLE;
+            limits->max_limited++;
+        }
+        else if (target < RUDDER_MIN_ANGLE)
+        {
+            target = RUDDER_MIN_ANGLE;
+            limits->min_limited++;
+        }
+        int move = target - angles[i];
+        if (max_step > 0 && move > max_step)
+        {
+            move = max_step;
+            limits->rate_limited++;
+        }
+        else if (max_step > 0 && move < -max_step)
+        {
+            move = -max_step;
+            limits->rate_limited++;
+        }
+        angles[i] = (int8_t)(angles[i] + move);
+    }
+}
+
+static bool same_counters(const RudderLimitCounters *a, const RudderLimitCounters *b)
+{
+    return a->max_limited == b->max_limited && a->min_limited == b->min_limited && a->rate_limited == b->rate_limited;
+}
+
+// Runs CHECK_ROUNDS rounds of new targets through rudder_set_angles and the reference
+static bool check(SensorRng *rng, int8_t *targets, size_t count, uint8_t max_step)
+{
+    int8_t *angles = calloc(count, 1);
+    int8_t *expected = calloc(count, 1);
+    if (!angles || !expected)
+    {
+        free(angles);
+        free(expected);
+        return false;
+    }
+    RudderBatch batch = {angles, targets, count, max_step, {0, 0, 0}};
+    RudderLimitCounters expected_limits = {0, 0, 0};
+    bool ok = true;
+    for (int round = 0; round < CHECK_ROUNDS && ok; ++round)
+    {
+        random_targets(rng, targets, count);
+        rudder_set_angles(&batch);
+        reference(expected, targets, count, max_step, &expected_limits);
+        ok = memcmp(angles, expected, count) == 0 && same_counters(&batch.limits, &expected_limits);
+    }
+    free(angles);
+    free(expected);
+    return ok;
+}
+
+// Average time of one rudder_set_angles call over ROUNDS, alternating the target sets
+static double time_batch(RudderBatch *batch, const int8_t *targets[2])
+{
+    double start = now_seconds();
+    for (int round = 0; round < ROUNDS; ++round)
+    {
+        batch->targets_deg = targets[round & 1];
+        rudder_set_angles(batch);
+    }
+    return (now_seconds() - start) / ROUNDS;
+}
+
+int main(int argc, char *argv[])
+{
+    size_t count = argc > 1 ? (size_t)atol(argv[1]) : 100003;
+    if (count == 0)
+        count = 1;
+    int8_t *target_sets[2] = {malloc(count), malloc(count)};
+    int8_t *angles = calloc(count, 1);
+    RudderConfig *rudders = calloc(count, sizeof(RudderConfig));
+    if (!target_sets[0] || !target_sets[1] || !angles || !rudders)
+    {
+        fprintf(stderr, "Error: Out of memory.\n");
+        return 1;
+    }
+    SensorRng rng;
+    sensor_rng_seed(&rng, SENSOR_RNG_XOSHIRO256SS, BENCH_SEED);
+
+    printf("%zu rudders, limits [%d, %d], slew-rate limit %d deg per call, default kernel: %s\n\n", count,
+           RUDDER_MIN_ANGLE, RUDDER_MAX_ANGLE, SLEW_STEP_DEG, rudder_batch_impl_name(rudder_batch_active()));
+
+    // Checks leave random targets in target_sets[0]; fill the other set too
+    bool all_ok = true;
+    for (int impl = RUDDER_BATCH_SCALAR; impl <= RUDDER_BATCH_AVX2; ++impl)
+    {
+        if (!rudder_batch_select((RudderBatchImpl)impl))
+            continue;
+        bool ok = check(&rng, target_sets[0], count, 0) && check(&rng, target_sets[0], count, SLEW_STEP_DEG);
+        for (size_t length = 1; length <= 64 && length <= count; ++length) // Every tail length
+            ok = ok && check(&rng, target_sets[0], length, SLEW_STEP_DEG);
+        printf("%-6s matches the reference: %s\n", rudder_batch_impl_name((RudderBatchImpl)impl), ok ? "yes" : "NO");
+        all_ok = all_ok && ok;
+    }
+    random_targets(&rng, target_sets[0], count);
+    random_targets(&rng, target_sets[1], count);
+    const int8_t *targets[2] = {target_sets[0], target_sets[1]};
+
+    // One call per rudder
+    uint64_t limited = 0;
+    double start = now_seconds();
+    for (int round = 0; round < ROUNDS; ++round)
+    {
+        const int8_t *round_targets = targets[round & 1];
+        for (size_t i = 0; i < count; ++i)
+        {
+            if (rudder_instance_set_angle(&rudders[i], round_targets[i]) != round_targets[i])
+                limited++;
+        }
+    }
+    double single_s = (now_seconds() - start) / ROUNDS;
+    printf("\nper-rudder calls %8.3f ns/rudder %7.0f M rudders/s  (%.1f%% limited)\n", single_s * 1e9 / count,
+           count / single_s / 1e6, 100.0 * (double)limited / ((double)count * ROUNDS));
+
+    RudderLimitCounters slew_limits = {0, 0, 0};
+    for (int impl = RUDDER_BATCH_SCALAR; impl <= RUDDER_BATCH_AVX2; ++impl)
+    {
+        if (!rudder_batch_select((RudderBatchImpl)impl))
+            continue;
+        memset(angles, 0, count);
+        RudderBatch batch = {angles, NULL, count, 0, {0, 0, 0}};
+        double clamp_s = time_batch(&batch, targets);
+        memset(angles, 0, count);
+        batch.max_step_deg = SLEW_STEP_DEG;
+        batch.limits = (RudderLimitCounters){0, 0, 0};
+        double slew_s = time_batch(&batch, targets);
+        slew_limits = batch.limits;
+        const char *name = rudder_batch_impl_name((RudderBatchImpl)impl);
+        printf("%-6s clamp    %8.3f ns/rudder %7.0f M rudders/s  (%.1fx)\n", name, clamp_s * 1e9 / count,
+               count / clamp_s / 1e6, single_s / clamp_s);
+        printf("%-6s + slew   %8.3f ns/rudder %7.0f M rudders/s  (%.1fx)\n", name, slew_s * 1e9 / count,
+               count / slew_s / 1e6, single_s / slew_s);
+    }
+    rudder_batch_select(RUDDER_BATCH_AUTO);
+    printf("\nlimit events per slew-limited call: %.0f above max, %.0f below min, %.0f rate limited\n",
+           (double)slew_limits.max_limited / ROUNDS, (double)slew_limits.min_limited / ROUNDS,
+           (double)slew_limits.rate_limited / ROUNDS);
+
+    free(target_sets[0]);
+    free(target_sets[1]);
+    free(angles);
+    free(rudders);
+    return all_ok ? 0 : 1;
+}
@@ -1,5 +1,12 @@
 #include "rudder_control.h"
-#include <stdio.h> // For printf
+#include <stdatomic.h> // For the dispatch pointer
+#include <stdio.h>     // For printf
+#include <string.h>    // For memcpy
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define RUDDER_HAVE_X86 1
+#include <immintrin.h> // SSE2/AVX2 intrinsics
+#endif
 
 // --- Static Global Variable (Module-Specific State) ---
 // This will store the actual rudder configuration. In a more complex system,
@@ -100,3 +107,272 @@ int8_t rudder_get_current_angle(const RudderConfig *config)
     // or access members in a read-only fashion (which is what we are doing).
     return config->current_angle_deg;
 }
+
+// --- Caller-Owned Rudders ---
+
+static int8_t clamp_angle(int8_t angle)
+{
+    return angle > RUDDER_MAX_ANGLE ? RUDDER_MAX_ANGLE : angle < RUDDER_MIN_ANGLE ? RUDDER_MIN_ANGLE : angle;
+}
+
+void rudder_instance_init(RudderConfig *config, int8_t initial_angle_deg)
+{
+    config->current_angle_deg = clamp_angle(initial_angle_deg);
+}
+
+int8_t rudder_instance_set_angle(RudderConfig *config, int8_t target_angle_deg)
+{
+    config->current_angle_deg = clamp_angle(target_angle_deg);
+    return config->current_angle_deg;
+}
+
+// --- Batch Updates ---
+// Every kernel does the same per rudder: count and clamp the target, then move the
+// angle towards it by at most max_step degrees. A batch without a slew-rate limit uses
+// a step of 127, which no move between two angles within the limits can exceed.
+
+typedef void (*RudderBatchKernel)(int8_t *angles, const int8_t *targets, size_t count, int8_t max_step,
+                                  RudderLimitCounters *limits);
+
+// Portable C, written so the compiler can vectorize it: the inner loop has a fixed
+// length, no branches (the ternaries become min/max) and arrays that do not overlap.
+// gcc -O2 turns each block into 16-byte vector instructions.
+#define RUDDER_SCALAR_BLOCK 64
+
+static inline void set_angles_block(int8_t *restrict angles, const int8_t *restrict targets, size_t count,
+                                    int8_t max_step, RudderLimitCounters *limits)
+{
+    unsigned above = 0, below = 0, slewed = 0;
+    for (size_t i = 0; i < count; ++i)
+    {
+        int8_t target = targets[i];
+        above += target > RUDDER_MAX_ANGLE;
+        below += target < RUDDER_MIN_ANGLE;
+        target = target > RUDDER_MAX_ANGLE ? RUDDER_MAX_ANGLE : target;
+        target = target < RUDDER_MIN_ANGLE ? RUDDER_MIN_ANGLE : target;
+        int8_t move = (int8_t)(target - angles[i]); // Both within the limits: fits in int8_t
+        int8_t limited = move > max_step ? max_step : move;
+        limited = limited < -max_step ? (int8_t)-max_step : limited;
+        slewed += limited != move;
+        angles[i] = (int8_t)(angles[i] + limited);
+    }
+    limits->max_limited += above;
+    limits->min_limited += below;
+    limits->rate_limited += slewed;
+}
+
+static void set_angles_scalar(int8_t *angles, const int8_t *targets, size_t count, int8_t max_step,
+                              RudderLimitCounters *limits)
+{
+    size_t i = 0;
+    for (; i + RUDDER_SCALAR_BLOCK <= count; i += RUDDER_SCALAR_BLOCK)
+        set_angles_block(angles + i, targets + i, RUDDER_SCALAR_BLOCK, max_step, limits);
+    set_angles_block(angles + i, targets + i, count - i, max_step, limits);
+}
+
+#ifdef RUDDER_HAVE_X86
+// The vector kernels count events per byte lane (a compare gives -1 where true, so
+// subtracting it adds one) and add the lanes up every 255 iterations, before a lane
+// can overflow.
+#define RUDDER_COUNT_FLUSH 255
+
+// SSE2 has no signed byte min/max (SSE4.1 added them): select with a compare mask
+__attribute__((target("sse2"))) static inline __m128i min_epi8_sse2(__m128i a, __m128i b)
+{
+    __m128i a_greater = _mm_cmpgt_epi8(a, b);
+    return _mm_or_si128(_mm_and_si128(a_greater, b), _mm_andnot_si128(a_greater, a));
+}
+
+__attribute__((target("sse2"))) static inline __m128i max_epi8_sse2(__m128i a, __m128i b)
+{
+    __m128i a_greater = _mm_cmpgt_epi8(a, b);
+    return _mm_or_si128(_mm_and_si128(a_greater, a), _mm_andnot_si128(a_greater, b));
+}
+
+// Sum of the 16 byte lanes; each 8-lane half sums to at most 2040
+__attribute__((target("sse2"))) static inline uint64_t sum_lanes_sse2(__m128i counts)
+{
+    __m128i halves = _mm_sad_epu8(counts, _mm_setzero_si128());
+    return (uint64_t)_mm_extract_epi16(halves, 0) + (uint64_t)_mm_extract_epi16(halves, 4);
+}
+
+__attribute__((target("sse2"))) static void set_angles_sse2(int8_t *angles, const int8_t *targets, size_t count,
+                                                            int8_t max_step, RudderLimitCounters *limits)
+{
+    const __m128i max_angle = _mm_set1_epi8(RUDDER_MAX_ANGLE);
+    const __m128i min_angle = _mm_set1_epi8(RUDDER_MIN_ANGLE);
+    const __m128i step_up = _mm_set1_epi8(max_step);
+    const __m128i step_down = _mm_set1_epi8((int8_t)-max_step);
+    const __m128i all_ones = _mm_set1_epi8(-1);
+    size_t i = 0;
+    while (i + 16 <= count)
+    {
+        __m128i above = _mm_setzero_si128();
+        __m128i below = _mm_setzero_si128();
+        __m128i slewed = _mm_setzero_si128();
+        for (int n = 0; n < RUDDER_COUNT_FLUSH && i + 16 <= count; ++n, i += 16)
+        {
+            __m128i target = _mm_loadu_si128((const __m128i *)(targets + i));
+            __m128i angle = _mm_loadu_si128((const __m128i *)(angles + i));
+            above = _mm_sub_epi8(above, _mm_cmpgt_epi8(target, max_angle));
+            below = _mm_sub_epi8(below, _mm_cmplt_epi8(target, min_angle));
+            target = max_epi8_sse2(min_epi8_sse2(target, max_angle), min_angle);
+            __m128i move = _mm_subs_epi8(target, angle);
+            __m128i limited = max_epi8_sse2(min_epi8_sse2(move, step_up), step_down);
+            slewed = _mm_sub_epi8(slewed, _mm_xor_si128(_mm_cmpeq_epi8(move, limited), all_ones));
+            _mm_storeu_si128((__m128i *)(angles + i), _mm_adds_epi8(angle, limited));
+        }
+        limits->max_limited += sum_lanes_sse2(above);
+        limits->min_limited += sum_lanes_sse2(below);
+        limits->rate_limited += sum_lanes_sse2(slewed);
+    }
+    if (i < count)
+    {
+        // Pad the last rudders to a full register; zero angles and targets cause no events
+        int8_t tail_angles[16] = {0};
+        int8_t tail_targets[16] = {0};
+        memcpy(tail_angles, angles + i, count - i);
+        memcpy(tail_targets, targets + i, count - i);
+        set_angles_sse2(tail_angles, tail_targets, 16, max_step, limits);
+        memcpy(angles + i, tail_angles, count - i);
+    }
+}
+
+__attribute__((target("avx2"))) static inline uint64_t sum_lanes_avx2(__m256i counts)
+{
+    __m256i quarters = _mm256_sad_epu8(counts, _mm256_setzero_si256());
+    __m128i halves = _mm_add_epi64(_mm256_castsi256_si128(quarters), _mm256_extracti128_si256(quarters, 1));
+    return (uint64_t)_mm_extract_epi16(halves, 0) + (uint64_t)_mm_extract_epi16(halves, 4);
+}
+
+__attribute__((target("avx2"))) static void set_angles_avx2(int8_t *angles, const int8_t *targets, size_t count,
+                                                            int8_t max_step, RudderLimitCounters *limits)
+{
+    const __m256i max_angle = _mm256_set1_epi8(RUDDER_MAX_ANGLE);
+    const __m256i min_angle = _mm256_set1_epi8(RUDDER_MIN_ANGLE);
+    const __m256i step_up = _mm256_set1_epi8(max_step);
+    const __m256i step_down = _mm256_set1_epi8((int8_t)-max_step);
+    const __m256i all_ones = _mm256_set1_epi8(-1);
+    size_t i = 0;
+    while (i + 32 <= count)
+    {
+        __m256i above = _mm256_setzero_si256();
+        __m256i below = _mm256_setzero_si256();
+        __m256i slewed = _mm256_setzero_si256();
+        for (int n = 0; n < RUDDER_COUNT_FLUSH && i + 32 <= count; ++n, i += 32)
+        {
+            __m256i target = _mm256_loadu_si256((const __m256i *)(targets + i));
+            __m256i angle = _mm256_loadu_si256((const __m256i *)(angles + i));
+            above = _mm256_sub_epi8(above, _mm256_cmpgt_epi8(target, max_angle));
+            below = _mm256_sub_epi8(below, _mm256_cmpgt_epi8(min_angle, target));
+            target = _mm256_max_epi8(_mm256_min_epi8(target, max_angle), min_angle);
+            __m256i move = _mm256_subs_epi8(target, angle);
+            __m256i limited = _mm256_max_epi8(_mm256_min_epi8(move, step_up), step_down);
+            slewed = _mm256_sub_epi8(slewed, _mm256_xor_si256(_mm256_cmpeq_epi8(move, limited), all_ones));
+            _mm256_storeu_si256((__m256i *)(angles + i), _mm256_adds_epi8(angle, limited));
+        }
+        limits->max_limited += sum_lanes_avx2(above);
+        limits->min_limited += sum_lanes_avx2(below);
+        limits->rate_limited += sum_lanes_avx2(slewed);
+    }
+    // gcc does not always emit the vzeroupper itself here; without it, SSE code after
+    // this (memcpy, the caller) runs with the upper halves dirty and pays on every instruction
+    _mm256_zeroupper();
+    if (i < count)
+    {
+        int8_t tail_angles[32] = {0};
+        int8_t tail_targets[32] = {0};
+        memcpy(tail_angles, angles + i, count - i);
+        memcpy(tail_targets, targets + i, count - i);
+        set_angles_avx2(tail_angles, tail_targets, 32, max_step, limits);
+        memcpy(angles + i, tail_angles, count - i);
+    }
+}
+#endif // RUDDER_HAVE_X86
+
+// Resolved on the first call, as in checksum.c
+static void set_angles_first_call(int8_t *angles, const int8_t *targets, size_t count, int8_t max_step,
+                                  RudderLimitCounters *limits);
+
+static _Atomic(RudderBatchKernel) set_angles_kernel = set_angles_first_call;
+static _Atomic(int) active_batch_impl = RUDDER_BATCH_AUTO;
+
+static bool batch_impl_supported(RudderBatchImpl impl)
+{
+    switch (impl)
+    {
+    case RUDDER_BATCH_SCALAR:
+        return true;
+#ifdef RUDDER_HAVE_X86
+    case RUDDER_BATCH_SSE2:
+        return __builtin_cpu_supports("sse2");
+    case RUDDER_BATCH_AVX2:
+        return __builtin_cpu_supports("avx2");
+#endif
+    default:
+        return false;
+    }
+}
+
+bool rudder_batch_select(RudderBatchImpl impl)
+{
+    if (impl == RUDDER_BATCH_AUTO)
+    {
+        impl = RUDDER_BATCH_SCALAR;
+        if (batch_impl_supported(RUDDER_BATCH_SSE2))
+            impl = RUDDER_BATCH_SSE2;
+        if (batch_impl_supported(RUDDER_BATCH_AVX2))
+            impl = RUDDER_BATCH_AVX2;
+    }
+    if (!batch_impl_supported(impl))
+        return false;
+
+    RudderBatchKernel kernel = set_angles_scalar;
+#ifdef RUDDER_HAVE_X86
+    if (impl == RUDDER_BATCH_SSE2)
+        kernel = set_angles_sse2;
+    else if (impl == RUDDER_BATCH_AVX2)
+        kernel = set_angles_avx2;
+#endif
+    atomic_store_explicit(&set_angles_kernel, kernel, memory_order_relaxed);
+    atomic_store_explicit(&active_batch_impl, (int)impl, memory_order_relaxed);
+    return true;
+}
+
+RudderBatchImpl rudder_batch_active(void)
+{
+    if (atomic_load_explicit(&active_batch_impl, memory_order_relaxed) == RUDDER_BATCH_AUTO)
+        rudder_batch_select(RUDDER_BATCH_AUTO);
+    return (RudderBatchImpl)atomic_load_explicit(&active_batch_impl, memory_order_relaxed);
+}
+
+const char *rudder_batch_impl_name(RudderBatchImpl impl)
+{
+    switch (impl)
+    {
+    case RUDDER_BATCH_AUTO:
+        return "auto";
+    case RUDDER_BATCH_SCALAR:
+        return "scalar";
+    case RUDDER_BATCH_SSE2:
+        return "sse2";
+    case RUDDER_BATCH_AVX2:
+        return "avx2";
+    }
+    return "unknown";
+}
+
+static void set_angles_first_call(int8_t *angles, const int8_t *targets, size_t count, int8_t max_step,
+                                  RudderLimitCounters *limits)
+{
+    rudder_batch_select(RUDDER_BATCH_AUTO);
+    atomic_load_explicit(&set_angles_kernel, memory_order_relaxed)(angles, targets, count, max_step, limits);
+}
+
+void rudder_set_angles(RudderBatch *batch)
+{
+    int8_t max_step = batch->max_step_deg == 0 || batch->max_step_deg > INT8_MAX ? INT8_MAX
+                                                                                 : (int8_t)batch->max_step_deg;
+    RudderBatchKernel kernel = atomic_load_explicit(&set_angles_kernel, memory_order_relaxed);
+    kernel(batch->angles_deg, batch->targets_deg, batch->count, max_step, &batch->limits);
+}
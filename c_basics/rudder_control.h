@@ -1,7 +1,9 @@
 #ifndef RUDDER_CONTROL_H_
 #define RUDDER_CONTROL_H_
 
-#include <stdint.h> // For int8_t
+#include <stdbool.h> // For bool type
+#include <stddef.h>  // For size_t
+#include <stdint.h>  // For int8_t
 
 // --- Constants ---
 #define RUDDER_MAX_ANGLE 45  // Degrees
@@ -39,4 +41,80 @@ int8_t rudder_set_angle(RudderConfig *config, int8_t target_angle_deg);
  */
 int8_t rudder_get_current_angle(const RudderConfig *config); // const pointer as it doesn't modify config
 
-#endif // RUDDER_CONTROL_H_
\ No newline at end of file
+// --- Caller-Owned Rudders ---
+// The functions above check the module's single global initialization flag and
+// print when an angle is limited, so they model exactly one aircraft. These act only
+// on the RudderConfig they are given (the c_remake approach), never print, and are
+// safe to use for any number of rudders from any number of threads.
+
+/**
+ * @brief Initializes a caller-owned rudder. No global state is involved.
+ * @param config The rudder to initialize.
+ * @param initial_angle_deg The starting angle; limits are applied.
+ */
+void rudder_instance_init(RudderConfig *config, int8_t initial_angle_deg);
+
+/**
+ * @brief Sets a caller-owned rudder to a target angle, applying limits silently.
+ * @param config The rudder.
+ * @param target_angle_deg The desired angle.
+ * @return The angle set after applying limits.
+ */
+int8_t rudder_instance_set_angle(RudderConfig *config, int8_t target_angle_deg);
+
+// --- Batch Updates ---
+// rudder_set_angles moves many rudders at once, e.g. a fleet control loop's output.
+// Angles and targets are plain int8_t arrays; the limits are applied with SIMD min/max,
+// 16 or 32 rudders per instruction, and limit events are counted rather than printed.
+// As with the checksum kernels, the implementation is picked for the CPU on first use.
+
+typedef enum
+{
+    RUDDER_BATCH_AUTO = 0, // Best supported by this CPU
+    RUDDER_BATCH_SCALAR,   // Portable C, vectorized by the compiler where it can
+    RUDDER_BATCH_SSE2,     // 16 rudders per instruction (every x86-64 CPU)
+    RUDDER_BATCH_AVX2,     // 32 rudders per instruction
+} RudderBatchImpl;
+
+typedef struct
+{
+    uint64_t max_limited;  // Targets above RUDDER_MAX_ANGLE
+    uint64_t min_limited;  // Targets below RUDDER_MIN_ANGLE
+    uint64_t rate_limited; // Moves cut short by the slew-rate limit
+} RudderLimitCounters;
+
+typedef struct
+{
+    int8_t *angles_deg;         // Current angle of each rudder, within the limits; updated in place
+    const int8_t *targets_deg;  // Desired angle of each rudder; must not overlap angles_deg
+    size_t count;               // Number of rudders
+    uint8_t max_step_deg;       // Slew-rate limit: the most a rudder moves per call; 0 for none
+    RudderLimitCounters limits; // Added to by every call
+} RudderBatch;
+
+/**
+ * @brief Sets every rudder in a batch to its target, applying the angle limits and the
+ *        slew-rate limit. Counts limited targets in batch->limits instead of printing.
+ * @param batch The rudders.
+ */
+void rudder_set_angles(RudderBatch *batch);
+
+/**
+ * @brief Forces a specific implementation of rudder_set_angles, e.g. to benchmark them.
+ * @param impl The implementation to use from now on; RUDDER_BATCH_AUTO restores the default choice.
+ * @return True if successful, false if this CPU (or build) does not support it.
+ */
+bool rudder_batch_select(RudderBatchImpl impl);
+
+/**
+ * @brief Reports which implementation rudder_set_angles currently uses.
+ * @return The active implementation (never RUDDER_BATCH_AUTO).
+ */
+RudderBatchImpl rudder_batch_active(void);
+
+/**
+ * @brief Human-readable name of an implementation ("scalar", "sse2", ...).
+ */
+const char *rudder_batch_impl_name(RudderBatchImpl impl);
+
+#endif // RUDDER_CONTROL_H_
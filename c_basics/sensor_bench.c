@@ -0,0 +1,176 @@
+// Benchmark for the sensor simulator's random number generators.
+//
+// Usage: sensor_bench [readings per thread]
+//
+//   1. one thread: the old rand()-based reading (kept here as the reference) against
+//      sensor_read_data, sensor_read_data_from and sensor_read_batch with each generator
+//   2. 1, 2 and 4 threads at once, rand() against one generator per thread: the
+//      total readings/s should grow with the threads for as long as there are cores
+//   3. the share of readings with each status flag, against the intended rates
+//      (10% low battery, 5% error, 20% needs calibration)
+
+#define _POSIX_C_SOURCE 200809L // For clock_gettime and sysconf
+
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "sensor_module.h"
+
+#define BATCH_SIZE 256
+#define MAX_THREADS 4
+
+static double now_seconds(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+// sensor_read_data as it was, on rand()
+static SensorData read_with_rand(void)
+{
+    SensorData data;
+    data.altitude_m = 1000.0f + (rand() % 500) - 250.0f;
+    data.airspeed_kmh = 300 + (rand() % 100) - 50;
+    data.temperature_c = 15.0f + (rand() % 20) - 10.0f;
+    data.status_flags = SENSOR_STATUS_OK;
+    if (rand() % 10 == 0)
+        data.status_flags |= SENSOR_STATUS_LOW_BATTERY;
+    if (rand() % 20 == 0)
+    {
+        data.status_flags |= SENSOR_STATUS_ERROR;
+        data.status_flags &= ~SENSOR_STATUS_OK;
+    }
+    if (rand() % 5 == 0)
+        data.status_flags |= SENSOR_STATUS_NEEDS_CAL;
+    return data;
+}
+
+typedef enum
+{
+    METHOD_RAND,
+    METHOD_THREAD_DEFAULT, // sensor_read_data
+    METHOD_SINGLE,         // sensor_read_data_from
+    METHOD_BATCH,          // sensor_read_batch
+} Method;
+
+typedef struct
+{
+    Method method;
+    SensorRngKind kind;
+    size_t count;
+    unsigned seed;
+    uint64_t checksum; // Keeps the compiler from dropping the readings
+    uint64_t flags[4]; // Readings with each status bit set
+} Job;
+
+static void tally(Job *job, const SensorData *data)
+{
+    job->checksum += (uint64_t)data->airspeed_kmh + (uint64_t)data->altitude_m;
+    for (int bit = 0; bit < 4; ++bit)
+        job->flags[bit] += (data->status_flags >> bit) & 1;
+}
+
+static void *run_job(void *arg)
+{
+    Job *job = (Job *)arg;
+    SensorRng rng;
+    sensor_rng_seed(&rng, job->kind, job->seed);
+    SensorData batch[BATCH_SIZE];
+    for (size_t done = 0; done < job->count;)
+    {
+        size_t n = job->count - done < BATCH_SIZE ? job->count - done : BATCH_SIZE;
+        switch (job->method)
+        {
+        case METHOD_RAND:
+            for (size_t i = 0; i < n; ++i)
+                batch[i] = read_with_rand();
+            break;
+        case METHOD_THREAD_DEFAULT:
+            for (size_t i = 0; i < n; ++i)
+                batch[i] = sensor_read_data();
+            break;
+        case METHOD_SINGLE:
+            for (size_t i = 0; i < n; ++i)
+                batch[i] = sensor_read_data_from(&rng);
+            break;
+        case METHOD_BATCH:
+            sensor_read_batch(&rng, batch, n);
+            break;
+        }
+        for (size_t i = 0; i < n; ++i)
+            tally(job, &batch[i]);
+        done += n;
+    }
+    return NULL;
+}
+
+// Runs the method on `threads` threads at once; returns total readings per second
+static double run(Method method, SensorRngKind kind, unsigned threads, size_t count, Job *first)
+{
+    pthread_t ids[MAX_THREADS];
+    Job jobs[MAX_THREADS];
+    double start = now_seconds();
+    for (unsigned t = 0; t < threads; ++t)
+    {
+        jobs[t] = (Job){method, kind, count, t + 1, 0, {0}};
+        pthread_create(&ids[t], NULL, run_job, &jobs[t]);
+    }
+    for (unsigned t = 0; t < threads; ++t)
+        pthread_join(ids[t], NULL);
+    double seconds = now_seconds() - start;
+    if (first)
+        *first = jobs[0];
+    return (double)count * threads / seconds;
+}
+
+int main(int argc, char *argv[])
+{
+    size_t count = argc > 1 ? (size_t)atol(argv[1]) : 4000000;
+    if (count == 0)
+        count = 1;
+    sensor_init_seeded(1);
+    srand(1);
+
+    printf("\n== One thread, %zu readings ==\n", count);
+    static const struct
+    {
+        const char *label;
+        Method method;
+        SensorRngKind kind;
+    } single[] = {
+        {"rand() (old sensor_read_data)", METHOD_RAND, SENSOR_RNG_XOSHIRO256SS},
+        {"sensor_read_data (per thread)", METHOD_THREAD_DEFAULT, SENSOR_RNG_XOSHIRO256SS},
+        {"sensor_read_data_from xoshiro", METHOD_SINGLE, SENSOR_RNG_XOSHIRO256SS},
+        {"sensor_read_data_from pcg32", METHOD_SINGLE, SENSOR_RNG_PCG32},
+        {"sensor_read_batch xoshiro", METHOD_BATCH, SENSOR_RNG_XOSHIRO256SS},
+        {"sensor_read_batch pcg32", METHOD_BATCH, SENSOR_RNG_PCG32},
+    };
+    Job sample_job = {0};
+    for (size_t i = 0; i < sizeof(single) / sizeof(single[0]); ++i)
+    {
+        Job job;
+        double rate = run(single[i].method, single[i].kind, 1, count, &job);
+        printf("%-32s %6.1f ns per reading  %7.1f M readings/s\n", single[i].label, 1e9 / rate, rate / 1e6);
+        if (single[i].method == METHOD_BATCH && single[i].kind == SENSOR_RNG_XOSHIRO256SS)
+            sample_job = job;
+    }
+
+    printf("\n== Threads (%ld CPUs online) ==\n", sysconf(_SC_NPROCESSORS_ONLN));
+    for (unsigned threads = 1; threads <= MAX_THREADS; threads *= 2)
+    {
+        double with_rand = run(METHOD_RAND, SENSOR_RNG_XOSHIRO256SS, threads, count, NULL);
+        double with_batch = run(METHOD_BATCH, SENSOR_RNG_XOSHIRO256SS, threads, count, NULL);
+        printf("%u thread(s): rand() %7.1f M readings/s   sensor_read_batch %7.1f M readings/s\n", threads,
+               with_rand / 1e6, with_batch / 1e6);
+    }
+
+    printf("\n== Status flag rates (sensor_read_batch xoshiro) ==\n");
+    printf("OK %.2f%%  low battery %.2f%% (10%%)  error %.2f%% (5%%)  needs calibration %.2f%% (20%%)\n",
+           100.0 * (double)sample_job.flags[0] / (double)count, 100.0 * (double)sample_job.flags[1] / (double)count,
+           100.0 * (double)sample_job.flags[2] / (double)count, 100.0 * (double)sample_job.flags[3] / (double)count);
+    return 0;
+}
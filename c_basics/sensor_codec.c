@@ -0,0 +1,404 @@
+#include "sensor_codec.h"
+#include <string.h> // For memcpy
+
+// --- Varints ---
+// LEB128: seven bits per byte, low bits first, high bit set on all but the last byte.
+// Zig-zag maps signed to unsigned so small negative numbers stay small:
+// 0, -1, 1, -2, 2 ... become 0, 1, 2, 3, 4 ...
+
+static uint64_t zigzag_encode(int64_t value)
+{
+    return ((uint64_t)value << 1) ^ (uint64_t)(value >> 63);
+}
+
+static int64_t zigzag_decode(uint64_t value)
+{
+    return (int64_t)(value >> 1) ^ -(int64_t)(value & 1);
+}
+
+static size_t put_varint(uint8_t *out, uint64_t value)
+{
+    size_t length = 0;
+    while (value >= 0x80)
+    {
+        out[length++] = (uint8_t)(value | 0x80);
+        value >>= 7;
+    }
+    out[length++] = (uint8_t)value;
+    return length;
+}
+
+// Returns the bytes read, or 0 if the varint runs past `end` or is too long
+static size_t get_varint(const uint8_t *in, const uint8_t *end, uint64_t *value)
+{
+    uint64_t result = 0;
+    for (size_t i = 0; i < 10 && in + i < end; ++i)
+    {
+        result |= (uint64_t)(in[i] & 0x7F) << (7 * i);
+        if ((in[i] & 0x80) == 0)
+        {
+            *value = result;
+            return i + 1;
+        }
+    }
+    return 0;
+}
+
+static size_t varint_size(uint64_t value)
+{
+    size_t length = 1;
+    while (value >= 0x80)
+    {
+        value >>= 7;
+        length++;
+    }
+    return length;
+}
+
+// --- Bit Columns ---
+
+static void bits_reset(CodecBitColumn *column)
+{
+    column->pending = 0;
+    column->pending_bits = 0;
+    column->length = 0;
+}
+
+// Appends the low `count` bits of `value` (count <= 32)
+static void bits_put(CodecBitColumn *column, uint32_t value, unsigned count)
+{
+    column->pending = (column->pending << count) | (value & (count == 32 ? 0xFFFFFFFFu : (1u << count) - 1));
+    column->pending_bits += count;
+    while (column->pending_bits >= 8)
+    {
+        column->pending_bits -= 8;
+        column->bytes[column->length++] = (uint8_t)(column->pending >> column->pending_bits);
+    }
+}
+
+static size_t bits_size(const CodecBitColumn *column)
+{
+    return column->length + (column->pending_bits > 0);
+}
+
+// Copies the column out, padding the last byte with zero bits
+static void bits_copy(const CodecBitColumn *column, uint8_t *out)
+{
+    memcpy(out, column->bytes, column->length);
+    if (column->pending_bits > 0)
+        out[column->length] = (uint8_t)(column->pending << (8 - column->pending_bits));
+}
+
+typedef struct
+{
+    const uint8_t *data;
+    size_t size;
+    size_t position; // In bits
+} BitReader;
+
+// Reads `count` bits (<= 32); returns false past the end of the column
+static bool bits_get(BitReader *reader, unsigned count, uint32_t *value)
+{
+    if (reader->position + count > reader->size * 8)
+        return false;
+    uint32_t result = 0;
+    while (count > 0)
+    {
+        size_t byte = reader->position >> 3;
+        unsigned offset = (unsigned)(reader->position & 7);
+        unsigned take = 8 - offset < count ? 8 - offset : count;
+        uint32_t chunk = (uint32_t)(reader->data[byte] >> (8 - offset - take)) & ((1u << take) - 1);
+        result = (result << take) | chunk;
+        reader->position += take;
+        count -= take;
+    }
+    *value = result;
+    return true;
+}
+
+// --- XOR Float Coding ---
+// '0': same bits as the previous value.
+// '10' + bits: the changed bits fit in the previous value's window of meaningful bits.
+// '11' + 5-bit leading zero count + 5-bit (length - 1) + the meaningful bits: a new window.
+
+static uint32_t float_to_bits(float value)
+{
+    uint32_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    return bits;
+}
+
+static float bits_to_float(uint32_t bits)
+{
+    float value;
+    memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+static void put_float(CodecBitColumn *column, CodecFloatState *state, float value)
+{
+    uint32_t bits = float_to_bits(value);
+    uint32_t delta = bits ^ state->previous;
+    state->previous = bits;
+    if (delta == 0)
+    {
+        bits_put(column, 0, 1);
+        return;
+    }
+    unsigned leading = (unsigned)__builtin_clz(delta);
+    unsigned trailing = (unsigned)__builtin_ctz(delta);
+    if (leading > 31)
+        leading = 31; // Fits the 5-bit field (delta != 0, so at most 31 anyway)
+    if (state->has_window && leading >= state->leading && trailing >= state->trailing)
+    {
+        unsigned length = 32 - state->leading - state->trailing;
+        bits_put(column, 2, 2); // '10'
+        bits_put(column, delta >> state->trailing, length);
+        return;
+    }
+    unsigned length = 32 - leading - trailing;
+    bits_put(column, 3, 2); // '11'
+    bits_put(column, leading, 5);
+    bits_put(column, length - 1, 5);
+    bits_put(column, delta >> trailing, length);
+    state->leading = leading;
+    state->trailing = trailing;
+    state->has_window = true;
+}
+
+static bool get_float(BitReader *reader, CodecFloatState *state, float *value)
+{
+    uint32_t control;
+    if (!bits_get(reader, 1, &control))
+        return false;
+    if (control == 1)
+    {
+        if (!bits_get(reader, 1, &control))
+            return false;
+        if (control == 1)
+        {
+            uint32_t leading, length_minus_one;
+            if (!bits_get(reader, 5, &leading) || !bits_get(reader, 5, &length_minus_one) ||
+                leading + length_minus_one + 1 > 32)
+                return false;
+            state->leading = leading;
+            state->trailing = 32 - leading - (length_minus_one + 1);
+            state->has_window = true;
+        }
+        else if (!state->has_window)
+        {
+            return false;
+        }
+        uint32_t meaningful;
+        if (!bits_get(reader, 32 - state->leading - state->trailing, &meaningful))
+            return false;
+        state->previous ^= meaningful << state->trailing;
+    }
+    *value = bits_to_float(state->previous);
+    return true;
+}
+
+// --- Encoder ---
+
+void sensor_encoder_reset(SensorEncoder *encoder)
+{
+    encoder->count = 0;
+    encoder->last_timestamp = 0;
+    encoder->last_delta = 0;
+    encoder->timestamp_length = 0;
+    encoder->last_airspeed = 0;
+    encoder->airspeed_length = 0;
+    memset(&encoder->altitude_state, 0, sizeof(encoder->altitude_state));
+    memset(&encoder->temperature_state, 0, sizeof(encoder->temperature_state));
+    bits_reset(&encoder->altitudes);
+    bits_reset(&encoder->temperatures);
+    encoder->run_length = 0;
+    encoder->run_column_length = 0;
+}
+
+// Stores the open run of identical (source, flags)
+static size_t close_run(const SensorEncoder *encoder, uint8_t *out)
+{
+    out[0] = encoder->run_source;
+    out[1] = encoder->run_flags;
+    return 2 + put_varint(&out[2], encoder->run_length);
+}
+
+bool sensor_encoder_append(SensorEncoder *encoder, const TelemetrySample *sample)
+{
+    if (!encoder || !sample || encoder->count >= SENSOR_CODEC_MAX_SAMPLES)
+        return false;
+
+    // First sample: the timestamp itself; then the change in the sampling interval
+    if (encoder->count == 0)
+    {
+        encoder->timestamp_length += put_varint(&encoder->timestamps[encoder->timestamp_length], sample->timestamp_ns);
+    }
+    else
+    {
+        int64_t delta = (int64_t)(sample->timestamp_ns - encoder->last_timestamp);
+        encoder->timestamp_length += put_varint(&encoder->timestamps[encoder->timestamp_length],
+                                                zigzag_encode((int64_t)((uint64_t)delta - (uint64_t)encoder->last_delta)));
+        encoder->last_delta = delta;
+    }
+    encoder->last_timestamp = sample->timestamp_ns;
+
+    encoder->airspeed_length += put_varint(&encoder->airspeeds[encoder->airspeed_length],
+                                           zigzag_encode((int64_t)sample->data.airspeed_kmh - encoder->last_airspeed));
+    encoder->last_airspeed = sample->data.airspeed_kmh;
+
+    put_float(&encoder->altitudes, &encoder->altitude_state, sample->data.altitude_m);
+    put_float(&encoder->temperatures, &encoder->temperature_state, sample->data.temperature_c);
+
+    if (encoder->run_length > 0 &&
+        (sample->source != encoder->run_source || sample->data.status_flags != encoder->run_flags))
+    {
+        encoder->run_column_length += close_run(encoder, &encoder->runs[encoder->run_column_length]);
+        encoder->run_length = 0;
+    }
+    encoder->run_source = sample->source;
+    encoder->run_flags = sample->data.status_flags;
+    encoder->run_length++;
+
+    encoder->count++;
+    return true;
+}
+
+size_t sensor_encoder_count(const SensorEncoder *encoder)
+{
+    return encoder ? encoder->count : 0;
+}
+
+size_t sensor_encoder_size(const SensorEncoder *encoder)
+{
+    size_t altitude_size = bits_size(&encoder->altitudes);
+    size_t temperature_size = bits_size(&encoder->temperatures);
+    size_t runs_size = encoder->run_column_length + (encoder->run_length > 0 ? 2 + varint_size(encoder->run_length) : 0);
+    return 1 + varint_size(encoder->count) + varint_size(encoder->timestamp_length) +
+           varint_size(encoder->airspeed_length) + varint_size(altitude_size) + varint_size(temperature_size) +
+           encoder->timestamp_length + encoder->airspeed_length + altitude_size + temperature_size + runs_size;
+}
+
+size_t sensor_encoder_finish(SensorEncoder *encoder, uint8_t *out, size_t capacity)
+{
+    if (!encoder || !out)
+        return 0;
+    size_t size = sensor_encoder_size(encoder);
+    if (capacity < size)
+        return 0;
+
+    size_t altitude_size = bits_size(&encoder->altitudes);
+    size_t temperature_size = bits_size(&encoder->temperatures);
+    size_t at = 0;
+    out[at++] = SENSOR_CODEC_VERSION;
+    at += put_varint(&out[at], encoder->count);
+    at += put_varint(&out[at], encoder->timestamp_length);
+    at += put_varint(&out[at], encoder->airspeed_length);
+    at += put_varint(&out[at], altitude_size);
+    at += put_varint(&out[at], temperature_size);
+    memcpy(&out[at], encoder->timestamps, encoder->timestamp_length);
+    at += encoder->timestamp_length;
+    memcpy(&out[at], encoder->airspeeds, encoder->airspeed_length);
+    at += encoder->airspeed_length;
+    bits_copy(&encoder->altitudes, &out[at]);
+    at += altitude_size;
+    bits_copy(&encoder->temperatures, &out[at]);
+    at += temperature_size;
+    memcpy(&out[at], encoder->runs, encoder->run_column_length);
+    at += encoder->run_column_length;
+    if (encoder->run_length > 0)
+        at += close_run(encoder, &out[at]);
+
+    sensor_encoder_reset(encoder);
+    return at;
+}
+
+// --- Decoder ---
+
+size_t sensor_codec_decode(const uint8_t *block, size_t size, TelemetrySample *out, size_t max_samples)
+{
+    if (!block || !out || size < 1 || block[0] != SENSOR_CODEC_VERSION)
+        return 0;
+    const uint8_t *end = block + size;
+    const uint8_t *in = block + 1;
+
+    uint64_t header[5]; // count, then the four column lengths
+    for (int i = 0; i < 5; ++i)
+    {
+        size_t used = get_varint(in, end, &header[i]);
+        if (used == 0)
+            return 0;
+        in += used;
+    }
+    uint64_t count = header[0];
+    if (count == 0 || count > max_samples || count > SENSOR_CODEC_MAX_SAMPLES)
+        return 0;
+    size_t remaining = (size_t)(end - in);
+    if (header[1] > remaining || header[2] > remaining - header[1] ||
+        header[3] > remaining - header[1] - header[2] || header[4] > remaining - header[1] - header[2] - header[3])
+        return 0;
+
+    const uint8_t *timestamps = in;
+    const uint8_t *timestamps_end = timestamps + header[1];
+    const uint8_t *airspeeds = timestamps_end;
+    const uint8_t *airspeeds_end = airspeeds + header[2];
+    BitReader altitudes = {airspeeds_end, (size_t)header[3], 0};
+    BitReader temperatures = {airspeeds_end + header[3], (size_t)header[4], 0};
+    const uint8_t *runs = airspeeds_end + header[3] + header[4];
+
+    uint64_t timestamp = 0;
+    int64_t delta = 0;
+    int64_t airspeed = 0;
+    CodecFloatState altitude_state = {0, 0, 0, false};
+    CodecFloatState temperature_state = {0, 0, 0, false};
+    uint64_t run_left = 0;
+    uint8_t source = 0;
+    uint8_t flags = 0;
+
+    for (uint64_t i = 0; i < count; ++i)
+    {
+        uint64_t value;
+        size_t used = get_varint(timestamps, timestamps_end, &value);
+        if (used == 0)
+            return 0;
+        timestamps += used;
+        if (i == 0)
+        {
+            timestamp = value;
+        }
+        else
+        {
+            delta = (int64_t)((uint64_t)delta + (uint64_t)zigzag_decode(value));
+            timestamp += (uint64_t)delta;
+        }
+
+        used = get_varint(airspeeds, airspeeds_end, &value);
+        if (used == 0)
+            return 0;
+        airspeeds += used;
+        airspeed += zigzag_decode(value);
+
+        if (run_left == 0)
+        {
+            if (end - runs < 3)
+                return 0;
+            source = runs[0];
+            flags = runs[1];
+            used = get_varint(runs + 2, end, &run_left);
+            if (used == 0 || run_left == 0)
+                return 0;
+            runs += 2 + used;
+        }
+        run_left--;
+
+        TelemetrySample *sample = &out[i];
+        sample->timestamp_ns = timestamp;
+        sample->source = source;
+        sample->data.status_flags = flags;
+        sample->data.airspeed_kmh = (int16_t)airspeed;
+        if (!get_float(&altitudes, &altitude_state, &sample->data.altitude_m) ||
+            !get_float(&temperatures, &temperature_state, &sample->data.temperature_c))
+            return 0;
+    }
+    return (size_t)count;
+}
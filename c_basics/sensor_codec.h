@@ -0,0 +1,121 @@
+#ifndef SENSOR_CODEC_H_
+#define SENSOR_CODEC_H_
+
+#include <stdbool.h> // For bool type
+#include <stddef.h>  // For size_t
+#include <stdint.h>  // For fixed-width integers
+
+#include "telemetry.h" // For TelemetrySample
+
+// --- Sensor Series Compression ---
+// Raw samples cost 20 bytes on the wire (32 in memory, with padding), yet successive
+// readings of one sensor barely change. The encoder stores each field in its own
+// column, coded for how that field behaves:
+//   timestamp_ns    delta-of-delta, zig-zag varint: a steady sample rate costs 1 byte
+//   airspeed_kmh    delta, zig-zag varint: changes under 64 km/h cost 1 byte
+//   altitude_m,     XOR with the previous value's bits (as in Facebook's Gorilla):
+//   temperature_c   an unchanged value costs 1 bit, a small change about 2 bytes
+//   source + flags  run-length coded: (source, status_flags, run length) per run
+// Samples are appended one at a time and written out as a self-contained block, so
+// each block (a log record, a packet payload) decodes on its own.
+//
+// Block layout: version (1), sample count (varint), byte lengths of the timestamp,
+// airspeed, altitude and temperature columns (varints), then the five columns in
+// that order; the run column takes the rest of the block.
+
+#define SENSOR_CODEC_VERSION 1
+#define SENSOR_CODEC_MAX_SAMPLES 512 // Samples per block
+// Worst case per sample: 10 + 3 + 6 + 6 + 3 bytes (incompressible data grows a little)
+#define SENSOR_CODEC_MAX_SAMPLE_SIZE 28
+#define SENSOR_CODEC_MAX_BLOCK_SIZE (16 + 10 + SENSOR_CODEC_MAX_SAMPLES * SENSOR_CODEC_MAX_SAMPLE_SIZE)
+
+// A column of bits written most significant bit first
+typedef struct
+{
+    uint64_t pending;      // Bits not yet stored in `bytes`, right-aligned
+    unsigned pending_bits; // Number of bits in `pending` (< 8 between calls)
+    size_t length;         // Whole bytes stored
+    uint8_t bytes[SENSOR_CODEC_MAX_SAMPLES * 6];
+} CodecBitColumn;
+
+// Previous value and bit window of a XOR-coded float column
+typedef struct
+{
+    uint32_t previous;
+    unsigned leading;  // Leading zero bits of the last stored window
+    unsigned trailing; // Trailing zero bits of the last stored window
+    bool has_window;
+} CodecFloatState;
+
+// --- SensorEncoder Structure ---
+// About 20 KiB of column buffers; keep it static or on the heap.
+typedef struct
+{
+    size_t count; // Samples in the current block
+
+    uint64_t last_timestamp;
+    int64_t last_delta;
+    size_t timestamp_length;
+    uint8_t timestamps[SENSOR_CODEC_MAX_SAMPLES * 10];
+
+    int16_t last_airspeed;
+    size_t airspeed_length;
+    uint8_t airspeeds[SENSOR_CODEC_MAX_SAMPLES * 3];
+
+    CodecFloatState altitude_state;
+    CodecBitColumn altitudes;
+    CodecFloatState temperature_state;
+    CodecBitColumn temperatures;
+
+    uint8_t run_source;
+    uint8_t run_flags;
+    uint32_t run_length; // Samples in the open run
+    size_t run_column_length;
+    uint8_t runs[SENSOR_CODEC_MAX_SAMPLES * 3];
+} SensorEncoder;
+
+// --- Function Declarations ---
+
+/**
+ * @brief Empties an encoder, ready to start a block.
+ */
+void sensor_encoder_reset(SensorEncoder *encoder);
+
+/**
+ * @brief Adds one sample to the current block.
+ * @param encoder Pointer to the encoder.
+ * @param sample The sample.
+ * @return False if the block already holds SENSOR_CODEC_MAX_SAMPLES samples.
+ */
+bool sensor_encoder_append(SensorEncoder *encoder, const TelemetrySample *sample);
+
+/**
+ * @brief Number of samples in the current block.
+ */
+size_t sensor_encoder_count(const SensorEncoder *encoder);
+
+/**
+ * @brief Size the block would have if finished now; lets a caller cut blocks to fit a packet.
+ */
+size_t sensor_encoder_size(const SensorEncoder *encoder);
+
+/**
+ * @brief Writes the current block and resets the encoder for the next one.
+ * @param encoder Pointer to the encoder.
+ * @param out Output buffer; sensor_encoder_size() bytes (at most SENSOR_CODEC_MAX_BLOCK_SIZE) are needed.
+ * @param capacity Size of the output buffer.
+ * @return The block size in bytes, or 0 if the buffer is too small (the encoder keeps its samples).
+ */
+size_t sensor_encoder_finish(SensorEncoder *encoder, uint8_t *out, size_t capacity);
+
+/**
+ * @brief Decodes a block written by sensor_encoder_finish.
+ * @param block The block's bytes.
+ * @param size The block's size.
+ * @param out Receives the samples.
+ * @param max_samples Capacity of out; SENSOR_CODEC_MAX_SAMPLES always suffices.
+ * @return The number of samples decoded, or 0 if the block is malformed or does not fit in out.
+ */
+size_t sensor_codec_decode(const uint8_t *block, size_t size, TelemetrySample *out, size_t max_samples);
+
+#endif // SENSOR_CODEC_H_
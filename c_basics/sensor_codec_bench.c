@@ -0,0 +1,144 @@
+// Benchmark for the sensor series codec.
+//
+// Usage: sensor_codec_bench [samples]
+//
+// Encodes the same number of samples from two sources into SENSOR_CODEC_MAX_SAMPLES
+// blocks and reports bytes per sample (against TELEMETRY_SAMPLE_WIRE_SIZE on the
+// wire) and encode/decode throughput:
+//   1. a steady flight profile at 1 kHz: slow climb, gusting airspeed, drifting
+//      temperature, values at typical sensor resolution, a little clock jitter
+//   2. sensor_read_data(), which draws every field at random: close to the worst case
+// Every block is decoded again and compared field by field with what went in.
+
+#define _POSIX_C_SOURCE 200809L // For clock_gettime
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "sensor_codec.h"
+#include "sensor_module.h"
+
+static double now_seconds(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+static SensorEncoder encoder;
+static uint8_t block[SENSOR_CODEC_MAX_BLOCK_SIZE];
+static TelemetrySample decoded[SENSOR_CODEC_MAX_SAMPLES];
+
+// Rounds to a multiple of step, as a sensor with that resolution would report
+static float quantize(double value, double step)
+{
+    return (float)(round(value / step) * step);
+}
+
+static void make_flight(TelemetrySample *samples, size_t count)
+{
+    uint64_t timestamp = 1000000000;
+    for (size_t i = 0; i < count; ++i)
+    {
+        double t = (double)i / 1000.0;
+        timestamp += 1000000 + (uint64_t)(rand() % 3) * 1000; // 1 ms, 0-2 us late
+        samples[i].timestamp_ns = timestamp;
+        samples[i].source = 0;
+        samples[i].data.altitude_m = quantize(1000.0 + 2.0 * t, 0.5);                      // Climb at 2 m/s
+        samples[i].data.airspeed_kmh = (int16_t)lround(300.0 + 8.0 * sin(t * 0.7) + (rand() % 3 - 1));
+        samples[i].data.temperature_c = quantize(15.0 - 0.013 * 2.0 * t, 0.25);            // Lapse rate
+        samples[i].data.status_flags = (i / 20000) % 2 ? SENSOR_STATUS_OK | SENSOR_STATUS_LOW_BATTERY
+                                                       : SENSOR_STATUS_OK;
+    }
+}
+
+static void make_random(TelemetrySample *samples, size_t count)
+{
+    for (size_t i = 0; i < count; ++i)
+    {
+        samples[i].timestamp_ns = 1000000000 + (uint64_t)i * 1000000;
+        samples[i].source = 0;
+        samples[i].data = sensor_read_data();
+    }
+}
+
+static bool same_sample(const TelemetrySample *a, const TelemetrySample *b)
+{
+    return a->timestamp_ns == b->timestamp_ns && a->source == b->source &&
+           a->data.airspeed_kmh == b->data.airspeed_kmh && a->data.status_flags == b->data.status_flags &&
+           memcmp(&a->data.altitude_m, &b->data.altitude_m, sizeof(float)) == 0 &&
+           memcmp(&a->data.temperature_c, &b->data.temperature_c, sizeof(float)) == 0;
+}
+
+static void run(const char *label, const TelemetrySample *samples, size_t count)
+{
+    // Size and round trip
+    uint64_t encoded_bytes = 0;
+    uint64_t mismatches = 0;
+    for (size_t start = 0; start < count; start += SENSOR_CODEC_MAX_SAMPLES)
+    {
+        size_t n = count - start < SENSOR_CODEC_MAX_SAMPLES ? count - start : SENSOR_CODEC_MAX_SAMPLES;
+        for (size_t i = 0; i < n; ++i)
+            sensor_encoder_append(&encoder, &samples[start + i]);
+        size_t size = sensor_encoder_finish(&encoder, block, sizeof(block));
+        encoded_bytes += size;
+        if (sensor_codec_decode(block, size, decoded, SENSOR_CODEC_MAX_SAMPLES) != n)
+        {
+            mismatches += n;
+            continue;
+        }
+        for (size_t i = 0; i < n; ++i)
+            mismatches += !same_sample(&decoded[i], &samples[start + i]);
+    }
+
+    // Throughput: encode, then decode, the first block's worth over and over
+    size_t n = count < SENSOR_CODEC_MAX_SAMPLES ? count : SENSOR_CODEC_MAX_SAMPLES;
+    size_t rounds = 2000;
+    size_t size = 0;
+    double start = now_seconds();
+    for (size_t r = 0; r < rounds; ++r)
+    {
+        for (size_t i = 0; i < n; ++i)
+            sensor_encoder_append(&encoder, &samples[i]);
+        size = sensor_encoder_finish(&encoder, block, sizeof(block));
+    }
+    double encode_seconds = now_seconds() - start;
+    size_t sink = 0;
+    start = now_seconds();
+    for (size_t r = 0; r < rounds; ++r)
+        sink += sensor_codec_decode(block, size, decoded, SENSOR_CODEC_MAX_SAMPLES);
+    double decode_seconds = now_seconds() - start;
+
+    double total = (double)(n * rounds);
+    printf("%-34s %6.2f bytes/sample (%4.1fx vs %d)  encode %6.1f M samples/s  decode %6.1f M samples/s  %llu mismatches%s\n",
+           label, (double)encoded_bytes / (double)count,
+           (double)TELEMETRY_SAMPLE_WIRE_SIZE * (double)count / (double)encoded_bytes, TELEMETRY_SAMPLE_WIRE_SIZE,
+           total / encode_seconds / 1e6, total / decode_seconds / 1e6, (unsigned long long)mismatches,
+           sink == total ? "" : " (decode failed)");
+}
+
+int main(int argc, char *argv[])
+{
+    size_t count = argc > 1 ? (size_t)atol(argv[1]) : 100000;
+    if (count == 0)
+        count = 1;
+    TelemetrySample *samples = malloc(count * sizeof(TelemetrySample));
+    if (!samples)
+    {
+        fprintf(stderr, "Error: Out of memory.\n");
+        return 1;
+    }
+    sensor_init();
+    sensor_encoder_reset(&encoder);
+
+    make_flight(samples, count);
+    run("Steady flight, 1 kHz", samples, count);
+    make_random(samples, count);
+    run("sensor_read_data() (random)", samples, count);
+
+    free(samples);
+    return 0;
+}
@@ -1,25 +1,186 @@
 #include "sensor_module.h" // Include our own header file
+#include <stdatomic.h>     // For the seed shared with every thread's generator
+#include <stdbool.h>       // For bool type
 #include <stdio.h>         // For printf (standard input/output)
-#include <stdlib.h>        // For rand() (standard library for general utilities)
-#include <time.h>          // For time() to seed rand()
+#include <time.h>          // For time() to seed the generators
 
 // --- Static Global Variable (Module-Specific State) ---
 // 'static' when used at file scope (outside any function) limits the visibility
 // of this variable to this .c file only. It cannot be accessed directly from other files.
 static int sensor_initialized = 0; // 0 for false, 1 for true
 
+// Seed for the threads' generators. Each sensor_init call bumps the generation, so
+// every thread reseeds its generator on its next reading.
+static atomic_uint_fast64_t sensor_seed;
+static atomic_uint sensor_seed_generation;
+static atomic_uint sensor_thread_count; // Threads that have read since the last seeding
+
+// sensor_read_data's generator: one per thread, so readers never share state
+static _Thread_local SensorRng thread_rng;
+static _Thread_local unsigned thread_rng_generation; // 0: not seeded yet
+
+// --- Random Number Generators ---
+
+// SplitMix64 step: turns any seed (even 0 or 1) into well-mixed state words
+static uint64_t splitmix64(uint64_t *x)
+{
+    uint64_t z = (*x += 0x9E3779B97F4A7C15ull);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+    return z ^ (z >> 31);
+}
+
+static inline uint64_t rotl64(uint64_t x, int k)
+{
+    return (x << k) | (x >> (64 - k));
+}
+
+static inline uint64_t xoshiro256ss_next(uint64_t *s)
+{
+    uint64_t result = rotl64(s[1] * 5, 7) * 9;
+    uint64_t t = s[1] << 17;
+    s[2] ^= s[0];
+    s[3] ^= s[1];
+    s[1] ^= s[2];
+    s[0] ^= s[3];
+    s[2] ^= t;
+    s[3] = rotl64(s[3], 45);
+    return result;
+}
+
+static inline uint32_t pcg32_next(uint64_t *s)
+{
+    uint64_t old = s[0];
+    s[0] = old * 6364136223846793005ull + s[1];
+    uint32_t xorshifted = (uint32_t)(((old >> 18) ^ old) >> 27);
+    uint32_t rot = (uint32_t)(old >> 59);
+    return (xorshifted >> rot) | (xorshifted << ((32 - rot) & 31));
+}
+
+static inline uint64_t pcg32_next64(uint64_t *s)
+{
+    uint64_t high = pcg32_next(s);
+    return high << 32 | pcg32_next(s);
+}
+
+void sensor_rng_seed(SensorRng *rng, SensorRngKind kind, uint64_t seed)
+{
+    rng->kind = kind;
+    if (kind == SENSOR_RNG_PCG32)
+    {
+        // pcg32_srandom: pick a stream, then advance past the seed
+        rng->state[0] = 0;
+        rng->state[1] = (splitmix64(&seed) << 1) | 1;
+        pcg32_next(rng->state);
+        rng->state[0] += splitmix64(&seed);
+        pcg32_next(rng->state);
+        rng->state[2] = rng->state[3] = 0;
+        return;
+    }
+    rng->kind = SENSOR_RNG_XOSHIRO256SS;
+    for (int i = 0; i < 4; ++i)
+        rng->state[i] = splitmix64(&seed); // Never all zero
+}
+
+uint64_t sensor_rng_next(SensorRng *rng)
+{
+    return rng->kind == SENSOR_RNG_PCG32 ? pcg32_next64(rng->state) : xoshiro256ss_next(rng->state);
+}
+
+// --- Simulated Readings ---
+
+// Uniform in [0, n) from 32 random bits, without a division (Lemire's multiply-shift)
+static inline uint32_t below(uint32_t bits, uint32_t n)
+{
+    return (uint32_t)(((uint64_t)bits * n) >> 32);
+}
+
+// One reading from three 64-bit draws, each split into two 32-bit halves
+static inline SensorData make_reading(uint64_t a, uint64_t b, uint64_t c)
+{
+    SensorData data;
+    data.altitude_m = 1000.0f + (float)below((uint32_t)a, 500) - 250.0f;             // Base 1000m +/- 250m
+    data.airspeed_kmh = (int16_t)(300 + (int)below((uint32_t)(a >> 32), 100) - 50); // Base 300kmh +/- 50kmh
+    data.temperature_c = 15.0f + (float)below((uint32_t)b, 20) - 10.0f;              // Base 15C +/- 10C
+
+    // Simulate status flags
+    data.status_flags = SENSOR_STATUS_OK; // Start with OK
+    if (below((uint32_t)(b >> 32), 10) == 0)
+    {                                                   // 10% chance of low battery
+        data.status_flags |= SENSOR_STATUS_LOW_BATTERY; // Use bitwise OR to set a flag
+    }
+    if (below((uint32_t)c, 20) == 0)
+    { // 5% chance of general error
+        data.status_flags |= SENSOR_STATUS_ERROR;
+        data.status_flags &= ~SENSOR_STATUS_OK; // Use bitwise AND with NOT to clear OK flag
+    }
+    if (below((uint32_t)(c >> 32), 5) == 0)
+    { // 20% chance it needs calibration
+        data.status_flags |= SENSOR_STATUS_NEEDS_CAL;
+    }
+    return data;
+}
+
+SensorData sensor_read_data_from(SensorRng *rng)
+{
+    // Drawn one at a time: the order of function arguments is unspecified
+    uint64_t a = sensor_rng_next(rng);
+    uint64_t b = sensor_rng_next(rng);
+    uint64_t c = sensor_rng_next(rng);
+    return make_reading(a, b, c);
+}
+
+void sensor_read_batch(SensorRng *rng, SensorData *out, size_t count)
+{
+    // Pick the generator once, then run a loop with its step inlined
+    uint64_t state[4] = {rng->state[0], rng->state[1], rng->state[2], rng->state[3]};
+    if (rng->kind == SENSOR_RNG_PCG32)
+    {
+        for (size_t i = 0; i < count; ++i)
+        {
+            uint64_t a = pcg32_next64(state);
+            uint64_t b = pcg32_next64(state);
+            uint64_t c = pcg32_next64(state);
+            out[i] = make_reading(a, b, c);
+        }
+    }
+    else
+    {
+        for (size_t i = 0; i < count; ++i)
+        {
+            uint64_t a = xoshiro256ss_next(state);
+            uint64_t b = xoshiro256ss_next(state);
+            uint64_t c = xoshiro256ss_next(state);
+            out[i] = make_reading(a, b, c);
+        }
+    }
+    for (int i = 0; i < 4; ++i)
+        rng->state[i] = state[i];
+}
+
 // --- Function Definitions (Implementations) ---
 
 void sensor_init(void)
 {
-    // Seed the random number generator once
+    // Seed the generators once
     // This makes our simulated sensor readings a bit different each run.
     // time(NULL) gets the current time, used as a seed.
-    srand(time(NULL));
+    atomic_store(&sensor_seed, (uint64_t)time(NULL));
+    atomic_store(&sensor_thread_count, 0);
+    atomic_fetch_add(&sensor_seed_generation, 1);
     sensor_initialized = 1;
     printf("Sensor Module Initialized.\n");
 }
 
+void sensor_init_seeded(unsigned int seed)
+{
+    atomic_store(&sensor_seed, seed);
+    atomic_store(&sensor_thread_count, 0);
+    atomic_fetch_add(&sensor_seed_generation, 1);
+    sensor_initialized = 1;
+    printf("Sensor Module Initialized (seed %u).\n", seed);
+}
+
 SensorData sensor_read_data(void)
 {
     SensorData data;
@@ -35,28 +196,17 @@ SensorData sensor_read_data(void)
         return data;
     }
 
-    // Simulate sensor readings with some randomness
-    data.altitude_m = 1000.0f + (rand() % 500) - 250.0f; // Base 1000m +/- 250m
-    data.airspeed_kmh = 300 + (rand() % 100) - 50;       // Base 300kmh +/- 50kmh
-    data.temperature_c = 15.0f + (rand() % 20) - 10.0f;  // Base 15C +/- 10C
-
-    // Simulate status flags
-    data.status_flags = SENSOR_STATUS_OK; // Start with OK
-    if (rand() % 10 == 0)
-    {                                                   // 10% chance of low battery
-        data.status_flags |= SENSOR_STATUS_LOW_BATTERY; // Use bitwise OR to set a flag
-    }
-    if (rand() % 20 == 0)
-    { // 5% chance of general error
-        data.status_flags |= SENSOR_STATUS_ERROR;
-        data.status_flags &= ~SENSOR_STATUS_OK; // Use bitwise AND with NOT to clear OK flag
-    }
-    if (rand() % 5 == 0)
-    { // 20% chance it needs calibration
-        data.status_flags |= SENSOR_STATUS_NEEDS_CAL;
+    // (Re)seed this thread's generator after sensor_init: the seed plus the order in
+    // which threads first read, so no two threads share a sequence
+    unsigned generation = atomic_load_explicit(&sensor_seed_generation, memory_order_acquire);
+    if (thread_rng_generation != generation)
+    {
+        uint64_t mix = atomic_load(&sensor_seed);
+        uint64_t thread_index = atomic_fetch_add(&sensor_thread_count, 1);
+        sensor_rng_seed(&thread_rng, SENSOR_RNG_XOSHIRO256SS, splitmix64(&mix) ^ thread_index);
+        thread_rng_generation = generation;
     }
-
-    return data;
+    return sensor_read_data_from(&thread_rng);
 }
 
 void sensor_process_status_flags(uint8_t flags)
@@ -1,6 +1,7 @@
 #ifndef SENSOR_MODULE_H_
 #define SENSOR_MODULE_H_
 
+#include <stddef.h> // For size_t
 #include <stdint.h> // For fixed-width integers like uint8_t, int16_t, float is also common
 
 // --- Constants for Sensor Status Flags (Bit Positions) ---
@@ -22,7 +23,25 @@ typedef struct
     uint8_t status_flags; // A byte to hold various status bits (using #defines above)
 } SensorData;
 
-// --- Function Declarations (Prototypes) ---
+// --- Random Number Generators ---
+// Simulated readings are drawn from a small generator that each simulated sensor
+// (or thread) owns. rand() keeps one hidden state for the whole process behind a
+// lock, so threads simulating sensors would queue up on it; with one generator
+// each they share nothing and scale with the number of cores.
+// Both generators pass the usual statistical test suites and cost a few ns a number.
+typedef enum
+{
+    SENSOR_RNG_XOSHIRO256SS = 0, // xoshiro256** (Blackman & Vigna): 64 bits per step, the default
+    SENSOR_RNG_PCG32 = 1,        // PCG-XSH-RR (O'Neill): 32 bits per step, 16 bytes of state
+} SensorRngKind;
+
+typedef struct
+{
+    SensorRngKind kind;
+    uint64_t state[4]; // xoshiro256**: all four words. PCG32: state[0] is the state, state[1] the stream increment
+} SensorRng;
+
+
 // These tell the compiler about the functions that will be implemented elsewhere (in sensor_module.c).
 // This is key for multi-file projects.
 
@@ -32,12 +51,52 @@ typedef struct
  */
 void sensor_init(void);
 
+/**
+ * @brief Initializes the sensor module with a fixed seed instead of the time, so the
+ * simulated readings are the same on every run (for replay and benchmarks).
+ * @param seed Seed for the simulated readings.
+ */
+void sensor_init_seeded(unsigned int seed);
+
 /**
  * @brief Simulates reading data from the flight sensor.
+ * Draws from a generator owned by the calling thread, seeded from the sensor_init
+ * seed, so it is safe to call from several threads. With sensor_init_seeded, the
+ * first thread to read gets the same readings on every run.
  * @return A SensorData struct populated with new readings.
  */
 SensorData sensor_read_data(void);
 
+/**
+ * @brief Seeds a generator. The same kind and seed always give the same sequence.
+ * @param rng The generator.
+ * @param kind Which algorithm it runs.
+ * @param seed Any value; it is spread over the whole state, so 0, 1, 2... are fine.
+ */
+void sensor_rng_seed(SensorRng *rng, SensorRngKind kind, uint64_t seed);
+
+/**
+ * @brief Next 64 random bits from a generator (two steps for PCG32).
+ */
+uint64_t sensor_rng_next(SensorRng *rng);
+
+/**
+ * @brief Simulates reading the flight sensor, drawing from the caller's generator.
+ *        Safe to call from any number of threads, each with its own generator.
+ * @param rng The generator.
+ * @return A SensorData struct populated with new readings.
+ */
+SensorData sensor_read_data_from(SensorRng *rng);
+
+/**
+ * @brief Simulates count readings at once: the same readings as calling
+ *        sensor_read_data_from count times, at a fraction of the cost per reading.
+ * @param rng The generator.
+ * @param out Receives the readings.
+ * @param count Number of readings.
+ */
+void sensor_read_batch(SensorRng *rng, SensorData *out, size_t count);
+
 /**
  * @brief Processes and prints messages based on sensor status flags.
  * Demonstrates bitwise operations.
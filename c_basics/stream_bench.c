@@ -0,0 +1,155 @@
+// Benchmark for the streaming command-link decoder.
+//
+// Usage: stream_bench [megabytes] [seed]
+//
+// Builds a stream of back-to-back packets with random payload lengths, with one
+// frame in a thousand corrupted and a few bytes of line noise in between, then
+// decodes it twice: fed directly to the parser in random-sized chunks, and through
+// a ByteRing with a producer thread writing and the main thread draining. Reports
+// MB/s and packets/s for both and checks that both saw the same packets.
+
+#define _POSIX_C_SOURCE 200809L // For clock_gettime and sched_yield
+
+#include <pthread.h>
+#include <sched.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "byte_ring.h"
+#include "packet_stream.h"
+
+static double now_seconds(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+static uint64_t next_random(uint64_t *state)
+{
+    // splitmix64: plenty for test data
+    uint64_t z = (*state += 0x9E3779B97F4A7C15ull);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+    return z ^ (z >> 31);
+}
+
+static void count_packet(const PacketView *packet, void *user_data)
+{
+    uint64_t *sum = (uint64_t *)user_data;
+    *sum += packet_view_type(packet) + packet_view_payload_length(packet);
+}
+
+// --- Threaded Producer ---
+
+typedef struct
+{
+    ByteRing *ring;
+    const uint8_t *data;
+    size_t length;
+} ProducerArgs;
+
+static void *produce(void *arg)
+{
+    ProducerArgs *args = (ProducerArgs *)arg;
+    size_t sent = 0;
+    uint64_t rng = 7;
+    while (sent < args->length)
+    {
+        size_t chunk = 1 + next_random(&rng) % 4096; // Receive sizes vary like a real link's
+        if (chunk > args->length - sent)
+            chunk = args->length - sent;
+        size_t written = byte_ring_write(args->ring, args->data + sent, chunk);
+        if (written == 0)
+            sched_yield(); // Ring full: let the consumer catch up
+        sent += written;
+    }
+    return NULL;
+}
+
+static void report(const char *label, double seconds, size_t bytes, const PacketStreamParser *parser)
+{
+    printf("%-8s %8.1f MB/s  %6.2f M packets/s  (%llu ok, %llu checksum errors, %llu skipped bytes)\n", label,
+           (double)bytes / seconds / 1e6, (double)parser->stats.packets_ok / seconds / 1e6,
+           (unsigned long long)parser->stats.packets_ok, (unsigned long long)parser->stats.checksum_errors,
+           (unsigned long long)parser->stats.bytes_skipped);
+}
+
+int main(int argc, char *argv[])
+{
+    size_t megabytes = argc > 1 ? strtoul(argv[1], NULL, 10) : 64;
+    uint64_t rng = argc > 2 ? strtoull(argv[2], NULL, 10) : 42;
+    size_t capacity = megabytes * 1000 * 1000;
+
+    // --- Build the stream ---
+    uint8_t *stream = malloc(capacity + PACKET_MAX_WIRE_SIZE);
+    if (!stream)
+    {
+        fprintf(stderr, "Error: Could not allocate %zu MB.\n", megabytes);
+        return 1;
+    }
+    size_t length = 0;
+    size_t frames = 0;
+    while (length + PACKET_MAX_WIRE_SIZE + 2 <= capacity)
+    {
+        uint64_t bits = next_random(&rng);
+        uint8_t payload[MAX_PAYLOAD_SIZE];
+        uint8_t payload_length = (uint8_t)((bits >> 8) % (MAX_PAYLOAD_SIZE + 1));
+        for (uint8_t i = 0; i < payload_length; ++i)
+            payload[i] = (uint8_t)(bits >> (16 + i % 6 * 8));
+        size_t size = command_build_packet(stream + length, PACKET_MAX_WIRE_SIZE, (CommandType)(1 + bits % 3),
+                                           payload, payload_length, INTEGRITY_XOR8);
+        if ((bits >> 40) % 1000 == 0)
+            stream[length + size - 1] ^= 0x5A; // Corrupt the checksum
+        length += size;
+        if ((bits >> 48) % 100 == 0)
+            stream[length++] = 0x00; // Line noise between frames
+        frames++;
+    }
+    printf("stream: %zu bytes, %zu frames\n", length, frames);
+
+    // --- Direct feed, random chunk sizes ---
+    uint64_t direct_sum = 0;
+    PacketStreamParser direct;
+    packet_stream_init(&direct, count_packet, &direct_sum);
+    double start = now_seconds();
+    for (size_t fed = 0; fed < length;)
+    {
+        size_t chunk = 1 + next_random(&rng) % 4096;
+        if (chunk > length - fed)
+            chunk = length - fed;
+        packet_stream_feed(&direct, stream + fed, chunk);
+        fed += chunk;
+    }
+    report("feed", now_seconds() - start, length, &direct);
+
+    // --- Producer thread -> ByteRing -> decoder ---
+    static uint8_t ring_storage[1 << 20];
+    ByteRing ring;
+    byte_ring_init(&ring, ring_storage, sizeof(ring_storage));
+    uint64_t ring_sum = 0;
+    PacketStreamParser threaded;
+    packet_stream_init(&threaded, count_packet, &ring_sum);
+    ProducerArgs args = {&ring, stream, length};
+    pthread_t producer;
+    start = now_seconds();
+    if (pthread_create(&producer, NULL, produce, &args) != 0)
+    {
+        fprintf(stderr, "Error: Could not start the producer thread.\n");
+        free(stream);
+        return 1;
+    }
+    while (threaded.stats.bytes_received < length)
+    {
+        if (packet_stream_drain(&threaded, &ring) == 0 && byte_ring_size(&ring) == 0)
+            sched_yield(); // Ring empty: let the producer run
+    }
+    pthread_join(producer, NULL);
+    report("ring", now_seconds() - start, length, &threaded);
+
+    int same = direct_sum == ring_sum && direct.stats.packets_ok == threaded.stats.packets_ok;
+    printf("results %s\n", same ? "match" : "DIFFER");
+    free(stream);
+    return same ? 0 : 1;
+}
@@ -0,0 +1,477 @@
+#define _POSIX_C_SOURCE 200809L // For clock_nanosleep
+
+#include "telemetry.h"
+#include <errno.h>  // For EINTR
+#include <sched.h>  // For sched_yield
+#include <string.h> // For memcpy and memset
+#include <time.h>   // For clock_nanosleep
+#include <unistd.h> // For write
+
+_Static_assert((TELEMETRY_SAMPLE_QUEUE_SIZE & (TELEMETRY_SAMPLE_QUEUE_SIZE - 1)) == 0, "power of two");
+_Static_assert((TELEMETRY_BATCH_QUEUE_SIZE & (TELEMETRY_BATCH_QUEUE_SIZE - 1)) == 0, "power of two");
+
+// --- Idle Waiting ---
+// A stage with nothing to do yields a few times (work usually arrives within
+// microseconds) and then sleeps briefly, so an idle pipeline does not spin a core.
+#define IDLE_YIELDS 64
+#define IDLE_SLEEP_NS 50000
+
+static void idle_wait(unsigned *idle_rounds)
+{
+    if (*idle_rounds < IDLE_YIELDS)
+    {
+        (*idle_rounds)++;
+        sched_yield();
+        return;
+    }
+    struct timespec pause = {0, IDLE_SLEEP_NS};
+    nanosleep(&pause, NULL);
+}
+
+// --- SampleQueue (multi-producer, single consumer) ---
+
+static void sample_queue_init(SampleQueue *queue)
+{
+    for (size_t i = 0; i < TELEMETRY_SAMPLE_QUEUE_SIZE; ++i)
+        atomic_store_explicit(&queue->cells[i].sequence, i, memory_order_relaxed);
+    atomic_store_explicit(&queue->enqueue_pos, 0, memory_order_relaxed);
+    queue->dequeue_pos = 0;
+}
+
+// Returns false if the queue is full
+static bool sample_queue_push(SampleQueue *queue, const TelemetrySample *sample)
+{
+    size_t pos = atomic_load_explicit(&queue->enqueue_pos, memory_order_relaxed);
+    SampleCell *cell;
+    for (;;)
+    {
+        cell = &queue->cells[pos & (TELEMETRY_SAMPLE_QUEUE_SIZE - 1)];
+        size_t sequence = atomic_load_explicit(&cell->sequence, memory_order_acquire);
+        intptr_t diff = (intptr_t)sequence - (intptr_t)pos;
+        if (diff == 0)
+        {
+            // The cell is free for position `pos`: try to claim it
+            if (atomic_compare_exchange_weak_explicit(&queue->enqueue_pos, &pos, pos + 1, memory_order_relaxed,
+                                                      memory_order_relaxed))
+                break;
+        }
+        else if (diff < 0)
+        {
+            return false; // The consumer has not emptied this cell since the last lap
+        }
+        else
+        {
+            pos = atomic_load_explicit(&queue->enqueue_pos, memory_order_relaxed); // Another producer won
+        }
+    }
+    cell->sample = *sample;
+    atomic_store_explicit(&cell->sequence, pos + 1, memory_order_release); // Hand the cell to the consumer
+    return true;
+}
+
+static bool sample_queue_pop(SampleQueue *queue, TelemetrySample *out)
+{
+    SampleCell *cell = &queue->cells[queue->dequeue_pos & (TELEMETRY_SAMPLE_QUEUE_SIZE - 1)];
+    if (atomic_load_explicit(&cell->sequence, memory_order_acquire) != queue->dequeue_pos + 1)
+        return false;
+    *out = cell->sample;
+    // Free the cell for the producers' next lap
+    atomic_store_explicit(&cell->sequence, queue->dequeue_pos + TELEMETRY_SAMPLE_QUEUE_SIZE, memory_order_release);
+    queue->dequeue_pos++;
+    return true;
+}
+
+static size_t sample_queue_depth(SampleQueue *queue)
+{
+    return atomic_load_explicit(&queue->enqueue_pos, memory_order_relaxed) - queue->dequeue_pos;
+}
+
+// --- BatchQueue (single producer, single consumer) ---
+
+static void batch_queue_init(BatchQueue *queue)
+{
+    atomic_store_explicit(&queue->head, 0, memory_order_relaxed);
+    atomic_store_explicit(&queue->tail, 0, memory_order_relaxed);
+}
+
+// The next free slot, or NULL if the sink has not released one yet
+static TelemetryBatch *batch_queue_claim(BatchQueue *queue)
+{
+    size_t head = atomic_load_explicit(&queue->head, memory_order_relaxed);
+    if (head - atomic_load_explicit(&queue->tail, memory_order_acquire) == TELEMETRY_BATCH_QUEUE_SIZE)
+        return NULL;
+    return &queue->slots[head & (TELEMETRY_BATCH_QUEUE_SIZE - 1)];
+}
+
+static void batch_queue_publish(BatchQueue *queue)
+{
+    size_t head = atomic_load_explicit(&queue->head, memory_order_relaxed);
+    atomic_store_explicit(&queue->head, head + 1, memory_order_release);
+}
+
+// The oldest published batch, or NULL if there is none
+static TelemetryBatch *batch_queue_front(BatchQueue *queue)
+{
+    size_t tail = atomic_load_explicit(&queue->tail, memory_order_relaxed);
+    if (atomic_load_explicit(&queue->head, memory_order_acquire) == tail)
+        return NULL;
+    return &queue->slots[tail & (TELEMETRY_BATCH_QUEUE_SIZE - 1)];
+}
+
+static void batch_queue_release(BatchQueue *queue)
+{
+    size_t tail = atomic_load_explicit(&queue->tail, memory_order_relaxed);
+    atomic_store_explicit(&queue->tail, tail + 1, memory_order_release);
+}
+
+// --- Sample Encoding ---
+
+static void put_u16(uint8_t *out, uint16_t value)
+{
+    out[0] = (uint8_t)value;
+    out[1] = (uint8_t)(value >> 8);
+}
+
+static void put_u32(uint8_t *out, uint32_t value)
+{
+    for (int i = 0; i < 4; ++i)
+        out[i] = (uint8_t)(value >> (8 * i));
+}
+
+static void put_u64(uint8_t *out, uint64_t value)
+{
+    for (int i = 0; i < 8; ++i)
+        out[i] = (uint8_t)(value >> (8 * i));
+}
+
+static uint32_t get_u32(const uint8_t *in)
+{
+    return (uint32_t)in[0] | (uint32_t)in[1] << 8 | (uint32_t)in[2] << 16 | (uint32_t)in[3] << 24;
+}
+
+static uint64_t get_u64(const uint8_t *in)
+{
+    return (uint64_t)get_u32(in) | (uint64_t)get_u32(in + 4) << 32;
+}
+
+static uint32_t float_bits(float value)
+{
+    uint32_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    return bits;
+}
+
+static float bits_float(uint32_t bits)
+{
+    float value;
+    memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+static void encode_sample(uint8_t *out, const TelemetrySample *sample)
+{
+    put_u64(&out[0], sample->timestamp_ns);
+    out[8] = sample->source;
+    out[9] = sample->data.status_flags;
+    put_u16(&out[10], (uint16_t)sample->data.airspeed_kmh);
+    put_u32(&out[12], float_bits(sample->data.altitude_m));
+    put_u32(&out[16], float_bits(sample->data.temperature_c));
+}
+
+size_t telemetry_decode_batch(const PacketView *packet, TelemetrySample *out, size_t max_samples)
+{
+    if (!packet || !out || packet_view_type(packet) != CMD_TELEMETRY_BATCH)
+        return 0;
+    uint16_t length = packet_view_payload_length(packet);
+    if (length % TELEMETRY_SAMPLE_WIRE_SIZE != 0)
+        return 0;
+    const uint8_t *in = packet_view_payload(packet);
+    size_t count = length / TELEMETRY_SAMPLE_WIRE_SIZE;
+    if (count > max_samples)
+        count = max_samples;
+    for (size_t i = 0; i < count; ++i, in += TELEMETRY_SAMPLE_WIRE_SIZE)
+    {
+        out[i].timestamp_ns = get_u64(&in[0]);
+        out[i].source = in[8];
+        out[i].data.status_flags = in[9];
+        out[i].data.airspeed_kmh = (int16_t)(in[10] | in[11] << 8);
+        out[i].data.altitude_m = bits_float(get_u32(&in[12]));
+        out[i].data.temperature_c = bits_float(get_u32(&in[16]));
+    }
+    return count;
+}
+
+// --- Stage Threads ---
+
+static void *sampler_main(void *arg)
+{
+    TelemetrySampler *sampler = (TelemetrySampler *)arg;
+    TelemetryPipeline *pipeline = sampler->pipeline;
+    const TelemetryConfig *config = &pipeline->config;
+    uint64_t period_ns = config->sample_rate_hz ? 1000000000u / config->sample_rate_hz : 0;
+    uint64_t next_ns = latency_now_ns();
+
+    while (!atomic_load_explicit(&pipeline->stop_requested, memory_order_relaxed) &&
+           (config->samples_per_sampler == 0 || sampler->taken < config->samples_per_sampler))
+    {
+        if (period_ns)
+        {
+            // Sleep to an absolute deadline so the rate does not drift with the work done
+            struct timespec deadline = {(time_t)(next_ns / 1000000000u), (long)(next_ns % 1000000000u)};
+            while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &deadline, NULL) == EINTR)
+                ;
+        }
+
+        TelemetrySample sample;
+        sample.timestamp_ns = latency_now_ns();
+        sample.source = sampler->source;
+        sample.data = sensor_read_data();
+        if (!sample_queue_push(&pipeline->samples, &sample))
+            sampler->dropped++;
+        sampler->taken++;
+        uint64_t done_ns = latency_now_ns();
+        latency_histogram_record(&sampler->latency, done_ns - sample.timestamp_ns);
+
+        if (period_ns)
+        {
+            next_ns += period_ns;
+            if (next_ns < done_ns)
+            {
+                // Overran: skip the missed periods instead of sampling in a burst
+                uint64_t missed = (done_ns - next_ns) / period_ns + 1;
+                sampler->missed_periods += missed;
+                next_ns += missed * period_ns;
+            }
+        }
+    }
+    return NULL;
+}
+
+typedef struct
+{
+    TelemetryPipeline *pipeline;
+    uint8_t payload[TELEMETRY_MAX_BATCH_SAMPLES * TELEMETRY_SAMPLE_WIRE_SIZE];
+    uint64_t dequeued_ns[TELEMETRY_MAX_BATCH_SAMPLES]; // When each sample left the queue
+    uint64_t oldest_sample_ns;
+    size_t count;
+} EncoderState;
+
+// Builds the current batch as a packet in the batch queue and hands it to the sink
+static void publish_batch(EncoderState *encoder)
+{
+    TelemetryPipeline *pipeline = encoder->pipeline;
+    TelemetryBatch *batch;
+    unsigned idle_rounds = 0;
+    while ((batch = batch_queue_claim(&pipeline->batches)) == NULL)
+    {
+        pipeline->stats.encoder_stalls++; // Backpressure from the sink
+        idle_wait(&idle_rounds);
+    }
+
+    batch->size = command_build_ext_packet(batch->wire, sizeof(batch->wire), CMD_TELEMETRY_BATCH, encoder->payload,
+                                           (uint16_t)(encoder->count * TELEMETRY_SAMPLE_WIRE_SIZE),
+                                           pipeline->config.integrity);
+    batch->oldest_sample_ns = encoder->oldest_sample_ns;
+    batch->published_ns = latency_now_ns();
+    batch_queue_publish(&pipeline->batches);
+
+    for (size_t i = 0; i < encoder->count; ++i)
+        latency_histogram_record(&pipeline->stats.batch, batch->published_ns - encoder->dequeued_ns[i]);
+    pipeline->stats.samples_encoded += encoder->count;
+    encoder->count = 0;
+}
+
+static void *encoder_main(void *arg)
+{
+    EncoderState encoder;
+    encoder.pipeline = (TelemetryPipeline *)arg;
+    encoder.count = 0;
+    encoder.oldest_sample_ns = 0;
+    TelemetryPipeline *pipeline = encoder.pipeline;
+    uint64_t max_delay_ns = (uint64_t)pipeline->config.max_batch_delay_us * 1000u;
+    unsigned idle_rounds = 0;
+
+    for (;;)
+    {
+        // Read the flag before popping: once it is set, every sample has been pushed,
+        // so a failed pop after it means the queue is drained for good.
+        bool samplers_done = atomic_load_explicit(&pipeline->samplers_done, memory_order_acquire);
+        size_t depth = sample_queue_depth(&pipeline->samples);
+        if (depth > pipeline->stats.sample_queue_peak)
+            pipeline->stats.sample_queue_peak = depth;
+
+        TelemetrySample sample;
+        if (sample_queue_pop(&pipeline->samples, &sample))
+        {
+            idle_rounds = 0;
+            uint64_t now_ns = latency_now_ns();
+            latency_histogram_record(&pipeline->stats.queue, now_ns - sample.timestamp_ns);
+            if (encoder.count == 0 || sample.timestamp_ns < encoder.oldest_sample_ns)
+                encoder.oldest_sample_ns = sample.timestamp_ns;
+            encode_sample(&encoder.payload[encoder.count * TELEMETRY_SAMPLE_WIRE_SIZE], &sample);
+            encoder.dequeued_ns[encoder.count++] = now_ns;
+            if (encoder.count == pipeline->config.batch_samples)
+                publish_batch(&encoder);
+            continue;
+        }
+
+        if (encoder.count > 0 && (samplers_done || latency_now_ns() - encoder.oldest_sample_ns >= max_delay_ns))
+            publish_batch(&encoder);
+        if (samplers_done)
+            break;
+        idle_wait(&idle_rounds);
+    }
+    atomic_store_explicit(&pipeline->encoder_done, true, memory_order_release);
+    return NULL;
+}
+
+// Writes all of a buffer, retrying after partial writes and signals
+static bool write_all(int fd, const uint8_t *data, size_t length)
+{
+    while (length > 0)
+    {
+        ssize_t written = write(fd, data, length);
+        if (written < 0)
+        {
+            if (errno == EINTR)
+                continue;
+            return false;
+        }
+        data += written;
+        length -= (size_t)written;
+    }
+    return true;
+}
+
+static void *sink_main(void *arg)
+{
+    TelemetryPipeline *pipeline = (TelemetryPipeline *)arg;
+    unsigned idle_rounds = 0;
+    for (;;)
+    {
+        bool encoder_done = atomic_load_explicit(&pipeline->encoder_done, memory_order_acquire);
+        TelemetryBatch *batch = batch_queue_front(&pipeline->batches);
+        if (!batch)
+        {
+            if (encoder_done)
+                break;
+            idle_wait(&idle_rounds);
+            continue;
+        }
+        idle_rounds = 0;
+
+        if (write_all(pipeline->config.sink_fd, batch->wire, batch->size))
+        {
+            uint64_t now_ns = latency_now_ns();
+            latency_histogram_record(&pipeline->stats.sink, now_ns - batch->published_ns);
+            latency_histogram_record(&pipeline->stats.end_to_end, now_ns - batch->oldest_sample_ns);
+            pipeline->stats.batches_sent++;
+            pipeline->stats.bytes_written += batch->size;
+        }
+        else
+        {
+            pipeline->stats.write_errors++;
+        }
+        batch_queue_release(&pipeline->batches);
+    }
+    return NULL;
+}
+
+// --- Public Functions ---
+
+bool telemetry_start(TelemetryPipeline *pipeline, const TelemetryConfig *config)
+{
+    if (!pipeline || !config || config->sampler_count == 0 || config->sampler_count > TELEMETRY_MAX_SAMPLERS ||
+        config->batch_samples == 0 || config->batch_samples > TELEMETRY_MAX_BATCH_SAMPLES ||
+        config->max_batch_delay_us > 1000000 || command_integrity_size(config->integrity) == 0 || config->sink_fd < 0)
+        return false;
+
+    memset(&pipeline->stats, 0, sizeof(pipeline->stats));
+    pipeline->config = *config;
+    sample_queue_init(&pipeline->samples);
+    batch_queue_init(&pipeline->batches);
+    atomic_store(&pipeline->stop_requested, false);
+    atomic_store(&pipeline->samplers_done, false);
+    atomic_store(&pipeline->encoder_done, false);
+
+    if (pthread_create(&pipeline->sink_thread, NULL, sink_main, pipeline) != 0)
+        return false;
+    if (pthread_create(&pipeline->encoder_thread, NULL, encoder_main, pipeline) != 0)
+    {
+        atomic_store(&pipeline->encoder_done, true);
+        pthread_join(pipeline->sink_thread, NULL);
+        return false;
+    }
+    unsigned started = 0;
+    for (; started < config->sampler_count; ++started)
+    {
+        TelemetrySampler *sampler = &pipeline->samplers[started];
+        memset(sampler, 0, sizeof(*sampler));
+        sampler->pipeline = pipeline;
+        sampler->source = (uint8_t)started;
+        if (pthread_create(&sampler->thread, NULL, sampler_main, sampler) != 0)
+            break;
+    }
+    pipeline->config.sampler_count = started; // Only join the threads that exist
+    pipeline->running = true;
+    if (started < config->sampler_count)
+    {
+        telemetry_stop(pipeline, NULL);
+        return false;
+    }
+    return true;
+}
+
+// Joins the samplers, then lets the encoder and sink drain and joins them
+static void shut_down(TelemetryPipeline *pipeline, TelemetryStats *stats)
+{
+    if (!pipeline->running)
+        return;
+    for (unsigned i = 0; i < pipeline->config.sampler_count; ++i)
+        pthread_join(pipeline->samplers[i].thread, NULL);
+    atomic_store_explicit(&pipeline->samplers_done, true, memory_order_release);
+    pthread_join(pipeline->encoder_thread, NULL);
+    pthread_join(pipeline->sink_thread, NULL);
+    pipeline->running = false;
+
+    for (unsigned i = 0; i < pipeline->config.sampler_count; ++i)
+    {
+        const TelemetrySampler *sampler = &pipeline->samplers[i];
+        pipeline->stats.samples_taken += sampler->taken;
+        pipeline->stats.samples_dropped += sampler->dropped;
+        pipeline->stats.missed_periods += sampler->missed_periods;
+        latency_histogram_merge(&pipeline->stats.sample, &sampler->latency);
+    }
+    if (stats)
+        *stats = pipeline->stats;
+}
+
+void telemetry_finish(TelemetryPipeline *pipeline, TelemetryStats *stats)
+{
+    if (pipeline)
+        shut_down(pipeline, stats);
+}
+
+void telemetry_stop(TelemetryPipeline *pipeline, TelemetryStats *stats)
+{
+    if (!pipeline)
+        return;
+    atomic_store_explicit(&pipeline->stop_requested, true, memory_order_relaxed);
+    shut_down(pipeline, stats);
+}
+
+void telemetry_print_stats(const TelemetryStats *stats, FILE *out)
+{
+    fprintf(out, "samples: %llu taken, %llu dropped (queue full), %llu missed periods, %llu encoded\n",
+            (unsigned long long)stats->samples_taken, (unsigned long long)stats->samples_dropped,
+            (unsigned long long)stats->missed_periods, (unsigned long long)stats->samples_encoded);
+    fprintf(out, "packets: %llu sent, %llu bytes, %llu write errors; encoder stalls %llu, sample queue peak %zu/%d\n",
+            (unsigned long long)stats->batches_sent, (unsigned long long)stats->bytes_written,
+            (unsigned long long)stats->write_errors, (unsigned long long)stats->encoder_stalls,
+            stats->sample_queue_peak, TELEMETRY_SAMPLE_QUEUE_SIZE);
+    latency_histogram_print(&stats->sample, "sample", out);
+    latency_histogram_print(&stats->queue, "queue", out);
+    latency_histogram_print(&stats->batch, "batch", out);
+    latency_histogram_print(&stats->sink, "sink", out);
+    latency_histogram_print(&stats->end_to_end, "end-to-end", out);
+}
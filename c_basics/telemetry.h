@@ -0,0 +1,184 @@
+#ifndef TELEMETRY_H_
+#define TELEMETRY_H_
+
+#include <pthread.h>   // For the stage threads
+#include <stdatomic.h> // For the lock-free queues
+#include <stdbool.h>   // For bool type
+#include <stddef.h>    // For size_t
+#include <stdint.h>    // For fixed-width integers
+
+#include "command_protocol.h"  // For the telemetry packets (extended frames)
+#include "latency_histogram.h" // For per-stage latency
+#include "sensor_module.h"     // For SensorData
+
+// --- Telemetry Pipeline ---
+// Sampling sensors at kHz rates cannot wait for printing or for a file write, so each
+// job runs on its own thread and the threads hand work along lock-free queues:
+//
+//   sampler threads --SampleQueue--> encoder --BatchQueue--> sink --> file/socket
+//   (1..4, at a fixed rate)          (packets)              (write())
+//
+// Samplers never block: if the encoder falls behind and the sample queue is full,
+// the sample is dropped and counted. The encoder waits for the sink when the batch
+// queue is full and counts those stalls. Each stage records its latency in a
+// histogram.
+
+// --- Constants ---
+#define TELEMETRY_MAX_SAMPLERS 4
+#define TELEMETRY_SAMPLE_QUEUE_SIZE 4096 // Samples in flight between samplers and encoder; power of two
+#define TELEMETRY_BATCH_QUEUE_SIZE 16    // Packets in flight between encoder and sink; power of two
+#define TELEMETRY_QUEUE_ALIGN 64         // Cache line: keeps producer and consumer indices apart
+
+// --- Telemetry Packets ---
+// A CMD_TELEMETRY_BATCH extended frame carries back-to-back samples of
+// TELEMETRY_SAMPLE_WIRE_SIZE bytes, all little-endian:
+//   timestamp_ns (8), source (1), status_flags (1), airspeed_kmh (2),
+//   altitude_m (4, IEEE 754 float), temperature_c (4, IEEE 754 float)
+#define TELEMETRY_SAMPLE_WIRE_SIZE 20
+#define TELEMETRY_MAX_BATCH_SAMPLES (PACKET_EXT_MAX_PAYLOAD_SIZE / TELEMETRY_SAMPLE_WIRE_SIZE)
+
+typedef struct
+{
+    uint64_t timestamp_ns; // latency_now_ns() when the sensor was read
+    uint8_t source;        // Sampler index
+    SensorData data;
+} TelemetrySample;
+
+// --- Queues (used by the pipeline; exposed for the struct layout) ---
+
+// Bounded multi-producer/single-consumer queue (D. Vyukov's design). A producer
+// claims a cell with one compare-and-swap on enqueue_pos; each cell's sequence number
+// tells the producer whether the cell is free and the consumer whether it is filled.
+typedef struct
+{
+    atomic_size_t sequence;
+    TelemetrySample sample;
+} SampleCell;
+
+typedef struct
+{
+    _Alignas(TELEMETRY_QUEUE_ALIGN) atomic_size_t enqueue_pos; // Shared by the producers
+    _Alignas(TELEMETRY_QUEUE_ALIGN) size_t dequeue_pos;        // Consumer only
+    _Alignas(TELEMETRY_QUEUE_ALIGN) SampleCell cells[TELEMETRY_SAMPLE_QUEUE_SIZE];
+} SampleQueue;
+
+// One encoded packet, built in place in the batch queue
+typedef struct
+{
+    uint64_t published_ns;     // When the encoder handed it to the sink
+    uint64_t oldest_sample_ns; // Timestamp of the oldest sample inside
+    size_t size;               // Wire bytes used
+    uint8_t wire[PACKET_EXT_MAX_WIRE_SIZE];
+} TelemetryBatch;
+
+// Single-producer/single-consumer queue of batches, indexed like ByteRing. The
+// encoder fills the next free slot where it lies and publishes it; the sink writes
+// it out from there and releases it. Nothing is copied between the two.
+typedef struct
+{
+    _Alignas(TELEMETRY_QUEUE_ALIGN) atomic_size_t head; // Batches published (encoder only)
+    _Alignas(TELEMETRY_QUEUE_ALIGN) atomic_size_t tail; // Batches released (sink only)
+    _Alignas(TELEMETRY_QUEUE_ALIGN) TelemetryBatch slots[TELEMETRY_BATCH_QUEUE_SIZE];
+} BatchQueue;
+
+// --- Configuration and Statistics ---
+
+typedef struct
+{
+    unsigned sampler_count;       // Sampler threads, 1 to TELEMETRY_MAX_SAMPLERS
+    unsigned sample_rate_hz;      // Per sampler; 0 samples as fast as possible
+    uint64_t samples_per_sampler; // Stop after this many (0: run until telemetry_stop)
+    unsigned batch_samples;       // Samples per packet, 1 to TELEMETRY_MAX_BATCH_SAMPLES
+    uint32_t max_batch_delay_us;  // Send a partial batch once its oldest sample is this old (max 1 s)
+    IntegrityMode integrity;      // Integrity code of the packets
+    int sink_fd;                  // File or socket the packets are written to
+} TelemetryConfig;
+
+typedef struct
+{
+    uint64_t samples_taken;
+    uint64_t samples_dropped;    // Sample queue full: the encoder fell behind
+    uint64_t missed_periods;     // A sampler woke up after its next deadline had passed
+    uint64_t samples_encoded;
+    uint64_t batches_sent;
+    uint64_t bytes_written;
+    uint64_t encoder_stalls;     // Waits for a free batch slot: the sink fell behind
+    uint64_t write_errors;       // Batches lost because write() failed
+    size_t sample_queue_peak;    // Deepest the sample queue got
+    LatencyHistogram sample;     // Reading the sensor and queueing the sample
+    LatencyHistogram queue;      // Sample read -> taken off the queue by the encoder
+    LatencyHistogram batch;      // Taken off the queue -> its packet handed to the sink
+    LatencyHistogram sink;       // Packet handed to the sink -> write() returned
+    LatencyHistogram end_to_end; // Oldest sample in a packet read -> packet written
+} TelemetryStats;
+
+// Per-sampler state; each sampler thread writes only its own
+typedef struct
+{
+    struct TelemetryPipeline *pipeline;
+    pthread_t thread;
+    uint8_t source;
+    uint64_t taken;
+    uint64_t dropped;
+    uint64_t missed_periods;
+    LatencyHistogram latency;
+} TelemetrySampler;
+
+// --- TelemetryPipeline Structure ---
+// Holds both queues, so it is large (~180 KiB): give it static storage.
+typedef struct TelemetryPipeline
+{
+    TelemetryConfig config;
+    SampleQueue samples;
+    BatchQueue batches;
+    atomic_bool stop_requested;  // Samplers: stop now
+    atomic_bool samplers_done;   // Encoder: no more samples will arrive
+    atomic_bool encoder_done;    // Sink: no more batches will arrive
+    TelemetrySampler samplers[TELEMETRY_MAX_SAMPLERS];
+    pthread_t encoder_thread;
+    pthread_t sink_thread;
+    TelemetryStats stats;        // Encoder and sink fields; sampler fields are summed on finish
+    bool running;
+} TelemetryPipeline;
+
+// --- Function Declarations ---
+
+/**
+ * @brief Starts the sampler, encoder and sink threads.
+ * @param pipeline Pipeline storage (static; see above).
+ * @param config Rates, batching and the sink file descriptor. Copied.
+ * @return True if all threads started, false if the configuration is invalid or a thread could not be created.
+ */
+bool telemetry_start(TelemetryPipeline *pipeline, const TelemetryConfig *config);
+
+/**
+ * @brief Waits until every sampler has taken samples_per_sampler samples, then drains
+ *        the pipeline and joins all threads. Needs samples_per_sampler > 0.
+ * @param pipeline A started pipeline.
+ * @param stats Filled with the final statistics (may be NULL).
+ */
+void telemetry_finish(TelemetryPipeline *pipeline, TelemetryStats *stats);
+
+/**
+ * @brief Stops the samplers now, then drains the pipeline and joins all threads.
+ *        Every sample already taken is still written to the sink.
+ * @param pipeline A started pipeline.
+ * @param stats Filled with the final statistics (may be NULL).
+ */
+void telemetry_stop(TelemetryPipeline *pipeline, TelemetryStats *stats);
+
+/**
+ * @brief Prints the counters and one latency line per stage.
+ */
+void telemetry_print_stats(const TelemetryStats *stats, FILE *out);
+
+/**
+ * @brief Decodes the samples of a received CMD_TELEMETRY_BATCH packet.
+ * @param packet A validated packet.
+ * @param out Receives up to max_samples samples.
+ * @param max_samples Capacity of out; TELEMETRY_MAX_BATCH_SAMPLES always suffices.
+ * @return The number of samples decoded, 0 if it is not a well-formed telemetry packet.
+ */
+size_t telemetry_decode_batch(const PacketView *packet, TelemetrySample *out, size_t max_samples);
+
+#endif // TELEMETRY_H_
@@ -0,0 +1,56 @@
+#include "ConsoleFrame.h"
+
+// --- FrameBuffer ---
+
+bool FrameBuffer::present()
+{
+    bool ok = true;
+    if (!frame_.empty())
+    {
+        std::streamsize size = static_cast<std::streamsize>(frame_.size());
+        ok = target_->sputn(frame_.data(), size) == size;
+        frame_.clear(); // Keeps its capacity for the next frame
+    }
+    return target_->pubsync() == 0 && ok;
+}
+
+int FrameBuffer::overflow(int c)
+{
+    if (c != traits_type::eof())
+    {
+        frame_ += traits_type::to_char_type(c);
+    }
+    return traits_type::not_eof(c);
+}
+
+std::streamsize FrameBuffer::xsputn(const char *data, std::streamsize count)
+{
+    frame_.append(data, static_cast<std::size_t>(count));
+    return count;
+}
+
+// --- ConsoleFrame ---
+
+namespace
+{
+// Switch the standard streams to their fast mode and return std::cout's
+// own buffer. Must run before the first console I/O to have any effect.
+std::streambuf *prepareConsole()
+{
+    std::ios::sync_with_stdio(false);
+    std::cin.tie(nullptr);
+    return std::cout.rdbuf();
+}
+} // namespace
+
+ConsoleFrame::ConsoleFrame()
+    : original_(prepareConsole()), frame_(original_)
+{
+    std::cout.rdbuf(&frame_);
+}
+
+ConsoleFrame::~ConsoleFrame()
+{
+    frame_.present();
+    std::cout.rdbuf(original_);
+}
@@ -0,0 +1,65 @@
+#ifndef CONSOLE_FRAME_H
+#define CONSOLE_FRAME_H
+
+#include <iostream>
+#include <streambuf>
+#include <string>
+
+/**
+ * @brief Collects console output into one frame and writes it in one go.
+ *
+ * Everything written to the stream is appended to an in-memory frame. The
+ * frame is only handed to the real output (and flushed) when the stream is
+ * flushed, i.e. on std::flush or when something tied to the stream needs it
+ * (std::cerr is tied to std::cout). Console programs write their output for a
+ * command with '\n' and flush once, right after printing the prompt and
+ * before reading input, so each command costs one write instead of one per
+ * line.
+ */
+class FrameBuffer : public std::streambuf
+{
+public:
+    explicit FrameBuffer(std::streambuf *target) : target_(target) {}
+
+    // Write the pending frame to the target and flush it. Returns false if
+    // the target refused any of it.
+    bool present();
+    std::size_t pending() const { return frame_.size(); }
+
+protected:
+    int overflow(int c) override;
+    std::streamsize xsputn(const char *data, std::streamsize count) override;
+    int sync() override { return present() ? 0 : -1; }
+
+private:
+    std::streambuf *target_;
+    std::string frame_;
+};
+
+/**
+ * @brief Sets up fast console I/O for the lifetime of the object.
+ *
+ * Create one at the top of main(), before any other console I/O. It turns
+ * off C stdio synchronization, unties std::cin from std::cout (reading input
+ * no longer flushes output behind your back) and routes std::cout through a
+ * FrameBuffer. Flush std::cout after printing a prompt so it shows up before
+ * the program waits for input. Destroying it presents anything still
+ * pending and restores std::cout.
+ */
+class ConsoleFrame
+{
+public:
+    ConsoleFrame();
+    ~ConsoleFrame();
+
+    ConsoleFrame(const ConsoleFrame &) = delete;
+    ConsoleFrame &operator=(const ConsoleFrame &) = delete;
+
+    FrameBuffer &buffer() { return frame_; }
+
+private:
+    std::streambuf *original_;
+    FrameBuffer frame_;
+};
+
+#endif // CONSOLE_FRAME_H
@@ -0,0 +1,48 @@
+#include "Bot.h"
+#include "Player.h"
+#include "Room.h"
+#include <iterator> // For std::next
+
+RandomWalkBot::RandomWalkBot(const Player &player, std::uint64_t seed, std::size_t maxCommands)
+    : player_(player), rng_(seed), remaining_(maxCommands)
+{
+}
+
+bool RandomWalkBot::nextCommand(std::string &line)
+{
+    if (remaining_ == 0)
+    {
+        return false;
+    }
+    --remaining_;
+
+    const Room &room = *player_.location();
+    const ItemContainer &floor = room.getItems();
+    const ItemContainer &inventory = player_.inventory();
+    std::size_t roll = pick(100);
+
+    if (roll < 60 && !room.getExits().empty())
+    {
+        auto exit = std::next(room.getExits().begin(), pick(room.getExits().size()));
+        line = "go " + exit->first;
+    }
+    else if (roll < 75 && !floor.empty())
+    {
+        ItemId id = floor.stacks()[pick(floor.size())].id;
+        line = "take " + floor.registry().name(id);
+    }
+    else if (roll < 90 && !inventory.empty())
+    {
+        ItemId id = inventory.stacks()[pick(inventory.size())].id;
+        line = "drop " + inventory.registry().name(id);
+    }
+    else if (roll < 95)
+    {
+        line = "look";
+    }
+    else
+    {
+        line = "inventory";
+    }
+    return true;
+}
@@ -0,0 +1,36 @@
+#ifndef BOT_H
+#define BOT_H
+
+#include "Game.h"
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <string>
+
+class Player;
+
+/**
+ * @brief A seeded random-walk bot that plays the game as a CommandSource.
+ *
+ * It looks at the player's current room and inventory to pick a plausible
+ * command (mostly walking through a random exit, sometimes taking, dropping
+ * or looking around). Choices only use raw std::mt19937_64 output, so the
+ * same seed and world produce the same command stream on every platform.
+ */
+class RandomWalkBot : public CommandSource
+{
+public:
+    RandomWalkBot(const Player &player, std::uint64_t seed, std::size_t maxCommands);
+
+    bool nextCommand(std::string &line) override;
+
+private:
+    const Player &player_;
+    std::mt19937_64 rng_;
+    std::size_t remaining_;
+
+    // Uniform-enough pick in [0, n) for small n.
+    std::size_t pick(std::size_t n) { return static_cast<std::size_t>(rng_() % n); }
+};
+
+#endif // BOT_H
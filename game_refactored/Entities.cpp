@@ -0,0 +1,22 @@
+#include "Entities.h"
+
+EntityId EntityStore::create(const std::string &name, const std::string &description)
+{
+    EntityId id = static_cast<EntityId>(names_.size());
+    names_.push_back(name);
+    descriptions_.push_back(description);
+    locations_.push_back(kNoEntity);
+    containerSlots_.push_back(kNoContainer);
+    return id;
+}
+
+ItemContainer &EntityStore::addContainer(EntityId id, const ItemRegistry &registry)
+{
+    if (!hasContainer(id))
+    {
+        containerSlots_[id] = static_cast<std::uint32_t>(containers_.size());
+        containers_.emplace_back(registry);
+        containerOwners_.push_back(id);
+    }
+    return container(id);
+}
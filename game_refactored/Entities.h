@@ -0,0 +1,69 @@
+#ifndef ENTITIES_H
+#define ENTITIES_H
+
+#include "ItemContainer.h"
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <vector>
+
+// Every room, item prototype and player is an entity: just an index into
+// the component arrays below.
+using EntityId = std::uint32_t;
+constexpr EntityId kNoEntity = std::numeric_limits<EntityId>::max();
+
+/**
+ * @brief Entity-component storage for the game world.
+ *
+ * Components live in dense arrays indexed by EntityId instead of inside
+ * per-object heap allocations with virtual getters:
+ *  - name, description: every entity has them
+ *  - location: the entity this one is inside (players -> their room),
+ *    or kNoEntity
+ *  - container: optional; rooms and players hold their item stacks here.
+ *    Containers are packed together in one array so world-wide item scans
+ *    walk contiguous memory.
+ *
+ * Entities are never destroyed, so ids stay valid for the store's lifetime.
+ * Component references may be invalidated when new entities or containers
+ * are added; hold ids, not references.
+ */
+class EntityStore
+{
+public:
+    EntityId create(const std::string &name, const std::string &description);
+    std::size_t size() const { return names_.size(); }
+
+    // --- Name / description ---
+    const std::string &name(EntityId id) const { return names_[id]; }
+    const std::string &description(EntityId id) const { return descriptions_[id]; }
+    void setDescription(EntityId id, const std::string &description) { descriptions_[id] = description; }
+
+    // --- Location ---
+    EntityId location(EntityId id) const { return locations_[id]; }
+    void setLocation(EntityId id, EntityId where) { locations_[id] = where; }
+
+    // --- Container ---
+    // Give an entity an (empty) item container. Does nothing if it has one.
+    ItemContainer &addContainer(EntityId id, const ItemRegistry &registry);
+    bool hasContainer(EntityId id) const { return containerSlots_[id] != kNoContainer; }
+    ItemContainer &container(EntityId id) { return containers_[containerSlots_[id]]; }
+    const ItemContainer &container(EntityId id) const { return containers_[containerSlots_[id]]; }
+
+    // All containers, densely packed, and the entity owning each one.
+    const std::vector<ItemContainer> &containers() const { return containers_; }
+    EntityId containerOwner(std::size_t slot) const { return containerOwners_[slot]; }
+
+private:
+    static constexpr std::uint32_t kNoContainer = std::numeric_limits<std::uint32_t>::max();
+
+    std::vector<std::string> names_;
+    std::vector<std::string> descriptions_;
+    std::vector<EntityId> locations_;
+    std::vector<std::uint32_t> containerSlots_; // Entity -> index into containers_
+
+    std::vector<ItemContainer> containers_;
+    std::vector<EntityId> containerOwners_; // Parallel to containers_
+};
+
+#endif // ENTITIES_H
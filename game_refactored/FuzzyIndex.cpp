@@ -0,0 +1,208 @@
+#include "FuzzyIndex.h"
+#include <algorithm> // For std::min, std::sort, std::unique
+#include <utility>   // For std::swap
+
+void FuzzyIndex::add(const std::string &term, std::uint32_t value)
+{
+    auto known = termIds_.find(term);
+    if (known != termIds_.end())
+    {
+        terms_[known->second].values.push_back(value); // Same term, another value
+        return;
+    }
+
+    std::uint32_t id = static_cast<std::uint32_t>(terms_.size());
+    terms_.push_back({term, {value}});
+    termIds_.emplace(term, id);
+
+    std::vector<Trigram> grams;
+    trigrams(term, grams);
+    for (Trigram gram : grams)
+    {
+        postings_[gram].push_back(id);
+    }
+}
+
+void FuzzyIndex::search(const std::string &query, std::uint32_t maxDistance, std::vector<Match> &out) const
+{
+    std::vector<Trigram> grams;
+    trigrams(query, grams);
+
+    // A term within maxDistance edits keeps all but 4 trigrams per edit.
+    std::size_t lost = 4 * static_cast<std::size_t>(maxDistance);
+    std::size_t needed = grams.size() > lost ? grams.size() - lost : 0;
+
+    std::vector<std::uint32_t> candidates;
+    if (needed == 0)
+    {
+        // Query too short to filter on: only the length check applies.
+        for (std::uint32_t id = 0; id < terms_.size(); ++id)
+        {
+            candidates.push_back(id);
+        }
+    }
+    else
+    {
+        // Rarest trigrams first. A term that shares `needed` of the query's
+        // trigrams still shares `needed - skipped` once the `skipped` most
+        // common ones (" of", "the"...) are left out, so skip those long
+        // posting lists as long as at least one trigram must still match.
+        std::vector<const std::vector<std::uint32_t> *> lists;
+        for (Trigram gram : grams)
+        {
+            auto posting = postings_.find(gram);
+            if (posting != postings_.end())
+            {
+                lists.push_back(&posting->second);
+            }
+        }
+        std::sort(lists.begin(), lists.end(), [](const std::vector<std::uint32_t> *a, const std::vector<std::uint32_t> *b)
+                  { return a->size() < b->size(); });
+        std::size_t skipped = 0;
+        while (skipped + 1 < needed && skipped < lists.size() && lists[lists.size() - 1 - skipped]->size() > terms_.size() / 8)
+        {
+            ++skipped;
+        }
+        lists.resize(lists.size() - skipped);
+        needed -= skipped;
+
+        // Count shared trigrams per term; only terms that reach `needed`
+        // are worth an edit-distance computation.
+        std::vector<std::uint16_t> shared(terms_.size(), 0);
+        for (const std::vector<std::uint32_t> *list : lists)
+        {
+            for (std::uint32_t id : *list)
+            {
+                if (++shared[id] == needed)
+                {
+                    candidates.push_back(id);
+                }
+            }
+        }
+    }
+
+    for (std::uint32_t id : candidates)
+    {
+        const Term &term = terms_[id];
+        std::uint32_t distance = editDistance(query, term.text, maxDistance);
+        if (distance <= maxDistance)
+        {
+            for (std::uint32_t value : term.values)
+            {
+                out.push_back({value, distance});
+            }
+        }
+    }
+}
+
+void FuzzyIndex::trigrams(const std::string &text, std::vector<Trigram> &out)
+{
+    // Two pad bytes on each side, so every letter (also at the ends of short
+    // words) is covered by three trigrams.
+    const unsigned char pad = 1;
+    std::string padded;
+    padded.reserve(text.size() + 4);
+    padded.append(2, static_cast<char>(pad));
+    padded += text;
+    padded.append(2, static_cast<char>(pad));
+
+    out.clear();
+    for (std::size_t i = 0; i + 3 <= padded.size(); ++i)
+    {
+        out.push_back(static_cast<Trigram>(static_cast<unsigned char>(padded[i])) << 16 |
+                      static_cast<Trigram>(static_cast<unsigned char>(padded[i + 1])) << 8 |
+                      static_cast<Trigram>(static_cast<unsigned char>(padded[i + 2])));
+    }
+    std::sort(out.begin(), out.end());
+    out.erase(std::unique(out.begin(), out.end()), out.end());
+}
+
+std::uint32_t FuzzyIndex::editDistance(const std::string &a, const std::string &b, std::uint32_t limit)
+{
+    // A shared prefix and suffix never cost an edit; most near-miss names
+    // differ only in the middle or at one end, so strip them first.
+    std::size_t prefix = 0;
+    while (prefix < a.size() && prefix < b.size() && a[prefix] == b[prefix])
+    {
+        ++prefix;
+    }
+    std::size_t suffix = 0;
+    while (suffix < a.size() - prefix && suffix < b.size() - prefix &&
+           a[a.size() - 1 - suffix] == b[b.size() - 1 - suffix])
+    {
+        ++suffix;
+    }
+    const char *shortText = a.data() + prefix;
+    const char *longText = b.data() + prefix;
+    std::size_t shortSize = a.size() - prefix - suffix;
+    std::size_t longSize = b.size() - prefix - suffix;
+    if (shortSize > longSize)
+    {
+        std::swap(shortText, longText);
+        std::swap(shortSize, longSize);
+    }
+    if (longSize - shortSize > limit)
+    {
+        return limit + 1; // Each edit changes the length by at most one
+    }
+
+    // Optimal string alignment: Levenshtein plus swapping two neighboring
+    // letters ("tkae") as one edit, over three rolling rows. Only cells
+    // within `limit` of the diagonal can stay within the limit, so each row
+    // computes just that band; everything else counts as `cap`.
+    const std::uint32_t cap = limit + 1;
+    const std::size_t width = shortSize + 1;
+    std::uint32_t small[3 * 64]; // Names are short; avoid the heap for them
+    std::vector<std::uint32_t> large;
+    std::uint32_t *cells = small;
+    if (3 * width > sizeof(small) / sizeof(small[0]))
+    {
+        large.resize(3 * width);
+        cells = large.data();
+    }
+    std::uint32_t *beforePrevious = cells;
+    std::uint32_t *previous = cells + width;
+    std::uint32_t *current = cells + 2 * width;
+
+    for (std::size_t i = 0; i < width; ++i)
+    {
+        beforePrevious[i] = cap;
+        previous[i] = static_cast<std::uint32_t>(std::min<std::size_t>(i, cap));
+    }
+    for (std::size_t j = 1; j <= longSize; ++j)
+    {
+        std::size_t first = j > limit ? j - limit : 1;
+        std::size_t last = std::min<std::size_t>(shortSize, j + limit);
+        current[first - 1] = first == 1 ? static_cast<std::uint32_t>(std::min<std::size_t>(j, cap)) : cap;
+        if (last + 1 < width)
+        {
+            current[last + 1] = cap; // Border for the next row's band
+        }
+
+        std::uint32_t rowMinimum = current[first - 1];
+        for (std::size_t i = first; i <= last; ++i)
+        {
+            std::uint32_t best = previous[i - 1]; // Letters match: free diagonal step
+            if (shortText[i - 1] != longText[j - 1])
+            {
+                best = std::min(best, std::min(previous[i], current[i - 1]));
+                if (i > 1 && j > 1 && shortText[i - 1] == longText[j - 2] && shortText[i - 2] == longText[j - 1])
+                {
+                    best = std::min(best, beforePrevious[i - 2]); // Swapped neighbors
+                }
+                best += 1;
+            }
+            current[i] = std::min(best, cap);
+            rowMinimum = std::min(rowMinimum, current[i]);
+        }
+        if (rowMinimum >= cap)
+        {
+            return cap; // Row minimums never decrease
+        }
+        std::uint32_t *recycled = beforePrevious;
+        beforePrevious = previous;
+        previous = current;
+        current = recycled;
+    }
+    return previous[shortSize];
+}
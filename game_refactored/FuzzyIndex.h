@@ -0,0 +1,68 @@
+#ifndef FUZZYINDEX_H
+#define FUZZYINDEX_H
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @brief Finds the stored terms within a given edit distance of a query.
+ *
+ * A trigram index: every term is split into overlapping three-letter pieces
+ * (padded at both ends), and each trigram maps to the terms containing it.
+ * One edit changes at most four of a word's trigrams, so a term within k
+ * edits of the query must share all but 4k of the query's trigrams. A search
+ * counts shared trigrams through the posting lists and computes the real
+ * edit distance only for the few terms that pass that count and a length
+ * check, instead of for every term.
+ *
+ * Each term carries caller-chosen values (e.g. ItemIds); adding the same
+ * term again appends another value. Terms and queries are compared byte by
+ * byte; normalize them (e.g. with ItemContainer::normalize) first.
+ */
+class FuzzyIndex
+{
+public:
+    struct Match
+    {
+        std::uint32_t value;
+        std::uint32_t distance;
+    };
+
+    void add(const std::string &term, std::uint32_t value);
+
+    // Append every value whose term is within `maxDistance` edits
+    // (insertions, deletions, substitutions, swapped neighbors) of `query`
+    // to `out`.
+    void search(const std::string &query, std::uint32_t maxDistance, std::vector<Match> &out) const;
+
+    // Number of distinct terms.
+    std::size_t size() const { return terms_.size(); }
+
+    // Edit distance between two strings, counting a swap of two neighboring
+    // letters as one edit (optimal string alignment distance). Gives up early
+    // and returns limit + 1 once the distance is known to exceed `limit`.
+    static constexpr std::uint32_t kNoLimit = std::numeric_limits<std::uint32_t>::max() / 2;
+    static std::uint32_t editDistance(const std::string &a, const std::string &b, std::uint32_t limit = kNoLimit);
+
+private:
+    using Trigram = std::uint32_t; // Three bytes packed into one integer
+
+    struct Term
+    {
+        std::string text;
+        std::vector<std::uint32_t> values;
+    };
+
+    std::vector<Term> terms_;
+    std::unordered_map<std::string, std::uint32_t> termIds_;           // Text -> index into terms_
+    std::unordered_map<Trigram, std::vector<std::uint32_t>> postings_; // Trigram -> terms containing it
+
+    // The distinct trigrams of a padded string.
+    static void trigrams(const std::string &text, std::vector<Trigram> &out);
+};
+
+#endif // FUZZYINDEX_H
@@ -0,0 +1,479 @@
+#include "Game.h"
+#include "FuzzyIndex.h"
+#include "Player.h"
+#include "Simulation.h"
+#include "Snapshot.h"
+#include "World.h"
+#include <iostream>
+#include <vector>
+#include <sstream>   // For splitting commands
+#include <iterator>  // For splitting commands
+#include <algorithm> // For std::transform
+
+namespace
+{
+// Helper function to convert string to lowercase
+std::string toLower(const std::string &str)
+{
+    std::string lowerStr = str;
+    std::transform(lowerStr.begin(), lowerStr.end(), lowerStr.begin(),
+                   [](unsigned char c)
+                   { return std::tolower(c); });
+    return lowerStr;
+}
+
+// Helper function to split a string by spaces
+std::vector<std::string> splitCommand(const std::string &command)
+{
+    std::istringstream iss(command);
+    std::vector<std::string> tokens{
+        std::istream_iterator<std::string>{iss},
+        std::istream_iterator<std::string>{}};
+    return tokens;
+}
+
+// Expand single letter directions (n, s, e, w) to their full names
+std::string expandDirection(const std::string &direction)
+{
+    if (direction == "n")
+        return "north";
+    if (direction == "s")
+        return "south";
+    if (direction == "e")
+        return "east";
+    if (direction == "w")
+        return "west";
+    return direction;
+}
+
+// Verbs that forgive a typo. Shorter ones ("go", "i", "n") must be exact,
+// since a single edit turns them into each other. So must "quit", "save" and
+// "load": one edit away are ordinary words ("quiz", "same", "road"), and a
+// guess there would end the game or overwrite progress.
+const char *const kFuzzyVerbs[] = {"look", "inventory", "take", "drop", "help"};
+
+// Map a mistyped verb ("tkae", "inventry") to the one it is closest to.
+// Returns the input unchanged if it is exact, too short, or ambiguous.
+std::string resolveVerb(const std::string &verb)
+{
+    static const FuzzyIndex verbs = []
+    {
+        FuzzyIndex index;
+        for (std::uint32_t i = 0; i < sizeof(kFuzzyVerbs) / sizeof(kFuzzyVerbs[0]); ++i)
+        {
+            index.add(kFuzzyVerbs[i], i);
+        }
+        return index;
+    }();
+    if (verb.size() < 4)
+    {
+        return verb;
+    }
+
+    std::vector<FuzzyIndex::Match> matches;
+    verbs.search(verb, verb.size() <= 7 ? 1 : 2, matches);
+    const FuzzyIndex::Match *best = nullptr;
+    bool tied = false;
+    for (const FuzzyIndex::Match &match : matches)
+    {
+        if (best == nullptr || match.distance < best->distance)
+        {
+            best = &match;
+            tied = false;
+        }
+        else if (match.distance == best->distance)
+        {
+            tied = true;
+        }
+    }
+    return best != nullptr && !tied ? kFuzzyVerbs[best->value] : verb;
+}
+
+// "Which do you mean: the Gold Coin or the Dusty Coin?"
+void askWhich(std::ostream &out, const ItemRegistry &items, const std::vector<ItemId> &choices)
+{
+    out << "Which do you mean: ";
+    for (std::size_t i = 0; i < choices.size(); ++i)
+    {
+        if (i > 0)
+        {
+            out << (i + 1 == choices.size() ? " or " : ", ");
+        }
+        out << "the " << items.name(choices[i]);
+    }
+    out << "?\n";
+}
+} // namespace
+
+bool StreamCommandSource::nextCommand(std::string &line)
+{
+    return static_cast<bool>(std::getline(in_, line));
+}
+
+GameSession::GameSession(World &world, Player &player, std::ostream &out, Simulation *simulation,
+                         ZoneMap *zones)
+    : world_(world), player_(player), out_(out), simulation_(simulation), zones_(zones)
+{
+    if (zones_ != nullptr)
+    {
+        subscription_ = zones_->subscribe(*this, player_.location()->getId());
+    }
+}
+
+GameSession::~GameSession()
+{
+    if (zones_ != nullptr)
+    {
+        zones_->unsubscribe(subscription_);
+    }
+}
+
+void GameSession::announce(WorldEvent::Kind kind, RoomId room, ItemId item)
+{
+    if (zones_ != nullptr)
+    {
+        zones_->publish(WorldEvent{kind, room, player_.getEntity(), item});
+    }
+}
+
+void GameSession::onEvent(const WorldEvent &event)
+{
+    if (event.actor == player_.getEntity())
+    {
+        return; // Our own doing; already reported by the command itself
+    }
+    const std::string &who = world_.entities().name(event.actor);
+    if (event.room != player_.location()->getId())
+    {
+        // Next door: only movement is loud enough to notice
+        if (event.kind == WorldEvent::Kind::Arrived)
+        {
+            out_ << "You hear footsteps nearby.\n";
+        }
+        return;
+    }
+    switch (event.kind)
+    {
+    case WorldEvent::Kind::Arrived:
+        out_ << who << " arrives.\n";
+        break;
+    case WorldEvent::Kind::Left:
+        out_ << who << " leaves.\n";
+        break;
+    case WorldEvent::Kind::TookItem:
+        out_ << who << " takes the " << world_.items().name(event.item) << ".\n";
+        break;
+    case WorldEvent::Kind::DroppedItem:
+        out_ << who << " drops the " << world_.items().name(event.item) << ".\n";
+        break;
+    }
+}
+
+// Helper function for help text
+void GameSession::printHelp()
+{
+    out_ << "Available commands:\n";
+    out_ << "  go [direction] / n, s, e, w - Move to another room (e.g., go north)\n";
+    out_ << "  look                      - Describe the current room again\n";
+    out_ << "  take [item name]          - Pick up an item from the room\n";
+    out_ << "  drop [item name]          - Drop an item from your inventory\n";
+    out_ << "  inventory / i             - Show your inventory\n";
+    out_ << "  save [file] / load [file] - Save or restore your progress (default: crypt.sav)\n";
+    out_ << "  help                      - Show this help message\n";
+    out_ << "  quit                      - Exit the game\n";
+}
+
+// Helper function to print inventory
+void GameSession::printInventory()
+{
+    const ItemContainer &inventory = player_.inventory();
+    out_ << "Inventory:\n";
+    if (inventory.empty())
+    {
+        out_ << "  (empty)\n";
+    }
+    else
+    {
+        for (const ItemStack &stack : inventory.stacks())
+        {
+            out_ << "  - " << inventory.registry().name(stack.id);
+            if (stack.count > 1)
+            {
+                out_ << " (x" << stack.count << ")";
+            }
+            out_ << '\n';
+        }
+    }
+}
+
+void GameSession::describeRoom()
+{
+    out_ << "----------------------------------------\n";
+    // Describe the current room. The text is cached inside the room, so an
+    // unchanged room costs one buffered write (no re-render, no flush; the
+    // game loop flushes the frame buffer once, at the prompt).
+    const std::string &roomDescription = player_.location()->describe();
+    out_.write(roomDescription.data(), roomDescription.size());
+    out_ << '\n';
+
+    if (simulation_ != nullptr)
+    {
+        const std::vector<EntityId> &npcs = simulation_->npcsIn(player_.location()->getId());
+        if (!npcs.empty())
+        {
+            out_ << "Also here:";
+            for (EntityId npc : npcs)
+            {
+                out_ << ' ' << world_.entities().name(npc);
+            }
+            out_ << '\n';
+        }
+    }
+}
+
+bool GameSession::execute(const std::string &line)
+{
+    // Split into tokens as typed: file names keep their case
+    std::vector<std::string> commandTokens = splitCommand(line);
+
+    if (commandTokens.empty())
+    {
+        return true; // Ignore empty input
+    }
+
+    std::string verb = resolveVerb(toLower(commandTokens[0]));
+    std::string argument = (commandTokens.size() > 1) ? commandTokens[1] : ""; // Basic noun extraction
+    // For multi-word nouns, we might need to rejoin tokens[1] onwards
+    if (commandTokens.size() > 2)
+    {
+        for (size_t i = 2; i < commandTokens.size(); ++i)
+        {
+            argument += " " + commandTokens[i];
+        }
+    }
+    std::string noun = toLower(argument); // Directions and item names ignore case
+
+    // --- Command Parsing ---
+    if (verb == "quit")
+    {
+        return false;
+    }
+    else if (verb == "help")
+    {
+        printHelp();
+    }
+    else if (verb == "look" || verb == "l")
+    {
+        // The room is described before every prompt
+    }
+    else if (verb == "inventory" || verb == "i")
+    {
+        printInventory();
+    }
+    else if (verb == "go")
+    {
+        if (noun.empty())
+        {
+            out_ << "Go where? (Specify a direction)\n";
+        }
+        else
+        {
+            move(expandDirection(noun)); // Handle single letter directions too
+        }
+    }
+    else if (verb == "n" || verb == "s" || verb == "e" || verb == "w")
+    {
+        move(expandDirection(verb)); // Handle single letter directions directly
+    }
+    else if (verb == "take")
+    {
+        take(noun);
+    }
+    else if (verb == "drop")
+    {
+        drop(noun);
+    }
+    else if (verb == "save" || verb == "load")
+    {
+        std::string saveFile = argument.empty() ? "crypt.sav" : argument;
+        SnapshotStatus status =
+            verb == "save" ? saveSnapshot(world_, player_, saveFile) : loadSnapshot(world_, player_, saveFile);
+        if (status != SnapshotStatus::Ok)
+        {
+            out_ << "Error: " << snapshotStatusMessage(status) << ": " << saveFile << '\n';
+        }
+        else if (verb == "save")
+        {
+            out_ << "Game saved to " << saveFile << ".\n";
+        }
+        else
+        {
+            if (zones_ != nullptr)
+            {
+                zones_->moveSubscriber(subscription_, player_.location()->getId());
+            }
+            out_ << "Game loaded from " << saveFile << ".\n";
+        }
+    }
+    // Add more commands: look at, use, open, ...
+    else
+    {
+        out_ << "Unknown command. Try 'help'.\n";
+    }
+
+    return true;
+}
+
+void GameSession::move(const std::string &direction)
+{
+    Room *nextRoom = player_.location()->getExit(direction);
+    if (nextRoom != nullptr)
+    {
+        announce(WorldEvent::Kind::Left, player_.location()->getId());
+        player_.moveTo(*nextRoom);
+        if (zones_ != nullptr)
+        {
+            zones_->moveSubscriber(subscription_, nextRoom->getId());
+        }
+        announce(WorldEvent::Kind::Arrived, nextRoom->getId());
+        // Room description prints before the next prompt
+    }
+    else
+    {
+        out_ << "You can't go that way.\n";
+    }
+}
+
+void GameSession::take(const std::string &noun)
+{
+    if (noun.empty())
+    {
+        out_ << "Take what?\n";
+        return;
+    }
+
+    // Room lookup is case-insensitive, so the lowercased noun matches directly
+    Room &room = *player_.location();
+    std::optional<ItemId> takenItem = room.removeItem(noun);
+    if (!takenItem)
+    {
+        // Typo, plural or partial name? Take the closest item if it is clear.
+        std::vector<ItemId> guesses = room.getItems().closestMatches(noun);
+        if (guesses.size() > 1)
+        {
+            askWhich(out_, world_.items(), guesses);
+            return;
+        }
+        if (guesses.size() == 1)
+        {
+            takenItem = room.removeItem(world_.items().name(guesses[0]));
+        }
+    }
+
+    if (takenItem)
+    {
+        out_ << "You take the " << world_.items().name(*takenItem) << ".\n";
+        player_.inventory().add(*takenItem); // Move one item to the inventory
+        announce(WorldEvent::Kind::TookItem, room.getId(), *takenItem);
+    }
+    else
+    {
+        out_ << "You don't see a '" << noun << "' here.\n";
+    }
+}
+
+void GameSession::drop(const std::string &noun)
+{
+    if (noun.empty())
+    {
+        out_ << "Drop what?\n";
+        return;
+    }
+
+    // Inventory lookup uses the same case-insensitive name index
+    ItemContainer &inventory = player_.inventory();
+    std::optional<ItemId> droppedItem = inventory.removeByName(noun);
+    if (!droppedItem)
+    {
+        std::vector<ItemId> guesses = inventory.closestMatches(noun);
+        if (guesses.size() > 1)
+        {
+            askWhich(out_, world_.items(), guesses);
+            return;
+        }
+        if (guesses.size() == 1 && inventory.remove(guesses[0]) == 1)
+        {
+            droppedItem = guesses[0];
+        }
+    }
+
+    if (droppedItem)
+    {
+        out_ << "You drop the " << world_.items().name(*droppedItem) << ".\n";
+        player_.location()->addItem(*droppedItem); // Move one item back to the room
+        announce(WorldEvent::Kind::DroppedItem, player_.location()->getId(), *droppedItem);
+    }
+    else
+    {
+        out_ << "You don't have a '" << noun << "'.\n";
+    }
+}
+
+namespace
+{
+// One player's turn: describe the room, prompt, read and execute a command.
+// Returns false once the source runs dry or the player quits.
+bool playTurn(GameSession &session, CommandSource &source, std::size_t &commandsRead)
+{
+    std::string lineInput;
+    session.describeRoom();
+    // The frame for this command ends at the prompt: flush so it shows
+    // before we wait for input (std::cin is not tied to the output).
+    session.output() << "\n> " << std::flush;
+    if (!source.nextCommand(lineInput))
+    {
+        return false; // EOF/error
+    }
+    ++commandsRead;
+    return session.execute(lineInput);
+}
+} // namespace
+
+std::size_t runGame(GameSession &session, CommandSource &source, Simulation *simulation)
+{
+    std::size_t commandsRead = 0;
+    while (playTurn(session, source, commandsRead))
+    {
+        // The rest of the world moves on once per command
+        if (simulation != nullptr)
+        {
+            simulation->tick();
+        }
+    }
+    return commandsRead;
+}
+
+std::size_t runRounds(const std::vector<GameSession *> &sessions, const std::vector<CommandSource *> &sources,
+                      Simulation *simulation)
+{
+    std::size_t commandsRead = 0;
+    std::vector<bool> playing(sessions.size(), true);
+    std::size_t stillPlaying = std::min(sessions.size(), sources.size());
+    while (stillPlaying > 0)
+    {
+        for (std::size_t i = 0; i < sessions.size() && i < sources.size(); ++i)
+        {
+            if (playing[i] && !playTurn(*sessions[i], *sources[i], commandsRead))
+            {
+                playing[i] = false;
+                --stillPlaying;
+            }
+        }
+        // One tick per round, however many players share the simulation
+        if (simulation != nullptr && stillPlaying > 0)
+        {
+            simulation->tick();
+        }
+    }
+    return commandsRead;
+}
@@ -0,0 +1,104 @@
+#ifndef GAME_H
+#define GAME_H
+
+#include "Zones.h"
+#include <cstddef>
+#include <iosfwd>
+#include <string>
+#include <vector>
+
+class World;
+class Player;
+class Simulation;
+
+/**
+ * @brief Where player commands come from: stdin for a human, or a bot driver
+ *        (see Bot.h) for headless simulation.
+ */
+class CommandSource
+{
+public:
+    virtual ~CommandSource() = default;
+
+    // Fetch the next command line. Returns false when there are no more.
+    virtual bool nextCommand(std::string &line) = 0;
+};
+
+/**
+ * @brief Reads commands line by line from an input stream (e.g. std::cin).
+ */
+class StreamCommandSource : public CommandSource
+{
+public:
+    explicit StreamCommandSource(std::istream &in) : in_(in) {}
+    bool nextCommand(std::string &line) override;
+
+private:
+    std::istream &in_;
+};
+
+/**
+ * @brief Runs game commands for one player against a world, writing all
+ *        output to the given sink. Holds no global state, so many sessions
+ *        (e.g. bots) can share one world on a single thread, and separate
+ *        worlds can run on separate threads.
+ *
+ * Sessions sharing a ZoneMap tell each other what their players do: each
+ * session publishes its player's moves and item changes and reports what
+ * other players do in the same or a neighboring room.
+ */
+class GameSession : public EventListener
+{
+public:
+    // With a simulation, room descriptions mention the NPCs present. The
+    // session never advances it; the game loop does (runGame, runRounds).
+    GameSession(World &world, Player &player, std::ostream &out, Simulation *simulation = nullptr,
+                ZoneMap *zones = nullptr);
+    ~GameSession() override;
+
+    // Subscribed to the zone map by address, so sessions stay put.
+    GameSession(const GameSession &) = delete;
+    GameSession &operator=(const GameSession &) = delete;
+
+    // Execute one command line. Returns false once the player quits.
+    bool execute(const std::string &line);
+
+    // Print the separator and the current room's (cached) description.
+    void describeRoom();
+    void printHelp();
+    void printInventory();
+
+    std::ostream &output() { return out_; }
+
+    // Another player did something nearby.
+    void onEvent(const WorldEvent &event) override;
+
+private:
+    World &world_;
+    Player &player_;
+    std::ostream &out_;
+    Simulation *simulation_;
+    ZoneMap *zones_;
+    ZoneMap::SubscriberId subscription_ = 0;
+
+    // Tell nearby sessions what our player just did.
+    void announce(WorldEvent::Kind kind, RoomId room, ItemId item = 0);
+
+    void move(const std::string &direction);
+    void take(const std::string &noun);
+    void drop(const std::string &noun);
+};
+
+// The game loop: describe the room, prompt, read and execute a command, until
+// the source runs dry or the player quits. With a simulation, it ticks once
+// after every command. Returns the number of commands read.
+std::size_t runGame(GameSession &session, CommandSource &source, Simulation *simulation = nullptr);
+
+// The game loop for several players sharing a world (and simulation): each
+// round, every session still playing runs one command from its source, then
+// the simulation ticks once. Runs until every player has quit or run dry.
+// Returns the total number of commands read.
+std::size_t runRounds(const std::vector<GameSession *> &sessions, const std::vector<CommandSource *> &sources,
+                      Simulation *simulation = nullptr);
+
+#endif // GAME_H
@@ -0,0 +1,148 @@
+#include "ItemContainer.h"
+#include "ItemRegistry.h"
+#include <algorithm> // For std::transform, std::min, std::find
+#include <cctype>    // For std::tolower
+#include <limits>    // For std::numeric_limits
+
+ItemContainer::ItemContainer(const ItemRegistry &registry)
+    : registry_(&registry)
+{
+}
+
+std::string ItemContainer::normalize(const std::string &name)
+{
+    std::string key = name;
+    std::transform(key.begin(), key.end(), key.begin(),
+                   [](unsigned char c)
+                   { return std::tolower(c); });
+    return key;
+}
+
+std::size_t ItemContainer::findSlot(ItemId id) const
+{
+    if (indexed_)
+    {
+        auto it = index_.find(id);
+        return it == index_.end() ? kNoSlot : it->second;
+    }
+    // Small containers (most rooms): a linear scan beats hashing.
+    for (std::size_t slot = 0; slot < stacks_.size(); ++slot)
+    {
+        if (stacks_[slot].id == id)
+        {
+            return slot;
+        }
+    }
+    return kNoSlot;
+}
+
+void ItemContainer::add(ItemId id, std::uint32_t count)
+{
+    if (count == 0)
+    {
+        return;
+    }
+
+    std::size_t slot = findSlot(id);
+    if (slot != kNoSlot)
+    {
+        stacks_[slot].count += count; // Collapse into the existing stack
+        return;
+    }
+    stacks_.push_back({id, count});
+
+    if (indexed_)
+    {
+        index_.emplace(id, stacks_.size() - 1);
+    }
+    else if (stacks_.size() > kIndexThreshold)
+    {
+        // Big pile: switch to the hash index from now on.
+        for (std::size_t i = 0; i < stacks_.size(); ++i)
+        {
+            index_.emplace(stacks_[i].id, i);
+        }
+        indexed_ = true;
+    }
+}
+
+std::uint32_t ItemContainer::remove(ItemId id, std::uint32_t count)
+{
+    std::size_t slot = findSlot(id);
+    if (slot == kNoSlot)
+    {
+        return 0; // Nothing of that kind here
+    }
+
+    std::uint32_t removed = std::min(count, stacks_[slot].count);
+    stacks_[slot].count -= removed;
+    if (stacks_[slot].count > 0)
+    {
+        return removed;
+    }
+
+    // Stack is empty: swap-and-pop, then repoint the moved stack's index entry.
+    std::size_t lastSlot = stacks_.size() - 1;
+    if (indexed_)
+    {
+        index_.erase(id);
+        if (slot != lastSlot)
+        {
+            index_[stacks_[lastSlot].id] = slot;
+        }
+    }
+    stacks_[slot] = stacks_[lastSlot];
+    stacks_.pop_back();
+    return removed;
+}
+
+std::optional<ItemId> ItemContainer::removeByName(const std::string &itemName)
+{
+    std::optional<ItemId> id = registry_->find(itemName);
+    if (!id || remove(*id) == 0)
+    {
+        return std::nullopt;
+    }
+    return id;
+}
+
+std::vector<ItemId> ItemContainer::closestMatches(const std::string &query) const
+{
+    std::vector<ItemRegistry::NameMatch> candidates;
+    registry_->matchNames(query, candidates);
+
+    // Best = fewest edits, and on equal edits a full name beats a single word.
+    std::vector<ItemId> best;
+    std::uint32_t bestScore = std::numeric_limits<std::uint32_t>::max();
+    for (const ItemRegistry::NameMatch &candidate : candidates)
+    {
+        std::uint32_t score = candidate.distance * 2 + (candidate.wholeName ? 0 : 1);
+        if (score > bestScore || count(candidate.id) == 0)
+        {
+            continue; // Worse than what we have, or not held here
+        }
+        if (score < bestScore)
+        {
+            bestScore = score;
+            best.clear();
+        }
+        if (std::find(best.begin(), best.end(), candidate.id) == best.end())
+        {
+            best.push_back(candidate.id);
+        }
+    }
+    return best;
+}
+
+void ItemContainer::clear()
+{
+    stacks_.clear();
+    index_.clear();
+    indexed_ = false;
+}
+
+std::uint32_t ItemContainer::count(ItemId id) const
+{
+    std::size_t slot = findSlot(id);
+    return slot == kNoSlot ? 0 : stacks_[slot].count;
+}
@@ -0,0 +1,81 @@
+#ifndef ITEMCONTAINER_H
+#define ITEMCONTAINER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+class ItemRegistry;
+using ItemId = std::uint32_t; // Matches ItemRegistry.h
+
+/**
+ * @brief A stack of identical items: the prototype id plus per-instance state.
+ *        Items of the same kind in one container always collapse into a count.
+ */
+struct ItemStack
+{
+    ItemId id;
+    std::uint32_t count;
+};
+
+/**
+ * @brief An unordered collection of item stacks, used for both room floors
+ *        and the player's inventory.
+ *
+ * Names are resolved (case-insensitively) through the shared ItemRegistry;
+ * the container itself finds stacks by ItemId, with a linear scan while it
+ * is small and a hash index once it grows past kIndexThreshold stacks.
+ * Removing the last item of a stack swaps the final stack into the freed
+ * slot, so stack order is not preserved across removals.
+ */
+class ItemContainer
+{
+public:
+    explicit ItemContainer(const ItemRegistry &registry);
+
+    // Add `count` items of the given prototype.
+    void add(ItemId id, std::uint32_t count = 1);
+    // Remove up to `count` items of a prototype; returns how many were removed.
+    std::uint32_t remove(ItemId id, std::uint32_t count = 1);
+    // Remove one item by name (case-insensitive). Returns its id, or nullopt.
+    std::optional<ItemId> removeByName(const std::string &itemName);
+
+    // The items held here whose names best match a mistyped, plural or
+    // partial name (see ItemRegistry::matchNames). Returns one id when the
+    // best match is clear, several when they tie, none when nothing is close.
+    std::vector<ItemId> closestMatches(const std::string &query) const;
+
+    // Remove every stack.
+    void clear();
+
+    // How many items of this prototype the container holds.
+    std::uint32_t count(ItemId id) const;
+
+    bool empty() const { return stacks_.empty(); }
+    // Number of distinct stacks (not individual items).
+    std::size_t size() const { return stacks_.size(); }
+
+    // Read-only iteration over the stacks (unspecified order).
+    const std::vector<ItemStack> &stacks() const { return stacks_; }
+    const ItemRegistry &registry() const { return *registry_; }
+
+    // Lowercase a name the same way the registry's name index does.
+    static std::string normalize(const std::string &name);
+
+private:
+    static constexpr std::size_t kIndexThreshold = 16;
+    static constexpr std::size_t kNoSlot = static_cast<std::size_t>(-1);
+
+    // Slot of the stack holding `id`, or kNoSlot.
+    std::size_t findSlot(ItemId id) const;
+
+    const ItemRegistry *registry_;
+    std::vector<ItemStack> stacks_;
+    std::unordered_map<ItemId, std::size_t> index_; // ItemId -> slot, once indexed_
+    bool indexed_ = false;
+};
+
+#endif // ITEMCONTAINER_H
@@ -0,0 +1,77 @@
+#include "ItemRegistry.h"
+#include "Entities.h"
+#include "ItemContainer.h" // For ItemContainer::normalize
+#include <sstream>         // For splitting names into words
+#include <utility>         // For std::move
+
+namespace
+{
+// How many edits a fuzzy query of this length may be away from a name.
+std::uint32_t typoTolerance(std::size_t length)
+{
+    return length <= 3 ? 0 : length <= 7 ? 1 : 2;
+}
+} // namespace
+
+ItemRegistry::ItemRegistry(EntityStore &entities)
+    : entities_(&entities)
+{
+}
+
+ItemId ItemRegistry::define(const std::string &name, const std::string &description)
+{
+    std::string key = ItemContainer::normalize(name);
+    auto it = byName_.find(key);
+    if (it != byName_.end())
+    {
+        return it->second; // Already defined; the first definition wins
+    }
+
+    ItemId id = static_cast<ItemId>(prototypes_.size());
+    prototypes_.push_back(entities_->create(name, description));
+
+    // Index the full name, plus each word of multi-word names.
+    fuzzyNames_.add(key, id * 2);
+    if (key.find(' ') != std::string::npos)
+    {
+        std::istringstream words(key);
+        std::string word;
+        while (words >> word)
+        {
+            fuzzyNames_.add(word, id * 2 + 1);
+        }
+    }
+    byName_.emplace(std::move(key), id);
+    return id;
+}
+
+std::optional<ItemId> ItemRegistry::find(const std::string &name) const
+{
+    auto it = byName_.find(ItemContainer::normalize(name));
+    if (it == byName_.end())
+    {
+        return std::nullopt;
+    }
+    return it->second;
+}
+
+void ItemRegistry::matchNames(const std::string &query, std::vector<NameMatch> &out) const
+{
+    std::string key = ItemContainer::normalize(query);
+    std::vector<FuzzyIndex::Match> matches;
+    fuzzyNames_.search(key, typoTolerance(key.size()), matches);
+    for (const FuzzyIndex::Match &match : matches)
+    {
+        out.push_back({match.value / 2, match.distance, (match.value & 1) == 0});
+    }
+}
+
+const std::string &ItemRegistry::name(ItemId id) const
+{
+    return entities_->name(prototypes_[id]);
+}
+
+const std::string &ItemRegistry::description(ItemId id) const
+{
+    return entities_->description(prototypes_[id]);
+}
@@ -0,0 +1,65 @@
+#ifndef ITEMREGISTRY_H
+#define ITEMREGISTRY_H
+
+#include "FuzzyIndex.h"
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+class EntityStore;
+using EntityId = std::uint32_t; // Matches Entities.h
+
+// Index of an item prototype inside an ItemRegistry.
+using ItemId = std::uint32_t;
+
+/**
+ * @brief Owns one shared definition (prototype) per kind of item.
+ *
+ * Each prototype is an entity in the world's EntityStore, so its name and
+ * description are stored exactly once; rooms and inventories only hold
+ * ItemIds plus per-instance state (see ItemStack), so a thousand identical
+ * coins cost one prototype and one counter.
+ */
+class ItemRegistry
+{
+public:
+    explicit ItemRegistry(EntityStore &entities);
+
+    // Register a prototype and return its id. Names are unique
+    // (case-insensitive): defining an existing name returns the existing id.
+    ItemId define(const std::string &name, const std::string &description);
+
+    // Look up a prototype id by name (case-insensitive).
+    std::optional<ItemId> find(const std::string &name) const;
+
+    // Fuzzy lookup for names players mistype: appends every prototype whose
+    // full name, or a single word of it, is within a few edits of `query`
+    // (0 for up to 3 letters, 1 up to 7, then 2). That covers typos
+    // ("tourch"), plurals ("coins") and partial names ("coin" for "Dusty
+    // Coin"). See ItemContainer::closestMatches for picking among them.
+    struct NameMatch
+    {
+        ItemId id;
+        std::uint32_t distance;
+        bool wholeName; // Matched the full name rather than one word of it
+    };
+    void matchNames(const std::string &query, std::vector<NameMatch> &out) const;
+
+    // Prototype data. The id must come from this registry.
+    EntityId entity(ItemId id) const { return prototypes_[id]; }
+    const std::string &name(ItemId id) const;
+    const std::string &description(ItemId id) const;
+
+    std::size_t size() const { return prototypes_.size(); }
+
+private:
+    EntityStore *entities_;
+    std::vector<EntityId> prototypes_;               // Indexed by ItemId
+    std::unordered_map<std::string, ItemId> byName_; // Lowercased name -> id
+    // Lowercased full names and their words; value = id * 2 + (1 for a word).
+    FuzzyIndex fuzzyNames_;
+};
+
+#endif // ITEMREGISTRY_H
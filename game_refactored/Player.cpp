@@ -0,0 +1,30 @@
+#include "Player.h"
+#include "World.h"
+
+Player::Player(World &world, Room &start, const std::string &name)
+    : world_(&world),
+      entity_(world.entities().create(name, "Another adventurer."))
+{
+    world.entities().addContainer(entity_, world.items());
+    moveTo(start);
+}
+
+Room *Player::location() const
+{
+    return world_->roomForEntity(world_->entities().location(entity_));
+}
+
+void Player::moveTo(Room &room)
+{
+    world_->entities().setLocation(entity_, room.getEntity());
+}
+
+ItemContainer &Player::inventory()
+{
+    return world_->entities().container(entity_);
+}
+
+const ItemContainer &Player::inventory() const
+{
+    return world_->entities().container(entity_);
+}
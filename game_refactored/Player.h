@@ -0,0 +1,36 @@
+#ifndef PLAYER_H
+#define PLAYER_H
+
+#include "Entities.h"
+#include <string>
+
+class Room;
+class World;
+
+/**
+ * @brief Handle to a player entity: where the player is and what they carry.
+ *
+ * The state itself lives in the world's EntityStore (location and container
+ * components); this class only wraps it with room-level accessors.
+ */
+class Player
+{
+public:
+    // Create a new player entity standing in `start`.
+    Player(World &world, Room &start, const std::string &name = "Player");
+
+    EntityId getEntity() const { return entity_; }
+
+    // The room the player is in.
+    Room *location() const;
+    void moveTo(Room &room);
+
+    ItemContainer &inventory();
+    const ItemContainer &inventory() const;
+
+private:
+    World *world_;
+    EntityId entity_;
+};
+
+#endif // PLAYER_H
@@ -1,17 +1,22 @@
 #include "Room.h"
-#include <sstream>   // For string stream to build descriptions
-#include <algorithm> // For std::find_if
-#include <iterator>  // For std::make_move_iterator
+#include <string> // For std::to_string
 
 /**
  * @brief Construct a new Room object.
  *
+ * @param entities The entity store that holds the room's components.
+ * @param registry The registry that items placed in this room belong to.
+ * @param id The room's position in its World.
  * @param name The name of the room (e.g., "Antechamber").
  * @param description The base description of the room (e.g., "Water drips steadily...").
  */
-Room::Room(const std::string &name, const std::string &description)
-    : GameObject(name, description) // Initialize base class
+Room::Room(EntityStore &entities, const ItemRegistry &registry, RoomId id,
+           const std::string &name, const std::string &description)
+    : entities_(&entities),
+      entity_(entities.create(name, description)),
+      id_(id)
 {
+    entities.addContainer(entity_, registry);
 }
 
 // --- Exit Management ---
@@ -20,6 +25,24 @@ void Room::addExit(const std::string &direction, Room *targetRoom)
 {
     // Consider converting direction to lowercase here for consistency
     exits_[direction] = targetRoom;
+    closedExits_.erase(direction); // A new exit starts out open
+    descriptionDirty_ = true;      // Exit list changed
+}
+
+bool Room::setExitOpen(const std::string &direction, bool open)
+{
+    std::map<std::string, Room *> &from = open ? closedExits_ : exits_;
+    std::map<std::string, Room *> &to = open ? exits_ : closedExits_;
+    auto it = from.find(direction);
+    if (it == from.end())
+    {
+        // Already in the requested state, or no such exit at all
+        return to.count(direction) != 0;
+    }
+    to.emplace(it->first, it->second);
+    from.erase(it);
+    descriptionDirty_ = true; // Exit list changed
+    return true;
 }
 
 Room *Room::getExit(const std::string &direction) const
@@ -35,72 +58,126 @@ Room *Room::getExit(const std::string &direction) const
 
 std::string Room::getExitsDescription() const
 {
-    if (exits_.empty())
+    std::string out;
+    appendExitsDescription(out);
+    return out;
+}
+
+void Room::appendExitsDescription(std::string &out) const
+{
+    if (exits_.empty() && closedExits_.empty())
+    {
+        out += "There are no obvious exits.";
+        return;
+    }
+    if (!exits_.empty())
     {
-        return "There are no obvious exits.";
+        out += "Exits:";
+        // Use a range-based for loop over the map
+        for (const auto &pair : exits_)
+        {
+            out += ' ';
+            out += pair.first; // pair.first is the direction (key)
+        }
     }
-    std::stringstream ss;
-    ss << "Exits:";
-    // Use a range-based for loop over the map
-    for (const auto &pair : exits_)
+    if (!closedExits_.empty())
     {
-        ss << " " << pair.first; // pair.first is the direction (key)
+        out += exits_.empty() ? "Closed:" : " Closed:"; // Doors shut for now
+        for (const auto &pair : closedExits_)
+        {
+            out += ' ';
+            out += pair.first;
+        }
     }
-    return ss.str();
 }
 
 // --- Item Management ---
 
-void Room::addItem(const Item &item)
+void Room::addItem(ItemId id, std::uint32_t count)
 {
-    items_.push_back(item); // Add a copy of the item
+    items().add(id, count); // Identical items collapse into one stack
+    descriptionDirty_ = true;
+    itemsChanged_ = true;
 }
 
-std::optional<Item> Room::removeItem(const std::string &itemName)
+std::optional<ItemId> Room::removeItem(const std::string &itemName)
 {
-    // Find the item by name (case-sensitive search here)
-    auto it = std::find_if(items_.begin(), items_.end(),
-                           [&](const Item &item)
-                           {
-                               return item.getName() == itemName;
-                           });
-
-    if (it != items_.end())
+    // Indexed, case-insensitive lookup; an emptied stack is swapped out
+    // instead of shifting the whole vector.
+    std::optional<ItemId> removed = items().removeByName(itemName);
+    if (removed)
     {
-        // Found the item
-        // Create an optional containing a *moved* copy of the item
-        // Moving is efficient if Item supports it, otherwise it copies.
-        std::optional<Item> removedItem = std::move(*it);
-        items_.erase(it); // Erase the original from the vector
-        return removedItem;
+        descriptionDirty_ = true; // Only a real change invalidates the cache
+        itemsChanged_ = true;
     }
+    return removed;
+}
 
-    return std::nullopt; // Item not found
+void Room::replaceItems(const ItemStack *first, const ItemStack *last)
+{
+    ItemContainer &floor = items();
+    floor.clear();
+    for (const ItemStack *stack = first; stack != last; ++stack)
+    {
+        floor.add(stack->id, stack->count);
+    }
+    descriptionDirty_ = true;
+    itemsChanged_ = true;
 }
 
 std::string Room::getItemsDescription() const
 {
-    if (items_.empty())
+    std::string out;
+    appendItemsDescription(out);
+    return out;
+}
+
+void Room::appendItemsDescription(std::string &out) const
+{
+    const ItemContainer &floor = getItems();
+    if (floor.empty())
     {
-        return "You see nothing of interest on the floor.";
+        out += "You see nothing of interest on the floor.";
+        return;
     }
-    std::stringstream ss;
-    ss << "You see here:";
-    for (const auto &item : items_)
+    out += "You see here:";
+    for (const ItemStack &stack : floor.stacks())
     {
-        ss << " " << item.getName(); // Just list names for brevity
+        out += ' ';
+        out += floor.registry().name(stack.id); // Just list names for brevity
+        if (stack.count > 1)
+        {
+            out += " (x" + std::to_string(stack.count) + ")";
+        }
     }
-    return ss.str();
 }
 
 // --- Full Room Description ---
 
+void Room::setDescription(const std::string &description)
+{
+    entities_->setDescription(entity_, description);
+    descriptionDirty_ = true;
+}
+
+const std::string &Room::describe() const
+{
+    // Re-render only when items, exits or the base text changed since last time.
+    if (descriptionDirty_)
+    {
+        descriptionCache_.clear(); // Keeps its capacity for the re-render
+        descriptionCache_ += entities_->description(entity_);
+        descriptionCache_ += '\n';
+        appendItemsDescription(descriptionCache_);
+        descriptionCache_ += '\n';
+        appendExitsDescription(descriptionCache_);
+        descriptionDirty_ = false;
+    }
+    return descriptionCache_;
+}
+
 std::string Room::getDescription() const
 {
-    // Combine base description with exits and items
-    std::stringstream ss;
-    ss << GameObject::getDescription() << std::endl; // Get base description
-    ss << getItemsDescription() << std::endl;
-    ss << getExitsDescription();
-    return ss.str();
-}
\ No newline at end of file
+    // Combine base description with exits and items (served from the cache)
+    return describe();
+}
@@ -1,8 +1,11 @@
 #ifndef ROOM_H
 #define ROOM_H
 
-#include "GameObject.h"
-#include "Item.h" // Include Item definition
+#include "Entities.h"
+#include "ItemContainer.h"
+#include "ItemRegistry.h"
+#include <cstdint>
+#include <optional>
 #include <string>
 #include <vector>
 #include <map>
@@ -10,14 +13,30 @@
 // Forward declaration for Room to allow Room* in the map value
 class Room;
 
+// Index of a room inside its World (see World.h).
+using RoomId = std::uint32_t;
+
 /**
  * @brief Represents a location in the game world.
+ *
+ * A room is an entity in the world's EntityStore: its name, description and
+ * item container are components stored there. The Room object itself only
+ * keeps what is room-specific (exits and the rendered-description cache).
  */
-class Room : public GameObject
+class Room
 {
 public:
-    // Constructor: Only needs name and description for the GameObject part.
-    Room(const std::string &name, const std::string &description);
+    // Constructor: Creates the room's entity (name, description and an empty
+    // item container whose ids refer to `registry`).
+    Room(EntityStore &entities, const ItemRegistry &registry, RoomId id,
+         const std::string &name, const std::string &description);
+
+    // Position of this room in its world, and its entity id.
+    RoomId getId() const { return id_; }
+    EntityId getEntity() const { return entity_; }
+
+    // Name of the room (no copy).
+    const std::string &getName() const { return entities_->name(entity_); }
 
     // --- Exits ---
     // Add an exit from this room to another room in a given direction.
@@ -26,26 +45,61 @@ public:
     Room *getExit(const std::string &direction) const;
     // Get a description of available exits.
     std::string getExitsDescription() const;
+    // All open exits, keyed by direction.
+    const std::map<std::string, Room *> &getExits() const { return exits_; }
+    // Close or reopen an exit (e.g. a timed door). A closed exit keeps its
+    // target but is left out of getExit()/getExits() until it is reopened.
+    // Returns false if the room has no exit in that direction.
+    bool setExitOpen(const std::string &direction, bool open);
+    // Exits that are currently closed, keyed by direction.
+    const std::map<std::string, Room *> &getClosedExits() const { return closedExits_; }
 
     // --- Items ---
-    // Add an item to the room.
-    void addItem(const Item &item);
-    // Attempt to remove an item by name and return it (or nullopt).
-    // Using optional<Item> requires Item to be copyable/movable.
-    std::optional<Item> removeItem(const std::string &itemName);
+    // Add `count` items of a prototype to the room.
+    void addItem(ItemId id, std::uint32_t count = 1);
+    // Attempt to remove one item by name (case-insensitive) and return its id,
+    // or nullopt if the room holds no such item.
+    std::optional<ItemId> removeItem(const std::string &itemName);
+    // Read-only access to the item stacks on the floor.
+    const ItemContainer &getItems() const { return entities_->container(entity_); }
+    // Replace everything on the floor with the stacks in [first, last).
+    void replaceItems(const ItemStack *first, const ItemStack *last);
+    // True if items were added/removed since the last markItemsPristine().
+    // Used to save only the rooms that differ from the world definition.
+    bool itemsChanged() const { return itemsChanged_; }
+    void markItemsPristine() { itemsChanged_ = false; }
     // Get a description of items currently in the room.
     std::string getItemsDescription() const;
 
     // --- Room Description ---
     // Provide a full description of the room including exits and items.
-    // This overrides the base getDescription for more detail.
-    std::string getDescription() const override;
+    std::string getDescription() const;
+    // Same text as getDescription(), without the copy. The rendered text is
+    // cached and only rebuilt after items, exits or the description change.
+    // The reference stays valid until the room is next modified.
+    const std::string &describe() const;
+    // Changing the base text also invalidates the cached description.
+    void setDescription(const std::string &description);
 
 private:
-    // Stores items currently in the room.
-    std::vector<Item> items_;
+    EntityStore *entities_;
+    EntityId entity_;
+    RoomId id_;
     // Stores exits: Key=direction (lowercase), Value=pointer to target room.
     std::map<std::string, Room *> exits_;
+    std::map<std::string, Room *> closedExits_; // Same, for closed doors
+
+    // Rendered output of describe(); rebuilt lazily when marked dirty.
+    mutable std::string descriptionCache_;
+    mutable bool descriptionDirty_ = true;
+    bool itemsChanged_ = false;
+
+    // The room's container component (where its item stacks live).
+    ItemContainer &items() { return entities_->container(entity_); }
+
+    // Append the item/exit lines to `out` without temporary streams.
+    void appendItemsDescription(std::string &out) const;
+    void appendExitsDescription(std::string &out) const;
 };
 
 #endif
\ No newline at end of file
@@ -0,0 +1,207 @@
+#include "Simulation.h"
+#include "World.h"
+#include <algorithm> // For std::push_heap, std::pop_heap
+#include <iterator>  // For std::next
+
+namespace
+{
+// Heap comparator: the earliest event (then the first scheduled) on top.
+struct LaterEvent
+{
+    template <typename Event>
+    bool operator()(const Event &a, const Event &b) const
+    {
+        return a.due != b.due ? a.due > b.due : a.sequence > b.sequence;
+    }
+};
+
+const std::vector<EntityId> kNobody;
+} // namespace
+
+Simulation::Simulation(World &world, std::uint64_t seed)
+    : world_(&world), rng_(seed), wheel_(kWheelSlots)
+{
+}
+
+// --- Content ---
+
+EntityId Simulation::addNpc(const std::string &name, const std::string &description, RoomId start, Tick period)
+{
+    EntityStore &entities = world_->entities();
+    EntityId entity = entities.create(name, description);
+    entities.setLocation(entity, world_->room(start).getEntity());
+    enterRoom(start, entity);
+
+    npcs_.push_back({entity, start, period});
+    schedule(EventKind::NpcMove, static_cast<std::uint32_t>(npcs_.size() - 1), period);
+    return entity;
+}
+
+void Simulation::addRespawn(RoomId room, ItemId item, std::uint32_t count, Tick period)
+{
+    respawns_.push_back({room, item, count, period});
+    schedule(EventKind::Respawn, static_cast<std::uint32_t>(respawns_.size() - 1), period);
+}
+
+bool Simulation::addTimedDoor(RoomId room, const std::string &direction, Tick period)
+{
+    Room &from = world_->room(room);
+    Room *target = from.getExit(direction);
+    if (target == nullptr)
+    {
+        return false;
+    }
+
+    Door door{room, direction, kNoRoom, std::string(), period, true};
+    for (const auto &exit : target->getExits())
+    {
+        if (exit.second == &from)
+        {
+            door.backRoom = target->getId();
+            door.backDirection = exit.first;
+            break;
+        }
+    }
+    doors_.push_back(std::move(door));
+    schedule(EventKind::Door, static_cast<std::uint32_t>(doors_.size() - 1), period);
+    return true;
+}
+
+// --- Scheduling ---
+
+void Simulation::schedule(EventKind kind, std::uint32_t source, Tick delay)
+{
+    Event event{now_ + std::max<Tick>(delay, 1), nextSequence_++, source, kind};
+    if (event.due - now_ < kWheelSlots)
+    {
+        wheel_[event.due & (kWheelSlots - 1)].push_back(event);
+    }
+    else
+    {
+        overflow_.push_back(event);
+        std::push_heap(overflow_.begin(), overflow_.end(), LaterEvent{});
+    }
+    ++pending_;
+}
+
+void Simulation::tick()
+{
+    // Far-off events that are now within the wheel's range move into their
+    // bucket. Their slot was drained on an earlier tick, so it is free.
+    while (!overflow_.empty() && overflow_.front().due - now_ < kWheelSlots)
+    {
+        std::pop_heap(overflow_.begin(), overflow_.end(), LaterEvent{});
+        wheel_[overflow_.back().due & (kWheelSlots - 1)].push_back(overflow_.back());
+        overflow_.pop_back();
+    }
+
+    // Every event in this bucket is due now. Rescheduling always lands at
+    // least one tick ahead, i.e. in another bucket, so the loop can't grow it.
+    std::vector<Event> &bucket = wheel_[now_ & (kWheelSlots - 1)];
+    for (std::size_t i = 0; i < bucket.size(); ++i)
+    {
+        fire(bucket[i]);
+    }
+    pending_ -= bucket.size();
+    processed_ += bucket.size();
+    bucket.clear(); // Keeps its capacity for the next lap
+    ++now_;
+}
+
+void Simulation::run(Tick ticks)
+{
+    for (Tick i = 0; i < ticks; ++i)
+    {
+        tick();
+    }
+}
+
+void Simulation::fire(const Event &event)
+{
+    // Every source is periodic: act, then queue the next occurrence.
+    switch (event.kind)
+    {
+    case EventKind::NpcMove:
+        moveNpc(npcs_[event.source]);
+        schedule(event.kind, event.source, npcs_[event.source].period);
+        break;
+    case EventKind::Respawn:
+        respawn(respawns_[event.source]);
+        schedule(event.kind, event.source, respawns_[event.source].period);
+        break;
+    case EventKind::Door:
+        toggleDoor(doors_[event.source]);
+        schedule(event.kind, event.source, doors_[event.source].period);
+        break;
+    }
+}
+
+// --- Event handlers ---
+
+void Simulation::moveNpc(Npc &npc)
+{
+    const std::map<std::string, Room *> &exits = world_->room(npc.room).getExits();
+    if (exits.empty())
+    {
+        return; // Shut in (e.g. behind a closed door); try again next time
+    }
+    Room &target = *std::next(exits.begin(), static_cast<std::ptrdiff_t>(rng_() % exits.size()))->second;
+
+    leaveRoom(npc.room, npc.entity);
+    enterRoom(target.getId(), npc.entity);
+    npc.room = target.getId();
+    world_->entities().setLocation(npc.entity, target.getEntity());
+}
+
+void Simulation::respawn(const Respawn &respawn)
+{
+    Room &room = world_->room(respawn.room);
+    std::uint32_t present = room.getItems().count(respawn.item);
+    if (present < respawn.count)
+    {
+        room.addItem(respawn.item, respawn.count - present);
+    }
+}
+
+void Simulation::toggleDoor(Door &door)
+{
+    door.open = !door.open;
+    world_->room(door.room).setExitOpen(door.direction, door.open);
+    if (door.backRoom != kNoRoom)
+    {
+        world_->room(door.backRoom).setExitOpen(door.backDirection, door.open);
+    }
+}
+
+// --- Room occupancy ---
+
+const std::vector<EntityId> &Simulation::npcsIn(RoomId room) const
+{
+    auto it = occupants_.find(room);
+    return it != occupants_.end() ? it->second : kNobody;
+}
+
+void Simulation::enterRoom(RoomId room, EntityId npc)
+{
+    occupants_[room].push_back(npc);
+}
+
+void Simulation::leaveRoom(RoomId room, EntityId npc)
+{
+    auto it = occupants_.find(room);
+    if (it == occupants_.end())
+    {
+        return;
+    }
+    std::vector<EntityId> &here = it->second;
+    auto found = std::find(here.begin(), here.end(), npc);
+    if (found != here.end())
+    {
+        *found = here.back(); // Swap-and-pop; order within a room doesn't matter
+        here.pop_back();
+    }
+    if (here.empty())
+    {
+        occupants_.erase(it); // Room is no longer active
+    }
+}
@@ -0,0 +1,144 @@
+#ifndef SIMULATION_H
+#define SIMULATION_H
+
+#include "Entities.h"
+#include "ItemRegistry.h"
+#include "Room.h"
+#include <cstdint>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+class World;
+
+// Simulation time in ticks. The game loop advances one tick per round of commands
+// (runGame, runRounds in Game.h), however many sessions share the simulation.
+using Tick = std::uint64_t;
+
+/**
+ * @brief Runs everything in a world that happens on its own: wandering NPCs,
+ *        respawning items and doors that open and close on a timer.
+ *
+ * The simulation is event-driven. Every NPC, respawn point and timed door
+ * keeps exactly one pending event, and a tick only runs the events due at
+ * that tick. Rooms where nothing is scheduled are never visited, so a tick
+ * costs O(events due) however large the world is.
+ *
+ * Pending events sit in a timing wheel with one bucket per tick for the next
+ * kWheelSlots ticks; events due further out wait in a min-heap and move into
+ * the wheel once they come within range. Same-tick events run in a fixed
+ * order and NPCs pick exits with a seeded std::mt19937_64, so the same seed
+ * and calls always play out the same way.
+ *
+ * Simulation state is not part of save files (see Snapshot.h): loading
+ * restores items and the player, and NPCs and doors carry on from where
+ * they are.
+ */
+class Simulation
+{
+public:
+    explicit Simulation(World &world, std::uint64_t seed = 1);
+
+    // NPC bookkeeping mirrors the world's entities; a copy would drift from it.
+    Simulation(const Simulation &) = delete;
+    Simulation &operator=(const Simulation &) = delete;
+
+    // --- Content ---
+    // Each source first fires `period` ticks from now and then repeats every
+    // `period` ticks (a period of 0 counts as 1).
+
+    // Create an NPC entity in `start` that walks through a random open exit
+    // every `period` ticks.
+    EntityId addNpc(const std::string &name, const std::string &description, RoomId start, Tick period);
+    // Every `period` ticks, top the room back up to `count` of `item`.
+    void addRespawn(RoomId room, ItemId item, std::uint32_t count, Tick period);
+    // Every `period` ticks, close the exit, or reopen it if it is closed. The
+    // exit leading straight back from the other side, if any, follows along.
+    // Returns false if `room` has no open exit in that direction.
+    bool addTimedDoor(RoomId room, const std::string &direction, Tick period);
+
+    // --- Running ---
+    Tick now() const { return now_; }
+    // Run the events due at the current tick, then move on to the next tick.
+    void tick();
+    void run(Tick ticks);
+
+    // --- Queries ---
+    // NPCs currently in a room (empty for most rooms).
+    const std::vector<EntityId> &npcsIn(RoomId room) const;
+    // Number of rooms with at least one NPC in them.
+    std::size_t activeRoomCount() const { return occupants_.size(); }
+    std::size_t pendingEvents() const { return pending_; }
+    std::uint64_t eventsProcessed() const { return processed_; }
+
+private:
+    static constexpr Tick kWheelSlots = 1024; // Power of two
+
+    enum class EventKind : std::uint8_t
+    {
+        NpcMove,
+        Respawn,
+        Door
+    };
+
+    struct Event
+    {
+        Tick due;
+        std::uint64_t sequence; // Orders events due on the same tick in the heap
+        std::uint32_t source;   // Index into npcs_, respawns_ or doors_
+        EventKind kind;
+    };
+
+    // --- Event sources ---
+    struct Npc
+    {
+        EntityId entity;
+        RoomId room;
+        Tick period;
+    };
+    struct Respawn
+    {
+        RoomId room;
+        ItemId item;
+        std::uint32_t count;
+        Tick period;
+    };
+    struct Door
+    {
+        RoomId room;
+        std::string direction;
+        RoomId backRoom; // kNoRoom if the exit has no way back
+        std::string backDirection;
+        Tick period;
+        bool open;
+    };
+
+    World *world_;
+    std::mt19937_64 rng_;
+    Tick now_ = 0;
+    std::uint64_t nextSequence_ = 0;
+    std::size_t pending_ = 0;
+    std::uint64_t processed_ = 0;
+
+    std::vector<std::vector<Event>> wheel_; // Bucket i holds events due at ticks == i (mod kWheelSlots)
+    std::vector<Event> overflow_;           // Min-heap of events beyond the wheel's range
+
+    std::vector<Npc> npcs_;
+    std::vector<Respawn> respawns_;
+    std::vector<Door> doors_;
+    // NPCs per room, only for rooms that have any.
+    std::unordered_map<RoomId, std::vector<EntityId>> occupants_;
+
+    void schedule(EventKind kind, std::uint32_t source, Tick delay);
+    void fire(const Event &event);
+
+    void moveNpc(Npc &npc);
+    void respawn(const Respawn &respawn);
+    void toggleDoor(Door &door);
+
+    void enterRoom(RoomId room, EntityId npc);
+    void leaveRoom(RoomId room, EntityId npc);
+};
+
+#endif // SIMULATION_H
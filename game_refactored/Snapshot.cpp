@@ -0,0 +1,235 @@
+#include "Snapshot.h"
+#include "Player.h"
+#include "World.h"
+#include <cstdint>
+#include <cstring>  // For std::memcmp
+#include <fstream>  // For file input/output
+
+namespace
+{
+const char kMagic[4] = {'W', 'C', 'S', '1'};
+
+// --- Encoding helpers (fixed little-endian layout, independent of the host) ---
+
+void putU32(std::vector<char> &out, std::uint32_t value)
+{
+    out.push_back(static_cast<char>(value & 0xFF));
+    out.push_back(static_cast<char>((value >> 8) & 0xFF));
+    out.push_back(static_cast<char>((value >> 16) & 0xFF));
+    out.push_back(static_cast<char>((value >> 24) & 0xFF));
+}
+
+void putStacks(std::vector<char> &out, const std::vector<ItemStack> &stacks)
+{
+    putU32(out, static_cast<std::uint32_t>(stacks.size()));
+    for (const ItemStack &stack : stacks)
+    {
+        putU32(out, stack.id);
+        putU32(out, stack.count);
+    }
+}
+
+// --- Decoding helpers ---
+
+// Bounds-checked cursor over the input. Once a read fails, every further
+// read fails too, so callers only need to check ok() at the end.
+class Reader
+{
+public:
+    Reader(const char *data, std::size_t size)
+        : pos_(reinterpret_cast<const unsigned char *>(data)), end_(pos_ + size) {}
+
+    std::uint32_t u32()
+    {
+        if (!ok_ || end_ - pos_ < 4)
+        {
+            ok_ = false;
+            return 0;
+        }
+        std::uint32_t value = static_cast<std::uint32_t>(pos_[0]) |
+                              (static_cast<std::uint32_t>(pos_[1]) << 8) |
+                              (static_cast<std::uint32_t>(pos_[2]) << 16) |
+                              (static_cast<std::uint32_t>(pos_[3]) << 24);
+        pos_ += 4;
+        return value;
+    }
+
+    // Append `n` stacks to `out`, rejecting unknown prototypes and empty stacks.
+    void stacks(std::uint32_t n, std::size_t prototypeCount, std::vector<ItemStack> &out)
+    {
+        if (!ok_ || static_cast<std::size_t>(end_ - pos_) / 8 < n)
+        {
+            ok_ = false; // Also guards against huge counts from corrupt files
+            return;
+        }
+        for (std::uint32_t i = 0; i < n; ++i)
+        {
+            ItemStack stack{u32(), u32()};
+            if (stack.id >= prototypeCount || stack.count == 0)
+            {
+                ok_ = false;
+                return;
+            }
+            out.push_back(stack);
+        }
+    }
+
+    bool ok() const { return ok_; }
+    bool atEnd() const { return pos_ == end_; }
+
+private:
+    const unsigned char *pos_;
+    const unsigned char *end_;
+    bool ok_ = true;
+};
+
+// One changed room inside a decoded snapshot.
+struct RoomDelta
+{
+    RoomId room;
+    std::size_t first; // Range in the flat stack list
+    std::size_t last;
+};
+} // namespace
+
+void encodeSnapshot(const World &world, const Player &player, std::vector<char> &out)
+{
+    out.assign(kMagic, kMagic + sizeof(kMagic));
+    putU32(out, static_cast<std::uint32_t>(world.roomCount()));
+    putU32(out, static_cast<std::uint32_t>(world.items().size()));
+
+    // Player state is small, so it is always written in full.
+    putU32(out, player.location() ? player.location()->getId() : 0);
+    putStacks(out, player.inventory().stacks());
+
+    // Reserve the changed-room count and patch it once the rooms are written.
+    std::size_t countOffset = out.size();
+    putU32(out, 0);
+    std::uint32_t changedRooms = 0;
+    for (std::size_t i = 0; i < world.roomCount(); ++i)
+    {
+        const Room &room = world.room(static_cast<RoomId>(i));
+        if (!room.itemsChanged())
+        {
+            continue; // Still matches the world definition
+        }
+        putU32(out, room.getId());
+        putStacks(out, room.getItems().stacks());
+        ++changedRooms;
+    }
+    for (int b = 0; b < 4; ++b)
+    {
+        out[countOffset + b] = static_cast<char>((changedRooms >> (8 * b)) & 0xFF);
+    }
+}
+
+bool decodeSnapshot(const char *data, std::size_t size, World &world, Player &player)
+{
+    if (size < sizeof(kMagic) || std::memcmp(data, kMagic, sizeof(kMagic)) != 0)
+    {
+        return false;
+    }
+    Reader in(data + sizeof(kMagic), size - sizeof(kMagic));
+
+    // The snapshot only makes sense against the same world definition.
+    std::size_t roomCount = world.roomCount();
+    std::size_t prototypeCount = world.items().size();
+    if (in.u32() != roomCount || in.u32() != prototypeCount)
+    {
+        return false;
+    }
+
+    // 1. Parse and validate everything into temporaries.
+    std::uint32_t playerRoom = in.u32();
+    std::vector<ItemStack> inventory;
+    in.stacks(in.u32(), prototypeCount, inventory);
+
+    std::vector<RoomDelta> deltas;
+    std::vector<ItemStack> roomStacks;
+    std::uint32_t changedRooms = in.u32();
+    for (std::uint32_t i = 0; i < changedRooms && in.ok(); ++i)
+    {
+        RoomDelta delta{in.u32(), roomStacks.size(), 0};
+        in.stacks(in.u32(), prototypeCount, roomStacks);
+        delta.last = roomStacks.size();
+        if (delta.room >= roomCount)
+        {
+            return false;
+        }
+        deltas.push_back(delta);
+    }
+    if (!in.ok() || !in.atEnd() || playerRoom >= roomCount)
+    {
+        return false;
+    }
+
+    // 2. Apply: reset rooms changed in this session, then replay the deltas.
+    for (std::size_t i = 0; i < roomCount; ++i)
+    {
+        if (world.room(static_cast<RoomId>(i)).itemsChanged())
+        {
+            world.restoreDefinition(static_cast<RoomId>(i));
+        }
+    }
+    for (const RoomDelta &delta : deltas)
+    {
+        world.room(delta.room).replaceItems(roomStacks.data() + delta.first,
+                                            roomStacks.data() + delta.last);
+    }
+
+    player.moveTo(world.room(playerRoom));
+    player.inventory().clear();
+    for (const ItemStack &stack : inventory)
+    {
+        player.inventory().add(stack.id, stack.count);
+    }
+    return true;
+}
+
+SnapshotStatus saveSnapshot(const World &world, const Player &player, const std::string &path)
+{
+    std::vector<char> buffer;
+    encodeSnapshot(world, player, buffer);
+
+    std::ofstream outFile(path, std::ios::binary | std::ios::trunc);
+    if (!outFile.is_open())
+    {
+        return SnapshotStatus::OpenFailed;
+    }
+    outFile.write(buffer.data(), static_cast<std::streamsize>(buffer.size())); // One sequential write
+    return outFile ? SnapshotStatus::Ok : SnapshotStatus::WriteFailed;
+}
+
+SnapshotStatus loadSnapshot(World &world, Player &player, const std::string &path)
+{
+    std::ifstream inFile(path, std::ios::binary | std::ios::ate); // Open at the end to get the size
+    if (!inFile.is_open())
+    {
+        return SnapshotStatus::OpenFailed;
+    }
+    std::vector<char> buffer(static_cast<std::size_t>(inFile.tellg()));
+    inFile.seekg(0);
+    if (!inFile.read(buffer.data(), static_cast<std::streamsize>(buffer.size()))) // One sequential read
+    {
+        return SnapshotStatus::ReadFailed;
+    }
+    return decodeSnapshot(buffer.data(), buffer.size(), world, player) ? SnapshotStatus::Ok : SnapshotStatus::Corrupt;
+}
+
+const char *snapshotStatusMessage(SnapshotStatus status)
+{
+    switch (status)
+    {
+    case SnapshotStatus::Ok:
+        return "OK";
+    case SnapshotStatus::OpenFailed:
+        return "Could not open save file";
+    case SnapshotStatus::WriteFailed:
+        return "Failed to write save file";
+    case SnapshotStatus::ReadFailed:
+        return "Failed to read save file";
+    case SnapshotStatus::Corrupt:
+        return "Save file is corrupt or belongs to a different world";
+    }
+    return "Unknown save file error";
+}
@@ -0,0 +1,47 @@
+#ifndef SNAPSHOT_H
+#define SNAPSHOT_H
+
+#include <string>
+#include <vector>
+
+class World;
+class Player;
+
+/**
+ * Save files store only the mutable state of a session, as a delta against
+ * the sealed world definition (World::sealDefinition):
+ *
+ *   header    magic "WCS1", room count, prototype count (little-endian u32s)
+ *   player    room id, inventory stack count, stacks (id, count)
+ *   rooms     changed room count, then per room: id, stack count, stacks
+ *
+ * Rooms whose items never changed are not written at all. The whole file is
+ * built in memory and written (or read) in one sequential operation.
+ */
+
+// Serialize the session state into `out` (replacing its contents).
+void encodeSnapshot(const World &world, const Player &player, std::vector<char> &out);
+
+// Apply an encoded snapshot. The data is fully validated before anything is
+// changed, so on failure (returns false) the world and player are untouched.
+bool decodeSnapshot(const char *data, std::size_t size, World &world, Player &player);
+
+// Outcome of a file save or load. Nothing is printed; the caller reports it
+// (GameSession writes it to its own output).
+enum class SnapshotStatus
+{
+    Ok,
+    OpenFailed,  // The file could not be opened
+    WriteFailed, // Opened, but writing it failed
+    ReadFailed,  // Opened, but reading it failed
+    Corrupt,     // Read, but corrupt or from a different world; nothing was changed
+};
+
+// File wrappers around encode/decode.
+SnapshotStatus saveSnapshot(const World &world, const Player &player, const std::string &path);
+SnapshotStatus loadSnapshot(World &world, Player &player, const std::string &path);
+
+// "Could not open save file", ... for a status other than Ok.
+const char *snapshotStatusMessage(SnapshotStatus status);
+
+#endif // SNAPSHOT_H
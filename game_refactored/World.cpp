@@ -0,0 +1,82 @@
+#include "World.h"
+
+Room &World::addRoom(const std::string &name, const std::string &description)
+{
+    RoomId id = static_cast<RoomId>(rooms_.size());
+    Room &room = rooms_.emplace_back(entities_, items_, id, name, description);
+
+    roomOfEntity_.resize(entities_.size(), kNoRoom);
+    roomOfEntity_[room.getEntity()] = id;
+    return room;
+}
+
+Room *World::roomForEntity(EntityId entity)
+{
+    if (entity >= roomOfEntity_.size() || roomOfEntity_[entity] == kNoRoom)
+    {
+        return nullptr;
+    }
+    return &rooms_[roomOfEntity_[entity]];
+}
+
+std::vector<std::uint64_t> World::itemTotalsReachableFrom(RoomId start) const
+{
+    std::vector<std::uint64_t> totals(items_.size(), 0);
+    if (start >= rooms_.size())
+    {
+        return totals;
+    }
+
+    // Breadth-first walk over the exit graph; `frontier` doubles as the queue.
+    std::vector<bool> visited(rooms_.size(), false);
+    std::vector<RoomId> frontier{start};
+    visited[start] = true;
+    for (std::size_t next = 0; next < frontier.size(); ++next)
+    {
+        const Room &room = rooms_[frontier[next]];
+        for (const ItemStack &stack : entities_.container(room.getEntity()).stacks())
+        {
+            totals[stack.id] += stack.count;
+        }
+        for (const auto &exit : room.getExits())
+        {
+            RoomId target = exit.second->getId();
+            if (!visited[target])
+            {
+                visited[target] = true;
+                frontier.push_back(target);
+            }
+        }
+    }
+    return totals;
+}
+
+void World::sealDefinition()
+{
+    definitionOffsets_.clear();
+    definitionStacks_.clear();
+    definitionOffsets_.reserve(rooms_.size() + 1);
+
+    for (Room &room : rooms_)
+    {
+        definitionOffsets_.push_back(static_cast<std::uint32_t>(definitionStacks_.size()));
+        const std::vector<ItemStack> &stacks = room.getItems().stacks();
+        definitionStacks_.insert(definitionStacks_.end(), stacks.begin(), stacks.end());
+        room.markItemsPristine();
+    }
+    definitionOffsets_.push_back(static_cast<std::uint32_t>(definitionStacks_.size()));
+}
+
+void World::restoreDefinition(RoomId id)
+{
+    if (id + 1 >= definitionOffsets_.size())
+    {
+        return; // Room was added after sealing; it has no definition
+    }
+    const ItemStack *first = definitionStacks_.data() + definitionOffsets_[id];
+    const ItemStack *last = definitionStacks_.data() + definitionOffsets_[id + 1];
+
+    Room &target = rooms_[id];
+    target.replaceItems(first, last);
+    target.markItemsPristine();
+}
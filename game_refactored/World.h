@@ -0,0 +1,73 @@
+#ifndef WORLD_H
+#define WORLD_H
+
+#include "Entities.h"
+#include "ItemRegistry.h"
+#include "Room.h"
+#include <cstdint>
+#include <deque>
+#include <string>
+#include <vector>
+
+constexpr RoomId kNoRoom = static_cast<RoomId>(-1);
+
+/**
+ * @brief Owns every room, item prototype and player of one game world.
+ *
+ * All of them are entities in one EntityStore (see Entities.h); the Room
+ * objects add exits on top of their entity's components.
+ *
+ * The world is built once (rooms, exits, initial item placement) and then
+ * sealed. The sealed item placement is the static world definition that
+ * save files are written as deltas against (see Snapshot.h).
+ */
+class World
+{
+public:
+    World() = default;
+
+    // Rooms keep pointers into the world, so it cannot be copied or moved.
+    World(const World &) = delete;
+    World &operator=(const World &) = delete;
+
+    EntityStore &entities() { return entities_; }
+    const EntityStore &entities() const { return entities_; }
+    ItemRegistry &items() { return items_; }
+    const ItemRegistry &items() const { return items_; }
+
+    // Create a room. Rooms are numbered 0, 1, 2... in creation order and
+    // their addresses stay valid for the lifetime of the world.
+    Room &addRoom(const std::string &name, const std::string &description);
+
+    std::size_t roomCount() const { return rooms_.size(); }
+    Room &room(RoomId id) { return rooms_[id]; }
+    const Room &room(RoomId id) const { return rooms_[id]; }
+    // The room a room entity belongs to, or nullptr for non-room entities.
+    Room *roomForEntity(EntityId entity);
+
+    // --- Queries ---
+    // Total count of every item kind lying in rooms reachable from `start`
+    // (including `start`), indexed by ItemId. Walks the exit graph once and
+    // reads item stacks straight from the packed container components.
+    std::vector<std::uint64_t> itemTotalsReachableFrom(RoomId start) const;
+
+    // Record the current item placement as the world definition and mark
+    // every room as unchanged. Call once, after building the world.
+    void sealDefinition();
+
+    // Put a room's items back to how the definition placed them.
+    void restoreDefinition(RoomId id);
+
+private:
+    EntityStore entities_; // Declared first: the registry and rooms refer to it
+    ItemRegistry items_{entities_};
+    std::deque<Room> rooms_;           // deque: growing never moves existing rooms
+    std::vector<RoomId> roomOfEntity_; // Entity -> room index (kNoRoom if not a room)
+
+    // Initial stacks per room, stored flat: room i owns
+    // definitionStacks_[definitionOffsets_[i] .. definitionOffsets_[i + 1]).
+    std::vector<std::uint32_t> definitionOffsets_;
+    std::vector<ItemStack> definitionStacks_;
+};
+
+#endif // WORLD_H
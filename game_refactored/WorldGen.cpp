@@ -0,0 +1,53 @@
+#include "WorldGen.h"
+#include "World.h"
+#include <cmath>  // For std::sqrt, std::ceil
+#include <random> // For std::mt19937_64
+#include <string>
+
+namespace
+{
+const char *const kItemNames[] = {
+    "Gold Coin", "Silver Coin", "Copper Coin", "Bone", "Skull", "Torch",
+    "Rusty Key", "Iron Key", "Candle", "Rope", "Dagger", "Shield",
+    "Potion", "Scroll", "Gem", "Ring"};
+const std::size_t kItemKinds = sizeof(kItemNames) / sizeof(kItemNames[0]);
+} // namespace
+
+void buildGridWorld(World &world, std::size_t roomCount, std::uint64_t seed)
+{
+    std::mt19937_64 rng(seed);
+    ItemRegistry &items = world.items();
+    for (const char *name : kItemNames)
+    {
+        items.define(name, std::string("A common ") + name + ".");
+    }
+
+    // Rooms are laid out row by row on a width x width grid.
+    std::size_t width = static_cast<std::size_t>(std::ceil(std::sqrt(static_cast<double>(roomCount))));
+    for (std::size_t i = 0; i < roomCount; ++i)
+    {
+        Room &room = world.addRoom("Cell " + std::to_string(i),
+                                   "A bare stone cell, one of many in the catacombs.");
+        std::size_t stacks = rng() % 3; // 0-2 stacks per room
+        for (std::size_t s = 0; s < stacks; ++s)
+        {
+            room.addItem(static_cast<ItemId>(rng() % kItemKinds), 1 + static_cast<std::uint32_t>(rng() % 5));
+        }
+    }
+
+    for (std::size_t i = 0; i < roomCount; ++i)
+    {
+        Room &room = world.room(static_cast<RoomId>(i));
+        std::size_t column = i % width;
+        if (i >= width)
+            room.addExit("north", &world.room(static_cast<RoomId>(i - width)));
+        if (i + width < roomCount)
+            room.addExit("south", &world.room(static_cast<RoomId>(i + width)));
+        if (column > 0)
+            room.addExit("west", &world.room(static_cast<RoomId>(i - 1)));
+        if (column + 1 < width && i + 1 < roomCount)
+            room.addExit("east", &world.room(static_cast<RoomId>(i + 1)));
+    }
+
+    world.sealDefinition();
+}
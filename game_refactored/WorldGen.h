@@ -0,0 +1,17 @@
+#ifndef WORLDGEN_H
+#define WORLDGEN_H
+
+#include <cstddef>
+#include <cstdint>
+
+class World;
+
+/**
+ * @brief Fill an empty world with a square grid of `roomCount` rooms linked
+ *        north/south/east/west, plus a few seeded random item stacks per
+ *        room, then seal it. Used by the headless benchmarks; the same seed
+ *        always produces the same world.
+ */
+void buildGridWorld(World &world, std::size_t roomCount, std::uint64_t seed);
+
+#endif // WORLDGEN_H
@@ -0,0 +1,163 @@
+#include "Zones.h"
+#include "World.h"
+#include <algorithm> // For std::find
+
+namespace
+{
+// Calls `visit` with every room one exit away from `room`, closed doors included.
+template <typename Visit>
+void forEachNeighbor(const Room &room, Visit visit)
+{
+    for (const auto &exit : room.getExits())
+    {
+        visit(*exit.second);
+    }
+    for (const auto &exit : room.getClosedExits())
+    {
+        visit(*exit.second);
+    }
+}
+} // namespace
+
+ZoneMap::ZoneMap(const World &world, std::size_t maxZoneRooms)
+    : world_(&world)
+{
+    const ZoneId unassigned = static_cast<ZoneId>(-1);
+    std::size_t roomCount = world.roomCount();
+    if (maxZoneRooms == 0)
+    {
+        maxZoneRooms = 1;
+    }
+
+    // Grow zones breadth-first from the lowest unassigned room, so each zone
+    // is a connected patch of the map.
+    zoneOfRoom_.assign(roomCount, unassigned);
+    std::vector<RoomId> frontier;
+    for (std::size_t seed = 0; seed < roomCount; ++seed)
+    {
+        if (zoneOfRoom_[seed] != unassigned)
+        {
+            continue;
+        }
+        ZoneId zone = static_cast<ZoneId>(zones_.size());
+        zones_.emplace_back();
+
+        frontier.assign(1, static_cast<RoomId>(seed));
+        zoneOfRoom_[seed] = zone;
+        std::size_t size = 1;
+        for (std::size_t next = 0; next < frontier.size() && size < maxZoneRooms; ++next)
+        {
+            forEachNeighbor(world.room(frontier[next]), [&](const Room &neighbor)
+                            {
+                                if (size < maxZoneRooms && zoneOfRoom_[neighbor.getId()] == unassigned)
+                                {
+                                    zoneOfRoom_[neighbor.getId()] = zone;
+                                    frontier.push_back(neighbor.getId());
+                                    ++size;
+                                } });
+        }
+    }
+
+    // A room's events can reach its own zone and those of its neighbors.
+    interestOffsets_.reserve(roomCount + 1);
+    for (std::size_t id = 0; id < roomCount; ++id)
+    {
+        std::size_t first = interestZones_.size();
+        interestOffsets_.push_back(static_cast<std::uint32_t>(first));
+        interestZones_.push_back(zoneOfRoom_[id]);
+        forEachNeighbor(world.room(static_cast<RoomId>(id)), [&](const Room &neighbor)
+                        {
+                            ZoneId zone = zoneOfRoom_[neighbor.getId()];
+                            if (std::find(interestZones_.begin() + first, interestZones_.end(), zone) == interestZones_.end())
+                            {
+                                interestZones_.push_back(zone);
+                            } });
+    }
+    interestOffsets_.push_back(static_cast<std::uint32_t>(interestZones_.size()));
+}
+
+// --- Subscribers ---
+
+ZoneMap::SubscriberId ZoneMap::subscribe(EventListener &listener, RoomId room)
+{
+    SubscriberId id;
+    if (!freeSubscribers_.empty())
+    {
+        id = freeSubscribers_.back();
+        freeSubscribers_.pop_back();
+    }
+    else
+    {
+        id = static_cast<SubscriberId>(subscribers_.size());
+        subscribers_.emplace_back();
+    }
+    subscribers_[id] = {&listener, room, 0};
+    joinZone(id);
+    return id;
+}
+
+void ZoneMap::moveSubscriber(SubscriberId id, RoomId room)
+{
+    Subscriber &subscriber = subscribers_[id];
+    if (zoneOfRoom_[subscriber.room] == zoneOfRoom_[room])
+    {
+        subscriber.room = room; // Same zone: nothing to relink
+        return;
+    }
+    leaveZone(id);
+    subscriber.room = room;
+    joinZone(id);
+}
+
+void ZoneMap::unsubscribe(SubscriberId id)
+{
+    leaveZone(id);
+    subscribers_[id].listener = nullptr;
+    freeSubscribers_.push_back(id);
+}
+
+void ZoneMap::joinZone(SubscriberId id)
+{
+    std::vector<SubscriberId> &members = zones_[zoneOfRoom_[subscribers_[id].room]];
+    subscribers_[id].slot = static_cast<std::uint32_t>(members.size());
+    members.push_back(id);
+}
+
+void ZoneMap::leaveZone(SubscriberId id)
+{
+    std::vector<SubscriberId> &members = zones_[zoneOfRoom_[subscribers_[id].room]];
+    std::uint32_t slot = subscribers_[id].slot;
+    members[slot] = members.back(); // Swap-and-pop, fixing up the moved member's slot
+    subscribers_[members[slot]].slot = slot;
+    members.pop_back();
+}
+
+// --- Events ---
+
+std::size_t ZoneMap::publish(const WorldEvent &event)
+{
+    // Rooms that hear the event: where it happened and one open exit away.
+    const Room &origin = world_->room(event.room);
+    hearing_.assign(1, event.room);
+    for (const auto &exit : origin.getExits())
+    {
+        hearing_.push_back(exit.second->getId());
+    }
+
+    std::size_t delivered = 0;
+    const ZoneId *first = interestZones_.data() + interestOffsets_[event.room];
+    const ZoneId *last = interestZones_.data() + interestOffsets_[event.room + 1];
+    for (const ZoneId *zone = first; zone != last; ++zone)
+    {
+        for (SubscriberId id : zones_[*zone])
+        {
+            const Subscriber &subscriber = subscribers_[id];
+            if (std::find(hearing_.begin(), hearing_.end(), subscriber.room) != hearing_.end())
+            {
+                subscriber.listener->onEvent(event);
+                ++delivered;
+            }
+        }
+    }
+    return delivered;
+}
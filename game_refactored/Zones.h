@@ -0,0 +1,106 @@
+#ifndef ZONES_H
+#define ZONES_H
+
+#include "Entities.h"
+#include "ItemRegistry.h"
+#include "Room.h"
+#include <cstdint>
+#include <vector>
+
+class World;
+
+/**
+ * @brief Something that happened in a room that nearby players may notice.
+ */
+struct WorldEvent
+{
+    enum class Kind : std::uint8_t
+    {
+        Arrived,    // `actor` entered `room`
+        Left,       // `actor` left `room`
+        TookItem,   // `actor` picked up one `item` in `room`
+        DroppedItem // `actor` put down one `item` in `room`
+    };
+
+    Kind kind;
+    RoomId room;
+    EntityId actor;
+    ItemId item = 0; // Only for TookItem / DroppedItem
+};
+
+/**
+ * @brief Receives the events published near the room it is subscribed to.
+ */
+class EventListener
+{
+public:
+    virtual ~EventListener() = default;
+    virtual void onEvent(const WorldEvent &event) = 0;
+};
+
+/**
+ * @brief Partitions a world's rooms into zones and routes events only to
+ *        the listeners that can notice them.
+ *
+ * An event in a room reaches listeners in that room or in a room one open
+ * exit away. Instead of checking every listener in the world per event,
+ * rooms are grouped into connected zones of up to `maxZoneRooms` rooms, each
+ * zone keeps the list of listeners currently inside it, and every room
+ * knows which zones it and its neighbors belong to (usually one or two).
+ * Publishing an event only walks the listeners of those zones, so its cost
+ * depends on how crowded the area is, not on how many players are online.
+ *
+ * Zones are computed once, from the rooms and exits (open or closed) that
+ * exist when the map is built, so build it after the world is complete.
+ * Listeners must not subscribe, move or unsubscribe while an event is being
+ * delivered to them.
+ */
+class ZoneMap
+{
+public:
+    using ZoneId = std::uint32_t;
+    using SubscriberId = std::uint32_t;
+
+    explicit ZoneMap(const World &world, std::size_t maxZoneRooms = 64);
+
+    std::size_t zoneCount() const { return zones_.size(); }
+    ZoneId zoneOf(RoomId room) const { return zoneOfRoom_[room]; }
+
+    // --- Subscribers ---
+    // Start delivering events around `room` to `listener`.
+    SubscriberId subscribe(EventListener &listener, RoomId room);
+    // The listener changed rooms (possibly into another zone).
+    void moveSubscriber(SubscriberId id, RoomId room);
+    void unsubscribe(SubscriberId id);
+
+    // --- Events ---
+    // Deliver the event to every listener in event.room or a room one open
+    // exit away from it. Returns the number of deliveries.
+    std::size_t publish(const WorldEvent &event);
+
+private:
+    struct Subscriber
+    {
+        EventListener *listener; // nullptr for a free slot
+        RoomId room;
+        std::uint32_t slot; // Position in its zone's member list
+    };
+
+    const World *world_;
+    std::vector<ZoneId> zoneOfRoom_;
+    std::vector<std::vector<SubscriberId>> zones_; // Members of each zone
+
+    // Zones a room's events can reach, stored flat: room i owns
+    // interestZones_[interestOffsets_[i] .. interestOffsets_[i + 1]).
+    std::vector<std::uint32_t> interestOffsets_;
+    std::vector<ZoneId> interestZones_;
+
+    std::vector<Subscriber> subscribers_;
+    std::vector<SubscriberId> freeSubscribers_; // Slots to reuse
+    std::vector<RoomId> hearing_;               // Scratch for publish()
+
+    void joinZone(SubscriberId id);
+    void leaveZone(SubscriberId id);
+};
+
+#endif // ZONES_H
@@ -0,0 +1,128 @@
+// Headless throughput benchmark for the game engine.
+//
+// Usage: game_bench [rooms] [bots] [commands per bot] [threads] [seed]
+//
+// Every thread gets its own grid world and runs `bots` seeded random-walk
+// bots against it (sessions in one world run one after another; worlds are
+// never shared between threads). Output goes to a discarding sink so the
+// numbers measure the engine, not the terminal. The final state hash only
+// depends on the arguments, which makes runs easy to compare.
+
+#include "Bot.h"
+#include "Game.h"
+#include "Player.h"
+#include "World.h"
+#include "WorldGen.h"
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <memory>
+#include <ostream>
+#include <streambuf>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace
+{
+// A stream buffer that throws everything away.
+class NullBuffer : public std::streambuf
+{
+protected:
+    int overflow(int c) override { return c; }
+    std::streamsize xsputn(const char *, std::streamsize n) override { return n; }
+};
+
+struct RunResult
+{
+    std::size_t commands = 0;
+    std::uint64_t stateHash = 0;
+};
+
+// Drive `bots` random-walk sessions through a (pre-built) world.
+RunResult runBots(World &world, std::size_t bots, std::size_t commandsPerBot, std::uint64_t seed)
+{
+    NullBuffer nullBuffer;
+    std::ostream sink(&nullBuffer);
+
+    RunResult result;
+    for (std::size_t b = 0; b < bots; ++b)
+    {
+        Player player(world, world.room(static_cast<RoomId>((seed + b * 7919) % world.roomCount())));
+
+        GameSession session(world, player, sink);
+        RandomWalkBot bot(player, seed * 1000003 + b, commandsPerBot);
+        result.commands += runGame(session, bot);
+
+        // Fold where the bot ended up and what it carries into the hash.
+        result.stateHash = result.stateHash * 1099511628211ULL + player.location()->getId();
+        for (const ItemStack &stack : player.inventory().stacks())
+        {
+            result.stateHash = result.stateHash * 31 + stack.id * 131 + stack.count;
+        }
+    }
+    return result;
+}
+
+double secondsSince(std::chrono::steady_clock::time_point start)
+{
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+} // namespace
+
+int main(int argc, char *argv[])
+{
+    std::size_t rooms = argc > 1 ? std::stoul(argv[1]) : 10000;
+    std::size_t bots = argc > 2 ? std::stoul(argv[2]) : 64;
+    std::size_t commandsPerBot = argc > 3 ? std::stoul(argv[3]) : 10000;
+    std::size_t threads = argc > 4 ? std::stoul(argv[4]) : std::thread::hardware_concurrency();
+    std::uint64_t seed = argc > 5 ? std::stoull(argv[5]) : 42;
+    if (threads == 0)
+    {
+        threads = 1;
+    }
+
+    std::cout << "rooms=" << rooms << " bots=" << bots << " commands/bot=" << commandsPerBot
+              << " seed=" << seed << "\n";
+
+    // Worlds are built up front so only command execution is timed.
+    std::vector<std::unique_ptr<World>> worlds;
+    for (std::size_t t = 0; t < threads + 1; ++t)
+    {
+        worlds.push_back(std::make_unique<World>());
+        buildGridWorld(*worlds.back(), rooms, seed + (t == 0 ? 0 : t - 1));
+    }
+
+    // --- Single thread ---
+    auto start = std::chrono::steady_clock::now();
+    RunResult single = runBots(*worlds[0], bots, commandsPerBot, seed);
+    double singleSeconds = secondsSince(start);
+    std::cout << "1 thread:  " << single.commands << " commands in " << singleSeconds << " s = "
+              << static_cast<std::uint64_t>(single.commands / singleSeconds) << " commands/sec"
+              << " (state hash " << std::hex << single.stateHash << std::dec << ")\n";
+
+    // --- N threads, one world each ---
+    std::vector<RunResult> results(threads);
+    std::vector<std::thread> workers;
+    start = std::chrono::steady_clock::now();
+    for (std::size_t t = 0; t < threads; ++t)
+    {
+        workers.emplace_back([&, t]
+                             { results[t] = runBots(*worlds[t + 1], bots, commandsPerBot, seed + t); });
+    }
+    for (std::thread &worker : workers)
+    {
+        worker.join();
+    }
+    double multiSeconds = secondsSince(start);
+
+    std::size_t totalCommands = 0;
+    for (const RunResult &result : results)
+    {
+        totalCommands += result.commands;
+    }
+    std::cout << threads << " threads: " << totalCommands << " commands in " << multiSeconds << " s = "
+              << static_cast<std::uint64_t>(totalCommands / multiSeconds) << " commands/sec"
+              << " (thread 0 state hash " << std::hex << results[0].stateHash << std::dec << ")\n";
+    return 0;
+}
@@ -0,0 +1,123 @@
+// Benchmark for fuzzy item-name matching.
+//
+// Usage: match_bench [item kinds] [queries] [seed]
+//
+// Defines `item kinds` item names ("cursed lantern", "rusty dagger of kings",
+// ...; up to 18,000 distinct ones), puts
+// every one of them on a room floor and half of them in an inventory, then
+// resolves `queries` mistyped names (a random swap, drop, insert or change of
+// one letter, or a plural) with ItemContainer::closestMatches and reports the
+// time per lookup and how often the intended item came back as the only
+// answer.
+
+#include "Entities.h"
+#include "ItemContainer.h"
+#include "ItemRegistry.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace
+{
+const char *const kAdjectives[] = {
+    "cursed", "rusty", "gilded", "broken", "ancient", "bloody", "silver", "golden", "crooked", "hollow",
+    "cracked", "runed", "blessed", "rotten", "jagged", "polished", "tarnished", "sealed", "burnt", "frozen",
+    "dusty", "hidden", "glowing", "heavy", "tiny", "grim", "pale", "shadow", "ember", "iron"};
+const char *const kNouns[] = {
+    "lantern", "dagger", "chalice", "amulet", "grimoire", "key", "skull", "coin", "ring", "shield",
+    "helmet", "candle", "scroll", "potion", "gauntlet", "crown", "mirror", "idol", "rope", "hammer",
+    "bell", "compass", "flute", "mask", "quill", "lockpick", "tooth", "feather", "vial", "torch"};
+const char *const kOrigins[] = {
+    "", " of kings", " of ashes", " of the deep", " of thorns", " of whispers", " of the moon", " of storms",
+    " of bones", " of the lost", " of embers", " of frost", " of the tomb", " of echoes", " of dusk",
+    " of the serpent", " of mercy", " of ruin", " of tides", " of the crypt"};
+
+// One random slip of the keyboard.
+std::string misspell(std::string name, std::mt19937_64 &rng)
+{
+    std::size_t at = rng() % name.size();
+    switch (rng() % 5)
+    {
+    case 0: // Swap two neighbors
+        if (at + 1 < name.size())
+            std::swap(name[at], name[at + 1]);
+        break;
+    case 1: // Drop a letter
+        name.erase(at, 1);
+        break;
+    case 2: // Double a letter
+        name.insert(at, 1, name[at]);
+        break;
+    case 3: // Wrong letter
+        name[at] = static_cast<char>('a' + rng() % 26);
+        break;
+    default: // Plural
+        name += 's';
+        break;
+    }
+    return name;
+}
+} // namespace
+
+int main(int argc, char *argv[])
+{
+    std::size_t kinds = argc > 1 ? std::stoul(argv[1]) : 5000;
+    std::size_t queries = argc > 2 ? std::stoul(argv[2]) : 100000;
+    std::uint64_t seed = argc > 3 ? std::stoull(argv[3]) : 42;
+
+    EntityStore entities;
+    ItemRegistry items(entities);
+    std::mt19937_64 rng(seed);
+    std::vector<std::string> names;
+    kinds = std::min<std::size_t>(kinds, 30 * 30 * 20);
+    for (std::size_t i = 0; i < kinds; ++i)
+    {
+        std::string name = std::string(kAdjectives[i % 30]) + " " + kNouns[(i / 30) % 30] + kOrigins[i / 900];
+        items.define(name, "A generated item.");
+        names.push_back(name);
+    }
+
+    ItemContainer floor(items);
+    ItemContainer inventory(items);
+    for (std::size_t i = 0; i < kinds; ++i)
+    {
+        floor.add(static_cast<ItemId>(i));
+        if (i % 2 == 0)
+        {
+            inventory.add(static_cast<ItemId>(i));
+        }
+    }
+
+    // Even queries look on the floor, odd ones in the inventory (even ids only).
+    std::vector<std::pair<std::string, ItemId>> typos;
+    for (std::size_t q = 0; q < queries; ++q)
+    {
+        ItemId target = static_cast<ItemId>(rng() % kinds);
+        if (q % 2 == 1)
+        {
+            target &= ~1u;
+        }
+        typos.emplace_back(misspell(names[target], rng), target);
+    }
+
+    std::size_t exact = 0;
+    std::size_t ambiguous = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (std::size_t q = 0; q < typos.size(); ++q)
+    {
+        const ItemContainer &scope = q % 2 == 0 ? floor : inventory;
+        std::vector<ItemId> found = scope.closestMatches(typos[q].first);
+        exact += found.size() == 1 && found[0] == typos[q].second;
+        ambiguous += found.size() > 1;
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    std::cout << "item kinds=" << kinds << " queries=" << queries << " seed=" << seed << "\n";
+    std::cout << "lookup: " << (seconds * 1e6 / static_cast<double>(queries ? queries : 1)) << " us/query, "
+              << exact << " resolved to the intended item, " << ambiguous << " ambiguous\n";
+    return 0;
+}
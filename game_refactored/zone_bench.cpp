@@ -0,0 +1,170 @@
+// Event fan-out benchmark for ZoneMap.
+//
+// Usage: zone_bench [rooms] [players] [moves] [zone size] [seed]
+//
+// Scatters `players` listeners over a grid world, then repeatedly moves a
+// random player through a random exit, publishing a Left and an Arrived event
+// for every move (what GameSession does). The same moves are timed twice:
+// routed through the zone map, and broadcast naively by checking every player
+// against the event's neighborhood. Both must deliver the same number of
+// events; the naive run is shortened for large player counts and reported
+// per event.
+
+#include "World.h"
+#include "WorldGen.h"
+#include "Zones.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <iterator>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace
+{
+// Counts what it receives, so the delivery totals can be compared.
+class CountingListener : public EventListener
+{
+public:
+    std::uint64_t received = 0;
+    void onEvent(const WorldEvent &) override { ++received; }
+};
+
+struct Move
+{
+    std::size_t player;
+    RoomId from;
+    RoomId to;
+};
+
+// Pre-generate a random walk so both runs see exactly the same moves.
+std::vector<Move> planMoves(const World &world, std::vector<RoomId> rooms, std::size_t count, std::uint64_t seed)
+{
+    std::mt19937_64 rng(seed);
+    std::vector<Move> moves;
+    moves.reserve(count);
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        std::size_t player = rng() % rooms.size();
+        const Room &room = world.room(rooms[player]);
+        auto exit = std::next(room.getExits().begin(), static_cast<std::ptrdiff_t>(rng() % room.getExits().size()));
+        moves.push_back({player, rooms[player], exit->second->getId()});
+        rooms[player] = moves.back().to;
+    }
+    return moves;
+}
+
+double secondsSince(std::chrono::steady_clock::time_point start)
+{
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+} // namespace
+
+int main(int argc, char *argv[])
+{
+    std::size_t roomCount = argc > 1 ? std::stoul(argv[1]) : 100000;
+    std::size_t players = argc > 2 ? std::stoul(argv[2]) : 10000;
+    std::size_t moveCount = argc > 3 ? std::stoul(argv[3]) : 1000000;
+    std::size_t zoneSize = argc > 4 ? std::stoul(argv[4]) : 64;
+    std::uint64_t seed = argc > 5 ? std::stoull(argv[5]) : 42;
+    if (roomCount < 2 || players == 0)
+    {
+        std::cerr << "Need at least 2 rooms and 1 player." << std::endl;
+        return 1;
+    }
+
+    std::cout << "rooms=" << roomCount << " players=" << players << " moves=" << moveCount
+              << " zone size=" << zoneSize << " seed=" << seed << "\n";
+
+    World world;
+    buildGridWorld(world, roomCount, seed);
+    ZoneMap zones(world, zoneSize);
+
+    std::mt19937_64 rng(seed);
+    std::vector<RoomId> startRooms(players);
+    for (RoomId &room : startRooms)
+    {
+        room = static_cast<RoomId>(rng() % roomCount);
+    }
+    std::vector<Move> moves = planMoves(world, startRooms, moveCount, seed + 1);
+
+    // --- Zoned fan-out ---
+    std::vector<CountingListener> listeners(players);
+    std::vector<ZoneMap::SubscriberId> ids(players);
+    for (std::size_t p = 0; p < players; ++p)
+    {
+        ids[p] = zones.subscribe(listeners[p], startRooms[p]);
+    }
+
+    std::uint64_t zonedDeliveries = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (const Move &move : moves)
+    {
+        EntityId actor = static_cast<EntityId>(move.player);
+        zonedDeliveries += zones.publish(WorldEvent{WorldEvent::Kind::Left, move.from, actor});
+        zones.moveSubscriber(ids[move.player], move.to);
+        zonedDeliveries += zones.publish(WorldEvent{WorldEvent::Kind::Arrived, move.to, actor});
+    }
+    double zonedSeconds = secondsSince(start);
+    double events = 2.0 * static_cast<double>(moves.size());
+    std::cout << "zoned: " << zones.zoneCount() << " zones, " << zonedDeliveries << " deliveries in "
+              << zonedSeconds << " s = " << (zonedSeconds * 1e9 / events) << " ns/event\n";
+
+    // --- Naive broadcast: every event checks every player ---
+    // Cost grows with players, so cap the work at ~2e9 player checks.
+    std::size_t naiveMoves = std::min<std::size_t>(moves.size(), std::max<std::size_t>(1, 1000000000 / players));
+    std::vector<RoomId> rooms = startRooms;
+    std::vector<RoomId> hearing;
+    std::uint64_t naiveDeliveries = 0;
+    std::uint64_t zonedSubset = 0; // Zoned deliveries for the same prefix, recomputed for the check
+    auto broadcast = [&](RoomId where)
+    {
+        hearing.assign(1, where);
+        for (const auto &exit : world.room(where).getExits())
+        {
+            hearing.push_back(exit.second->getId());
+        }
+        for (std::size_t p = 0; p < players; ++p)
+        {
+            if (std::find(hearing.begin(), hearing.end(), rooms[p]) != hearing.end())
+            {
+                ++listeners[p].received;
+                ++naiveDeliveries;
+            }
+        }
+    };
+    start = std::chrono::steady_clock::now();
+    for (std::size_t i = 0; i < naiveMoves; ++i)
+    {
+        broadcast(moves[i].from);
+        rooms[moves[i].player] = moves[i].to;
+        broadcast(moves[i].to);
+    }
+    double naiveSeconds = secondsSince(start);
+    double naiveEvents = 2.0 * static_cast<double>(naiveMoves);
+    std::cout << "naive: " << naiveDeliveries << " deliveries over " << naiveMoves << " moves in "
+              << naiveSeconds << " s = " << (naiveSeconds * 1e9 / naiveEvents) << " ns/event\n";
+
+    // Cross-check: replay the same prefix through a fresh zone map.
+    ZoneMap check(world, zoneSize);
+    for (std::size_t p = 0; p < players; ++p)
+    {
+        ids[p] = check.subscribe(listeners[p], startRooms[p]);
+    }
+    for (std::size_t i = 0; i < naiveMoves; ++i)
+    {
+        EntityId actor = static_cast<EntityId>(moves[i].player);
+        zonedSubset += check.publish(WorldEvent{WorldEvent::Kind::Left, moves[i].from, actor});
+        check.moveSubscriber(ids[moves[i].player], moves[i].to);
+        zonedSubset += check.publish(WorldEvent{WorldEvent::Kind::Arrived, moves[i].to, actor});
+    }
+    if (zonedSubset != naiveDeliveries)
+    {
+        std::cerr << "Mismatch: zoned delivered " << zonedSubset << ", naive " << naiveDeliveries << std::endl;
+        return 1;
+    }
+    std::cout << "speedup: " << (naiveSeconds / naiveEvents) / (zonedSeconds / events) << "x per event\n";
+    return 0;
+}
@@ -1,7 +1,15 @@
 #include <vector>
 #include <cstdint>  // For uint8_t
+#include <cstring>  // For std::memchr
 #include <numeric>  // For std::accumulate (optional, but useful)
 #include <iostream> // For main function testing output
+#include <chrono>   // For timing the batch validator
+#include <span>     // For std::span (C++20): a non-owning view, no copies
+
+#include "../../c_basics/checksum.h" // Vectorized additive checksum
+
+// Build (the checksum kernels are C, shared with c_basics):
+//   gcc -O2 -c ../../c_basics/checksum.c && g++ -std=c++20 -O2 packet_validator.cpp checksum.o -o packet_validator
 
 /**
  * @brief Validates a simple data packet buffer.
@@ -27,28 +35,125 @@
 
 // Rule 4: Checksum calculation and validation
 
-bool validate(const std::vector<uint8_t> &packet)
+bool validate(std::span<const uint8_t> packet)
 {
     if (packet.size() < 4)
         return false;
-    if (packet.at(0) != 0xAA)
+    if (packet[0] != 0xAA)
         return false;
 
-    int payloadSize = packet.size() - 4;
-    if (payloadSize != packet.at(2))
+    size_t payloadSize = packet.size() - 4;
+    if (payloadSize != packet[2])
         return false;
 
-    uint8_t checksum = 0;
-    for (size_t i = 0; i < packet.size() - 1; ++i)
-    {
-        checksum += packet[i];
-    }
+    // Sum of everything but the checksum byte, modulo 256 (SSE2/AVX2 when available)
+    uint8_t checksum = checksum_sum8(packet.data(), packet.size() - 1);
     if (checksum != packet.back())
         return false;
 
     return true;
 }
 
+// The original interface; a vector converts to a span without copying.
+bool validate(const std::vector<uint8_t> &packet)
+{
+    return validate(std::span<const uint8_t>(packet));
+}
+
+// --- Batch Validation ---
+
+/**
+ * @brief Result of validating a whole capture buffer.
+ *
+ * Packet i starts at offsets[i]; bit i of validBits says whether it passed. One
+ * bit per packet keeps the result small enough to stay in cache for millions of
+ * packets. Reuse one BatchResult across captures: clear() keeps its memory.
+ */
+struct BatchResult
+{
+    std::vector<uint32_t> offsets;   // Start of each packet in the capture (within the first 4 GiB)
+    std::vector<uint64_t> validBits; // Bit i % 64 of word i / 64: packet i is valid
+    size_t validCount = 0;
+    size_t bytesSkipped = 0;  // Garbage between packets (searched past for the next 0xAA)
+    size_t bytesConsumed = 0; // Where scanning stopped; the bytes after it may be the start of a truncated packet
+
+    size_t packetCount() const { return offsets.size(); }
+    bool isValid(size_t i) const { return (validBits[i / 64] >> (i % 64)) & 1; }
+
+    // View of packet i inside the capture it was found in (no copy)
+    std::span<const uint8_t> packet(std::span<const uint8_t> capture, size_t i) const
+    {
+        return capture.subspan(offsets[i], capture[offsets[i] + 2] + 4u);
+    }
+
+    void clear()
+    {
+        offsets.clear();
+        validBits.clear();
+        validCount = 0;
+        bytesSkipped = 0;
+        bytesConsumed = 0;
+    }
+};
+
+/**
+ * @brief Splits a capture of back-to-back packets and validates every one of them.
+ *
+ * The payload size byte frames each packet, so a packet with a bad checksum is
+ * still stepped over as a whole. Bytes that do not start with 0xAA are skipped
+ * (resynchronizing with memchr). A packet cut off by the end of the capture is
+ * not counted; resume from result.bytesConsumed when more data arrives.
+ * Offsets are 32-bit, so scanning stops before the first packet that would start
+ * past 4 GiB: validate a larger capture in pieces, each starting at the previous
+ * piece's bytesConsumed.
+ *
+ * @param capture The captured bytes.
+ * @param result Filled with one offset and one validity bit per packet (cleared first).
+ */
+void validateBatch(std::span<const uint8_t> capture, BatchResult &result)
+{
+    // No up-front reserve: the upper bound (one packet per 4 bytes) would cost as
+    // much memory as the capture. The vectors grow geometrically, and a reused
+    // BatchResult keeps its capacity from the last capture.
+    result.clear();
+
+    const uint8_t *data = capture.data();
+    size_t size = capture.size();
+    const size_t maxOffset = UINT32_MAX; // Last start an offset can hold
+    size_t offset = 0;
+    uint64_t bits = 0; // Validity bits of the current 64 packets
+    while (offset + 4 <= size && offset <= maxOffset)
+    {
+        if (data[offset] != 0xAA)
+        {
+            const void *start = std::memchr(data + offset, 0xAA, size - offset);
+            size_t next = start ? static_cast<size_t>(static_cast<const uint8_t *>(start) - data) : size;
+            result.bytesSkipped += next - offset;
+            offset = next;
+            continue;
+        }
+
+        size_t packetSize = data[offset + 2] + 4u;
+        if (offset + packetSize > size)
+            break; // Truncated: wait for the rest
+
+        bool valid = checksum_sum8(data + offset, packetSize - 1) == data[offset + packetSize - 1];
+        size_t index = result.offsets.size();
+        result.offsets.push_back(static_cast<uint32_t>(offset));
+        bits |= static_cast<uint64_t>(valid) << (index % 64);
+        result.validCount += valid;
+        if (index % 64 == 63)
+        {
+            result.validBits.push_back(bits);
+            bits = 0;
+        }
+        offset += packetSize;
+    }
+    if (result.offsets.size() % 64 != 0)
+        result.validBits.push_back(bits);
+    result.bytesConsumed = offset;
+}
+
 void testPacket(const std::vector<uint8_t> &packet, bool expected)
 {
     std::cout << "Expected: " << expected << std::endl;
@@ -72,5 +177,49 @@ int main()
     testPacket({0xAA, 0x01, 0x01, 0x10, 0xBC}, false);       // FAILED: Wrong checksum (0xAA+1+1+0x10 = 0xBC, checksum is BC)
     testPacket({0xAA, 0x01, 0x02, 0x10, 0x20, 0xDD}, false); // FAILED: Wrong checksum (sum = 0xDB, checksum = 0xDD)
 
+    // --- Batch validation over one capture buffer ---
+    std::cout << "\nBatch validation" << std::endl;
+    const size_t packetCount = 2000000;
+    std::vector<uint8_t> capture;
+    capture.reserve(packetCount * 12);
+    uint32_t seed = 1;
+    for (size_t i = 0; i < packetCount; ++i)
+    {
+        seed = seed * 1103515245u + 12345u;
+        uint8_t payloadSize = (seed >> 16) % 17; // 0..16 bytes, like the command protocol
+        size_t start = capture.size();
+        capture.push_back(0xAA);
+        capture.push_back(static_cast<uint8_t>(seed >> 8));
+        capture.push_back(payloadSize);
+        for (uint8_t b = 0; b < payloadSize; ++b)
+            capture.push_back(static_cast<uint8_t>(seed >> (b % 24)));
+        uint8_t checksum = 0;
+        for (size_t b = start; b < capture.size(); ++b)
+            checksum += capture[b];
+        capture.push_back(i % 100 == 0 ? checksum ^ 0x01 : checksum); // Every 100th packet is corrupt
+    }
+
+    BatchResult result;
+    auto begin = std::chrono::steady_clock::now();
+    validateBatch(capture, result);
+    double batchSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+
+    // The old way: one heap vector per packet
+    size_t perPacketValid = 0;
+    begin = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < result.packetCount(); ++i)
+    {
+        std::span<const uint8_t> view = result.packet(capture, i);
+        std::vector<uint8_t> copy(view.begin(), view.end());
+        perPacketValid += validate(copy);
+    }
+    double vectorSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+
+    std::cout << "Packets: " << result.packetCount() << ", valid: " << result.validCount
+              << " (expected " << packetCount - packetCount / 100 << "), packet 100 valid: " << result.isValid(100) << std::endl;
+    std::cout << "validateBatch: " << result.packetCount() / batchSeconds / 1e6 << " M packets/s" << std::endl;
+    std::cout << "vector per packet: " << result.packetCount() / vectorSeconds / 1e6 << " M packets/s (valid: "
+              << perPacketValid << ")" << std::endl;
+
     return 0;
 }